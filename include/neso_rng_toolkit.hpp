@@ -1,10 +1,20 @@
 #ifndef _NESO_RNG_TOOLKIT_HPP_
 #define _NESO_RNG_TOOLKIT_HPP_
 
+#include "neso_rng_toolkit/alias.hpp"
 #include "neso_rng_toolkit/create_rng.hpp"
 #include "neso_rng_toolkit/distribution.hpp"
+#include "neso_rng_toolkit/engine.hpp"
+#include "neso_rng_toolkit/keyed.hpp"
+#include "neso_rng_toolkit/multivariate.hpp"
+#include "neso_rng_toolkit/reduced_precision.hpp"
 #include "neso_rng_toolkit/rng.hpp"
+#include "neso_rng_toolkit/sobol.hpp"
+#include "neso_rng_toolkit/stream_family.hpp"
+#include "neso_rng_toolkit/tabulated.hpp"
+#include "neso_rng_toolkit/transform.hpp"
 #include "neso_rng_toolkit/typedefs.hpp"
+#include "neso_rng_toolkit/variance_reduction.hpp"
 
 namespace NESO::RNGToolkit {
 /**
@@ -0,0 +1,352 @@
+#ifndef _NESO_RNG_TOOLKIT_ALIAS_HPP_
+#define _NESO_RNG_TOOLKIT_ALIAS_HPP_
+
+#include "distribution.hpp"
+#include "scan.hpp"
+#include "typedefs.hpp"
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace NESO::RNGToolkit {
+
+/**
+ * Device alias table (Walker, Vose) for sampling from a discrete distribution
+ * with many weighted categories in constant time per sample. The table is
+ * built on the device from a device array of weights, hence it can be
+ * rebuilt every step without copying the weights to the host. The device
+ * allocations are reused by subsequent builds with at most as many
+ * categories. Sample the table with an Engine, e.g.
+ *
+ *    engine->get_samples(table.get_distribution<int>(), d_ptr, num_samples);
+ */
+template <typename VALUE_TYPE> struct AliasTable {
+  /// Queue on which the table is built.
+  sycl::queue queue;
+  /// Number of categories of the last successful build.
+  std::size_t num_categories{0};
+
+  ~AliasTable() { this->free_allocations(); }
+
+  /**
+   * Create an empty alias table.
+   *
+   * @param queue SYCL queue on which the table is allocated and built.
+   */
+  AliasTable(sycl::queue queue) : queue(queue) {}
+
+  AliasTable(const AliasTable &) = delete;
+  AliasTable &operator=(const AliasTable &) = delete;
+
+  /**
+   * Build the table from a device array of non-negative weights. The table
+   * is built in parallel with the sweeping method of Hübschle-Schneider and
+   * Sanders, "Parallel Weighted Random Sampling" (2019). The weights are
+   * summed and normalised, the categories are partitioned into light and
+   * heavy categories with a prefix sum and the prefix sums of the weights of
+   * each partition determine where independent parts of the sequential
+   * sweep, which pairs light categories with heavy categories, start. Only
+   * the total weight is copied to the host.
+   *
+   * @param d_weights Device pointer to num_categories weights. At least one
+   * weight must be positive.
+   * @param num_categories Number of categories, at most 2^32 - 1.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int build(const VALUE_TYPE *d_weights, const std::size_t num_categories) {
+    if ((num_categories == 0) ||
+        (num_categories > std::numeric_limits<std::uint32_t>::max())) {
+      std::cout << "Cannot build an alias table with " +
+                       std::to_string(num_categories) + " categories."
+                << std::endl;
+      return -1;
+    }
+    if (num_categories > this->capacity) {
+      int err = SUCCESS;
+      if ((err = this->allocate(num_categories)) != SUCCESS) {
+        return err;
+      }
+    }
+
+    const std::size_t n = num_categories;
+    VALUE_TYPE *k_scaled = this->d_scaled;
+    VALUE_TYPE *k_prefix = this->d_prefix;
+    std::uint32_t *k_threshold = this->d_threshold;
+    std::uint32_t *k_alias = this->d_alias;
+    std::uint32_t *k_stack = this->d_stack;
+    std::uint32_t *k_positions = this->d_positions;
+    std::uint32_t *k_splits = this->d_splits;
+
+    // Sum the weights in chunks and scan the chunk sums, with one additional
+    // zero value, such that the total follows the chunk offsets.
+    const std::size_t num_chunks = get_num_chunks(n);
+    VALUE_TYPE *k_chunks = k_prefix;
+    auto event = this->queue.parallel_for(
+        sycl::range<1>(num_chunks + 1), [=](auto idx) {
+          const std::size_t cx = idx;
+          const std::size_t start = std::min(cx * chunk_size, n);
+          const std::size_t end = std::min(start + chunk_size, n);
+          VALUE_TYPE sum = 0.0;
+          bool valid = true;
+          for (std::size_t ix = start; ix < end; ix++) {
+            const VALUE_TYPE w = d_weights[ix];
+            valid = valid && (w >= VALUE_TYPE(0.0));
+            sum += w;
+          }
+          // A negative or NaN weight invalidates the total.
+          k_chunks[cx] =
+              valid ? sum : std::numeric_limits<VALUE_TYPE>::quiet_NaN();
+        });
+    Private::submit_exclusive_scan(this->queue, k_chunks, num_chunks + 1,
+                                   k_chunks + num_chunks + 1, event)
+        .wait_and_throw();
+    VALUE_TYPE total = 0.0;
+    this->queue.memcpy(&total, k_chunks + num_chunks, sizeof(VALUE_TYPE))
+        .wait_and_throw();
+    if (!((total > VALUE_TYPE(0.0)) &&
+          (total <= std::numeric_limits<VALUE_TYPE>::max()))) {
+      std::cout << "Alias table weights must be non-negative and finite with "
+                   "a positive sum."
+                << std::endl;
+      return -3;
+    }
+
+    // Scale the weights such that the mean weight is one and flag the light
+    // categories.
+    const VALUE_TYPE scaling = static_cast<VALUE_TYPE>(n) / total;
+    event = this->queue.parallel_for(sycl::range<1>(n + 1), [=](auto idx) {
+      const std::size_t ix = idx;
+      if (ix < n) {
+        const VALUE_TYPE w = d_weights[ix] * scaling;
+        k_scaled[ix] = w;
+        k_alias[ix] = static_cast<std::uint32_t>(ix);
+        k_threshold[ix] = 0;
+        k_positions[ix] = (w < VALUE_TYPE(1.0)) ? 1 : 0;
+      } else {
+        k_positions[n] = 0;
+      }
+    });
+
+    // Partition the categories, in order, into the light categories followed
+    // by the heavy categories and scan the weights in the partitioned order.
+    event = Private::submit_exclusive_scan(this->queue, k_positions, n + 1,
+                                           k_positions + n + 1, event);
+    event = this->queue.parallel_for(
+        sycl::range<1>(n + 1), event, [=](auto idx) {
+          const std::size_t ix = idx;
+          const std::size_t num_light = k_positions[n];
+          if (ix < n) {
+            const std::size_t position =
+                (k_scaled[ix] < VALUE_TYPE(1.0))
+                    ? k_positions[ix]
+                    : num_light + (ix - k_positions[ix]);
+            k_stack[position] = static_cast<std::uint32_t>(ix);
+            k_prefix[position] = k_scaled[ix];
+          } else {
+            k_prefix[n] = 0.0;
+          }
+        });
+    event = Private::submit_exclusive_scan(this->queue, k_prefix, n + 1,
+                                           k_prefix + n + 1, event);
+
+    // The sweep fills the buckets in order. The first m buckets are the
+    // first i light categories and first m - i heavy categories where i is
+    // the smallest index for which the weight of these categories is at
+    // most m, the remainder of the m buckets is filled by heavy category
+    // m - i.
+    const std::size_t num_parts = get_num_parts(n);
+    event = this->queue.parallel_for(
+        sycl::range<1>(num_parts + 1), event, [=](auto idx) {
+          const std::size_t px = idx;
+          const std::size_t num_light = k_positions[n];
+          const std::size_t num_heavy = n - num_light;
+          const std::size_t m = std::min(px * part_size, n);
+          std::size_t lower = (m > num_heavy) ? m - num_heavy : 0;
+          std::size_t upper = std::min(m, num_light);
+          while (lower < upper) {
+            const std::size_t i = (lower + upper) / 2;
+            const VALUE_TYPE weight = k_prefix[i] +
+                                      k_prefix[num_light + m - i] -
+                                      k_prefix[num_light];
+            if (weight <= static_cast<VALUE_TYPE>(m)) {
+              upper = i;
+            } else {
+              lower = i + 1;
+            }
+          }
+          k_splits[px] = static_cast<std::uint32_t>(lower);
+        });
+
+    // Each part of the sweep pairs each light category with the current
+    // heavy category. A heavy category which has given away enough weight
+    // to become light is paired with the next heavy category.
+    this->queue
+        .parallel_for(
+            sycl::range<1>(num_parts), event,
+            [=](auto idx) {
+              const std::size_t px = idx;
+              const std::size_t num_light = k_positions[n];
+              const std::size_t num_heavy = n - num_light;
+              const std::uint32_t *light = k_stack;
+              const std::uint32_t *heavy = k_stack + num_light;
+              const std::size_t m = px * part_size;
+              const std::size_t m_end = std::min(m + part_size, n);
+              std::size_t i = k_splits[px];
+              std::size_t j = m - i;
+              const std::size_t i_end = k_splits[px + 1];
+              const std::size_t j_end = m_end - i_end;
+
+              // The weight of the current heavy category less the weight
+              // given to the buckets of the previous parts.
+              VALUE_TYPE residual = 0.0;
+              if (j < num_heavy) {
+                const VALUE_TYPE taken =
+                    static_cast<VALUE_TYPE>(m) - k_prefix[i] -
+                    (k_prefix[num_light + j] - k_prefix[num_light]);
+                residual = k_scaled[heavy[j]] - taken;
+              }
+              while ((i < i_end) || (j < j_end)) {
+                if ((j < j_end) &&
+                    ((residual < VALUE_TYPE(1.0)) || (i == i_end))) {
+                  const std::uint32_t h = heavy[j++];
+                  if (j < num_heavy) {
+                    k_threshold[h] =
+                        get_threshold(std::max(residual, VALUE_TYPE(0.0)));
+                    k_alias[h] = heavy[j];
+                    residual =
+                        k_scaled[heavy[j]] - (VALUE_TYPE(1.0) - residual);
+                  }
+                } else {
+                  const std::uint32_t l = light[i++];
+                  if (j < num_heavy) {
+                    k_threshold[l] = get_threshold(k_scaled[l]);
+                    k_alias[l] = heavy[j];
+                    residual -= VALUE_TYPE(1.0) - k_scaled[l];
+                  }
+                }
+              }
+              // Categories without a heavy category to pair with fill their
+              // own buckets up to rounding.
+            })
+        .wait_and_throw();
+
+    this->num_categories = n;
+    return SUCCESS;
+  }
+
+  /**
+   * @returns The distribution which samples the last table which was built.
+   */
+  template <typename INT_TYPE>
+  Distribution::Alias<INT_TYPE> get_distribution() const {
+    return Distribution::Alias<INT_TYPE>{this->d_threshold, this->d_alias,
+                                         this->num_categories};
+  }
+
+protected:
+  /// Number of weights summed by each work item.
+  static constexpr std::size_t chunk_size = 1024;
+  /// Number of buckets each work item of the sweep fills.
+  static constexpr std::size_t part_size = 1024;
+
+  std::size_t capacity{0};
+  std::uint32_t *d_threshold{nullptr};
+  std::uint32_t *d_alias{nullptr};
+  /// The light categories followed by the heavy categories.
+  std::uint32_t *d_stack{nullptr};
+  /// Partition positions, followed by the workspace of their scan.
+  std::uint32_t *d_positions{nullptr};
+  /// Number of light categories before each part of the sweep.
+  std::uint32_t *d_splits{nullptr};
+  VALUE_TYPE *d_scaled{nullptr};
+  /// Prefix sums of the weights, followed by the workspace of their scan.
+  VALUE_TYPE *d_prefix{nullptr};
+
+  /**
+   * @returns The number of chunks num_categories weights are summed in.
+   */
+  static inline std::size_t get_num_chunks(const std::size_t num_categories) {
+    return (num_categories + chunk_size - 1) / chunk_size;
+  }
+
+  /**
+   * @returns The number of parts the sweep over num_categories is split into.
+   */
+  static inline std::size_t get_num_parts(const std::size_t num_categories) {
+    return (num_categories + part_size - 1) / part_size;
+  }
+
+  /**
+   * Convert the probability of keeping the category of a bucket to a 32-bit
+   * threshold. Callable from device code.
+   *
+   * @param probability Probability in [0, 1).
+   * @returns Threshold which a uniform 32-bit value is below with the
+   * probability.
+   */
+  static inline std::uint32_t get_threshold(const VALUE_TYPE probability) {
+    const VALUE_TYPE value = probability * VALUE_TYPE(4294967296.0);
+    return (value >= VALUE_TYPE(4294967295.0))
+               ? std::numeric_limits<std::uint32_t>::max()
+               : static_cast<std::uint32_t>(value);
+  }
+
+  /**
+   * Replace the device allocations with allocations for a number of
+   * categories.
+   *
+   * @param num_categories Number of categories.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int allocate(const std::size_t num_categories) {
+    this->free_allocations();
+    const std::size_t n = num_categories;
+    const std::size_t num_scanned =
+        n + 1 + Private::get_scan_workspace_size(n + 1);
+    this->capacity = 0;
+    this->num_categories = 0;
+    this->d_threshold = sycl::malloc_device<std::uint32_t>(n, this->queue);
+    this->d_alias = sycl::malloc_device<std::uint32_t>(n, this->queue);
+    this->d_stack = sycl::malloc_device<std::uint32_t>(n, this->queue);
+    this->d_positions =
+        sycl::malloc_device<std::uint32_t>(num_scanned, this->queue);
+    this->d_splits =
+        sycl::malloc_device<std::uint32_t>(get_num_parts(n) + 1, this->queue);
+    this->d_scaled = sycl::malloc_device<VALUE_TYPE>(n, this->queue);
+    this->d_prefix = sycl::malloc_device<VALUE_TYPE>(num_scanned, this->queue);
+    if ((this->d_threshold == nullptr) || (this->d_alias == nullptr) ||
+        (this->d_stack == nullptr) || (this->d_positions == nullptr) ||
+        (this->d_splits == nullptr) || (this->d_scaled == nullptr) ||
+        (this->d_prefix == nullptr)) {
+      std::cout << "Failed to allocate an alias table with " +
+                       std::to_string(n) + " categories."
+                << std::endl;
+      return -2;
+    }
+    this->capacity = n;
+    return SUCCESS;
+  }
+
+  /**
+   * Free the device allocations.
+   */
+  inline void free_allocations() {
+    auto free_allocation = [&](auto *&d_ptr) {
+      if (d_ptr != nullptr) {
+        sycl::free(d_ptr, this->queue);
+        d_ptr = nullptr;
+      }
+    };
+    free_allocation(this->d_threshold);
+    free_allocation(this->d_alias);
+    free_allocation(this->d_stack);
+    free_allocation(this->d_positions);
+    free_allocation(this->d_splits);
+    free_allocation(this->d_scaled);
+    free_allocation(this->d_prefix);
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
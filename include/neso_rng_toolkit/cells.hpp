@@ -0,0 +1,202 @@
+#ifndef _NESO_RNG_TOOLKIT_CELLS_HPP_
+#define _NESO_RNG_TOOLKIT_CELLS_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * @param shape Shape of the cells.
+ * @returns The number of points which describe a cell.
+ */
+inline std::size_t get_num_cell_points(const Distribution::CellShape shape) {
+  switch (shape) {
+  case Distribution::CellShape::Box:
+    return 2;
+  case Distribution::CellShape::Triangle:
+    return 3;
+  default:
+    return 4;
+  }
+}
+
+/**
+ * @param shape Shape of the cells.
+ * @param ndim Dimension of the points.
+ * @returns True if cells of the shape can be described with points of
+ * dimension ndim.
+ */
+inline bool is_valid_cell_dimension(const Distribution::CellShape shape,
+                                    const std::size_t ndim) {
+  switch (shape) {
+  case Distribution::CellShape::Box:
+    return (1 <= ndim) && (ndim <= 3);
+  case Distribution::CellShape::Tetrahedron:
+    return ndim == 3;
+  default:
+    return (2 <= ndim) && (ndim <= 3);
+  }
+}
+
+/**
+ * Compute twice the area of a triangle. Callable from device code.
+ *
+ * @param ndim Dimension of the vertices, 2 or 3.
+ * @param a First vertex.
+ * @param b Second vertex.
+ * @param c Third vertex.
+ * @returns Twice the area of the triangle.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE get_triangle_area_2(const std::size_t ndim,
+                                     const REAL_TYPE *a, const REAL_TYPE *b,
+                                     const REAL_TYPE *c) {
+  REAL_TYPE e_0[3] = {0, 0, 0};
+  REAL_TYPE e_1[3] = {0, 0, 0};
+  for (std::size_t dx = 0; dx < ndim; dx++) {
+    e_0[dx] = b[dx] - a[dx];
+    e_1[dx] = c[dx] - a[dx];
+  }
+  const REAL_TYPE n_0 = e_0[1] * e_1[2] - e_0[2] * e_1[1];
+  const REAL_TYPE n_1 = e_0[2] * e_1[0] - e_0[0] * e_1[2];
+  const REAL_TYPE n_2 = e_0[0] * e_1[1] - e_0[1] * e_1[0];
+  return sycl::sqrt(n_0 * n_0 + n_1 * n_1 + n_2 * n_2);
+}
+
+/**
+ * Sample a position uniformly in a cell without rejection. Callable from
+ * device code.
+ *
+ * Boxes use one uniform sample per component. Triangles use the barycentric
+ * weights (1 - sqrt(u_0), sqrt(u_0) (1 - u_1), sqrt(u_0) u_1). Quadrilaterals
+ * are split along the diagonal from the first vertex into two triangles and
+ * a triangle is selected with probability proportional to its area.
+ * Tetrahedra use barycentric weights E_v / sum(E) where the E_v are
+ * independent standard Exponential samples, i.e. uniform on the simplex.
+ *
+ * @param[in] shape Shape of the cell.
+ * @param[in] ndim Dimension of the position.
+ * @param[in] points Points which describe the cell.
+ * @param[in, out] stream Source of random bits.
+ * @param[out] position Components of the position.
+ */
+template <typename REAL_TYPE>
+inline void sample_cell_position(const Distribution::CellShape shape,
+                                 const std::size_t ndim,
+                                 const REAL_TYPE *points, PhiloxStream &stream,
+                                 REAL_TYPE position[3]) {
+  using R = REAL_TYPE;
+  if (shape == Distribution::CellShape::Box) {
+    for (std::size_t dx = 0; dx < ndim; dx++) {
+      position[dx] = points[dx] + (points[ndim + dx] - points[dx]) *
+                                      stream.next_uniform<R>();
+    }
+    return;
+  }
+
+  // Barycentric weights for the vertices of the cell.
+  R weights[4] = {R(0.0), R(0.0), R(0.0), R(0.0)};
+  if (shape == Distribution::CellShape::Tetrahedron) {
+    R total = R(0.0);
+    for (int vx = 0; vx < 4; vx++) {
+      weights[vx] = -sycl::log(stream.next_uniform<R>());
+      total += weights[vx];
+    }
+    for (int vx = 0; vx < 4; vx++) {
+      weights[vx] /= total;
+    }
+  } else {
+    // The vertices of the triangle to sample, for a quadrilateral these are
+    // either vertices (0, 1, 2) or (0, 2, 3).
+    int v_1 = 1;
+    int v_2 = 2;
+    if (shape == Distribution::CellShape::Quadrilateral) {
+      const R area_0 = get_triangle_area_2(ndim, points, points + ndim,
+                                           points + 2 * ndim);
+      const R area_1 = get_triangle_area_2(ndim, points, points + 2 * ndim,
+                                           points + 3 * ndim);
+      const bool second =
+          stream.next_uniform<R>() * (area_0 + area_1) >= area_0;
+      v_1 = second ? 2 : 1;
+      v_2 = second ? 3 : 2;
+    }
+    const R r = sycl::sqrt(stream.next_uniform<R>());
+    const R u = stream.next_uniform<R>();
+    weights[0] = R(1.0) - r;
+    weights[v_1] = r * (R(1.0) - u);
+    weights[v_2] = r * u;
+  }
+
+  const int num_points = static_cast<int>(get_num_cell_points(shape));
+  for (std::size_t dx = 0; dx < ndim; dx++) {
+    R value = R(0.0);
+    for (int vx = 0; vx < num_points; vx++) {
+      value += weights[vx] * points[vx * ndim + dx];
+    }
+    position[dx] = value;
+  }
+}
+
+/**
+ * Submit a kernel which samples positions in mesh cells. Each position uses
+ * its own Philox stream.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Cells to sample positions in.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to write ndim * num_samples values to.
+ * @param d_cell_ids Device pointer to write the cell of each sample to or
+ * nullptr.
+ * @param num_samples Number of positions.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline sycl::event
+submit_cell_positions(sycl::queue &queue,
+                      const Distribution::CellPositions<REAL_TYPE> distribution,
+                      const REAL_TYPE *d_key, REAL_TYPE *d_ptr,
+                      INT_TYPE *d_cell_ids, const std::size_t num_samples,
+                      sycl::event event = sycl::event{},
+                      const Distribution::Strided layout =
+                          Distribution::Strided{}) {
+  const auto k_shape = distribution.shape;
+  const std::size_t k_ndim = distribution.ndim;
+  const bool k_soa = distribution.layout == Distribution::Layout::SoA;
+  const std::size_t k_num_cell_values =
+      get_num_cell_points(distribution.shape) * distribution.ndim;
+  const REAL_TYPE *k_cells = distribution.d_cells;
+  const std::size_t *k_offsets = distribution.d_offsets;
+  const std::size_t k_num_cells = distribution.num_cells;
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    const std::size_t cell =
+        Distribution::get_parameter_index(k_offsets, k_num_cells, ix);
+    REAL_TYPE position[3];
+    sample_cell_position(k_shape, k_ndim, k_cells + cell * k_num_cell_values,
+                         stream, position);
+    for (std::size_t dx = 0; dx < k_ndim; dx++) {
+      const std::size_t index =
+          k_soa ? dx * num_samples + ix : ix * k_ndim + dx;
+      d_ptr[Distribution::get_strided_index(layout, index)] = position[dx];
+    }
+    if (d_cell_ids != nullptr) {
+      d_cell_ids[ix] = static_cast<INT_TYPE>(cell);
+    }
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
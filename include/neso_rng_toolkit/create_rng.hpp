@@ -1,11 +1,18 @@
 #ifndef _NESO_RNG_TOOLKIT_CREATE_RNG_HPP_
 #define _NESO_RNG_TOOLKIT_CREATE_RNG_HPP_
 
+#include "engine.hpp"
 #include "platforms/curand.hpp"
 #include "platforms/hiprand.hpp"
 #include "platforms/onemkl.hpp"
 #include "platforms/stdlib.hpp"
+#include "reduced_precision.hpp"
 #include "rng.hpp"
+#include "sobol.hpp"
+#include "tabulated.hpp"
+#include "transform.hpp"
+#include "variance_reduction.hpp"
+#include <type_traits>
 
 namespace NESO::RNGToolkit {
 
@@ -26,25 +33,25 @@ std::string get_default_platform();
 std::uint64_t create_seeds(std::size_t size, std::size_t rank,
                            std::uint64_t seed);
 
+namespace Private {
+
 /**
- * This is the function users could call to create a RNG instance.
+ * Helper function to select a platform by name and create an RNG or Engine
+ * instance from that platform. The platform name may be overridden by the
+ * environment variable NESO_RNG_TOOLKIT_PLATFORM.
  *
- * @param distribution Distribution RNG samples should be from.
- * @param seed Value to seed RNG with.
+ * @param platform_name Name of preferred RNG platform.
  * @param device SYCL Device samples are to be created on.
  * @param device_index Index of SYCL device on the SYCL platform.
- * @param platform_name Name of preferred RNG platform, default="default".
- * @param generator_name Name of preferred RNG generator method,
- * default="default".
- * @returns RNG instance. nullptr on Error.
+ * @param func Callable which is passed an instance of the selected platform
+ * and returns an RNG or Engine instance.
+ * @returns RNG or Engine instance. nullptr on Error.
  */
-template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
-[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
-create_rng(DISTRIBUTION_TYPE distribution, std::uint64_t seed,
-           sycl::device device, std::size_t device_index,
-           std::string platform_name = "default",
-           std::string generator_name = "default") {
-  RNGSharedPtr<VALUE_TYPE> rng = nullptr;
+template <typename VALUE_TYPE, typename FUNC_TYPE>
+[[nodiscard]] std::invoke_result_t<FUNC_TYPE, StdLibPlatform<VALUE_TYPE>>
+create_on_platform(std::string platform_name, sycl::device device,
+                   std::size_t device_index, FUNC_TYPE func) {
+  std::invoke_result_t<FUNC_TYPE, StdLibPlatform<VALUE_TYPE>> rng = nullptr;
 
   if (platform_name == "default") {
     platform_name = get_default_platform();
@@ -52,36 +59,27 @@ create_rng(DISTRIBUTION_TYPE distribution, std::uint64_t seed,
   platform_name =
       Private::get_env_string("NESO_RNG_TOOLKIT_PLATFORM", platform_name);
 
-  generator_name =
-      Private::get_env_string("NESO_RNG_TOOLKIT_GENERATOR", generator_name);
-
   if (platform_name == "stdlib" && rng == nullptr) {
-    rng = StdLibPlatform<VALUE_TYPE>{}.create_rng(distribution, seed, device,
-                                                  device_index, generator_name);
+    rng = func(StdLibPlatform<VALUE_TYPE>{});
   }
 
   if (platform_name == "oneMKL" && rng == nullptr) {
-    rng = OneMKLPlatform<VALUE_TYPE>{}.create_rng(distribution, seed, device,
-                                                  device_index, generator_name);
+    rng = func(OneMKLPlatform<VALUE_TYPE>{});
   }
 
   if (platform_name == "curand" && rng == nullptr) {
     if (is_cuda_device(device, device_index)) {
-      rng = CurandPlatform<VALUE_TYPE>{}.create_rng(
-          distribution, seed, device, device_index, generator_name);
+      rng = func(CurandPlatform<VALUE_TYPE>{});
     } else {
-      rng = StdLibPlatform<VALUE_TYPE>{}.create_rng(
-          distribution, seed, device, device_index, generator_name);
+      rng = func(StdLibPlatform<VALUE_TYPE>{});
     }
   }
 
   if (platform_name == "hipRAND" && rng == nullptr) {
     if (is_hip_device(device, device_index)) {
-      rng = hipRANDPlatform<VALUE_TYPE>{}.create_rng(
-          distribution, seed, device, device_index, generator_name);
+      rng = func(hipRANDPlatform<VALUE_TYPE>{});
     } else {
-      rng = StdLibPlatform<VALUE_TYPE>{}.create_rng(
-          distribution, seed, device, device_index, generator_name);
+      rng = func(StdLibPlatform<VALUE_TYPE>{});
     }
   }
 
@@ -95,6 +93,443 @@ create_rng(DISTRIBUTION_TYPE distribution, std::uint64_t seed,
   return rng;
 }
 
+} // namespace Private
+
+/**
+ * This is the function users could call to create a RNG instance.
+ *
+ * @param distribution Distribution RNG samples should be from.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(DISTRIBUTION_TYPE distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  generator_name =
+      Private::get_env_string("NESO_RNG_TOOLKIT_GENERATOR", generator_name);
+
+  return Private::create_on_platform<VALUE_TYPE>(
+      platform_name, device, device_index, [&](auto platform) {
+        return platform.create_rng(distribution, seed, device, device_index,
+                                   generator_name);
+      });
+}
+
+/**
+ * Create an RNG instance which samples random 32 or 64-bit words. This is the
+ * cheapest output format of each platform.
+ *
+ * @param distribution Bits distribution for std::uint32_t or std::uint64_t.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::Bits<VALUE_TYPE> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  static_assert(std::is_same_v<VALUE_TYPE, std::uint32_t> ||
+                    std::is_same_v<VALUE_TYPE, std::uint64_t>,
+                "Bits are only sampled as 32 or 64-bit words.");
+  generator_name =
+      Private::get_env_string("NESO_RNG_TOOLKIT_GENERATOR", generator_name);
+
+  // The platforms are templated on a floating point type, every instantiation
+  // can create RNGs for bits hence the double precision platforms are used.
+  return Private::create_on_platform<double>(
+      platform_name, device, device_index, [&](auto platform) {
+        return platform.create_rng(distribution, seed, device, device_index,
+                                   generator_name);
+      });
+}
+
+namespace Private {
+
+/**
+ * Helper function to create an RNG which packs reduced precision samples into
+ * the words of an RNG for Bits.
+ *
+ * @param convert Map from fields of random bits to samples.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform.
+ * @param generator_name Name of preferred RNG generator method.
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_reduced_precision_rng(ReducedPrecisionUniform<VALUE_TYPE> convert,
+                             std::uint64_t seed, sycl::device device,
+                             std::size_t device_index,
+                             std::string platform_name,
+                             std::string generator_name) {
+  auto rng = create_rng<std::uint32_t>(Distribution::Bits<std::uint32_t>{},
+                                       seed, device, device_index,
+                                       platform_name, generator_name);
+  if (rng == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<ReducedPrecisionRNG<VALUE_TYPE>>(rng, device,
+                                                            device_index,
+                                                            convert);
+}
+
+} // namespace Private
+
+/**
+ * Create an RNG instance which samples uniform values of a reduced precision
+ * floating point type, sycl::half or sycl::ext::oneapi::bfloat16. Several
+ * samples are packed into each 32-bit word drawn from the platform, hence the
+ * platform writes two (half) or four (bfloat16) times fewer bytes than for
+ * float samples. The samples are computed in single precision and rounded to
+ * VALUE_TYPE, hence for intervals other than [0, 1) a sample may round to b.
+ *
+ * @param distribution Uniform distribution of sycl::half or bfloat16 values.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE,
+          std::enable_if_t<Private::is_reduced_precision_v<VALUE_TYPE>, int> =
+              0>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::Uniform<VALUE_TYPE> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  return Private::create_reduced_precision_rng<VALUE_TYPE>(
+      distribution, seed, device, device_index, platform_name,
+      generator_name);
+}
+
+/**
+ * Create an RNG instance which samples uniform fixed point values in [0, 1)
+ * stored as std::uint8_t or std::uint16_t. Four or two samples are packed
+ * into each 32-bit word drawn from the platform.
+ *
+ * @param distribution UniformFixedPoint distribution.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::UniformFixedPoint<VALUE_TYPE> distribution,
+           std::uint64_t seed, sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  return Private::create_reduced_precision_rng<VALUE_TYPE>(
+      distribution, seed, device, device_index, platform_name,
+      generator_name);
+}
+
+/**
+ * Create an RNG instance which samples a tabulated distribution, see
+ * InverseCDFTable. The samples are generated and mapped through the inverse
+ * cumulative distribution by a single kernel with a Philox stream per sample,
+ * keyed by standard Uniform samples drawn from the platform, hence the table
+ * lookup is fused with generation on every platform.
+ *
+ * @param distribution Tabulated distribution from InverseCDFTable.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::Tabulated<VALUE_TYPE> distribution,
+           std::uint64_t seed, sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  if ((distribution.num_intervals == 0) || (distribution.num_guide == 0)) {
+    std::cout << "Cannot sample a tabulated distribution with no intervals."
+              << std::endl;
+    return nullptr;
+  }
+  auto rng = create_rng<VALUE_TYPE>(
+      Distribution::Uniform<VALUE_TYPE>{VALUE_TYPE(0.0), VALUE_TYPE(1.0)},
+      seed, device, device_index, platform_name, generator_name);
+  if (rng == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<TabulatedRNG<VALUE_TYPE>>(rng, device, device_index,
+                                                    distribution);
+}
+
+/**
+ * Create an RNG instance which draws the points of the Sobol quasi-random
+ * sequence, optionally Owen scrambled, see Distribution::Sobol. The sequence
+ * is computed by a SYCL kernel on every platform, hence the platform and
+ * generator names are not used and the points are identical on all devices.
+ *
+ * @param distribution Sobol distribution.
+ * @param seed Value to seed the scramble with, unused if the sequence is not
+ * scrambled.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::Sobol<VALUE_TYPE> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           [[maybe_unused]] std::string platform_name = "default",
+           [[maybe_unused]] std::string generator_name = "default") {
+  if ((distribution.ndim == 0) ||
+      (distribution.ndim > Private::sobol_max_ndim)) {
+    std::cout << "The Sobol sequence is available for dimensions 1 to " +
+                     std::to_string(Private::sobol_max_ndim) + ", not " +
+                     std::to_string(distribution.ndim) + "."
+              << std::endl;
+    return nullptr;
+  }
+  auto rng = std::make_shared<SobolRNG<VALUE_TYPE>>(device, device_index,
+                                                    distribution, seed);
+  if (rng->d_directions == nullptr) {
+    std::cout << "Failed to allocate the Sobol direction numbers."
+              << std::endl;
+    return nullptr;
+  }
+  return rng;
+}
+
+namespace Private {
+
+/**
+ * Helper function to create an RNG which forms variance reduced sets from the
+ * samples of an RNG for a distribution.
+ *
+ * @param mode Stratified, LatinHypercube or Antithetic distribution.
+ * @param distribution Distribution of the independent samples.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform.
+ * @param generator_name Name of preferred RNG generator method.
+ * @param key_rng RNG to draw the words of the Philox keys of the
+ * permutations from, required for LatinHypercube.
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE, typename MODE_TYPE, typename DISTRIBUTION_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE> create_variance_reduction_rng(
+    MODE_TYPE mode, DISTRIBUTION_TYPE distribution, std::uint64_t seed,
+    sycl::device device, std::size_t device_index, std::string platform_name,
+    std::string generator_name,
+    RNGSharedPtr<std::uint32_t> key_rng = nullptr) {
+  auto rng = create_rng<VALUE_TYPE>(distribution, seed, device, device_index,
+                                    platform_name, generator_name);
+  if (rng == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<VarianceReductionRNG<VALUE_TYPE, MODE_TYPE>>(
+      rng, device, device_index, mode, key_rng);
+}
+
+} // namespace Private
+
+/**
+ * Create an RNG instance which draws stratified samples of a Uniform or
+ * Normal distribution, see Distribution::Stratified. The platform draws
+ * Uniform[0, 1) samples which are mapped to the quantiles of the strata by a
+ * single kernel.
+ *
+ * @param distribution Stratified Uniform or Normal distribution.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::Stratified<DISTRIBUTION_TYPE> distribution,
+           std::uint64_t seed, sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  return Private::create_variance_reduction_rng<VALUE_TYPE>(
+      distribution,
+      Distribution::Uniform<VALUE_TYPE>{VALUE_TYPE(0.0), VALUE_TYPE(1.0)},
+      seed, device, device_index, platform_name, generator_name);
+}
+
+/**
+ * Create an RNG instance which draws Latin hypercube designs of a Uniform or
+ * Normal distribution, see Distribution::LatinHypercube. The platform draws
+ * Uniform[0, 1) samples, the strata of each dimension are permuted on the
+ * device with keys drawn from a separate stream of words and the samples are
+ * mapped to the quantiles of their strata by a single kernel. The device
+ * workspace of the permutation is reused by each set.
+ *
+ * @param distribution LatinHypercube Uniform or Normal distribution.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::LatinHypercube<DISTRIBUTION_TYPE> distribution,
+           std::uint64_t seed, sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  if (distribution.ndim == 0) {
+    std::cout << "Cannot sample a Latin hypercube of dimension 0."
+              << std::endl;
+    return nullptr;
+  }
+  // The keys of the permutations are drawn from a separately seeded stream
+  // of words such that the stream of the uniform samples is not advanced.
+  auto key_rng = create_rng<std::uint32_t>(
+      Distribution::Bits<std::uint32_t>{}, create_seeds(1, 0, seed), device,
+      device_index, platform_name, generator_name);
+  if (key_rng == nullptr) {
+    return nullptr;
+  }
+  return Private::create_variance_reduction_rng<VALUE_TYPE>(
+      distribution,
+      Distribution::Uniform<VALUE_TYPE>{VALUE_TYPE(0.0), VALUE_TYPE(1.0)},
+      seed, device, device_index, platform_name, generator_name, key_rng);
+}
+
+/**
+ * Create an RNG instance which draws antithetic pairs of samples of a Uniform
+ * or Normal distribution, see Distribution::Antithetic. The platform draws
+ * half of the samples and the reflected samples are written by a single
+ * kernel.
+ *
+ * @param distribution Antithetic Uniform or Normal distribution.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(Distribution::Antithetic<DISTRIBUTION_TYPE> distribution,
+           std::uint64_t seed, sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  return Private::create_variance_reduction_rng<VALUE_TYPE>(
+      distribution, distribution.distribution, seed, device, device_index,
+      platform_name, generator_name);
+}
+
+/**
+ * Create a RNG instance which applies a transform to each sample. Only the
+ * stdlib platform fuses the transform with the generation, the transform is
+ * applied as the samples are created on the host. The oneMKL, cuRAND and
+ * hipRAND platforms sample with vendor library kernels which cannot be
+ * modified and apply the transform with a second kernel which reads and
+ * writes every sample once they are produced. On these platforms the
+ * transform gives no memory bandwidth saving over a user kernel launched
+ * after the samples are drawn, it is a convenience only.
+ *
+ * @param distribution Distribution RNG samples should be from.
+ * @param transform Device copyable callable which maps a VALUE_TYPE sample to
+ * a VALUE_TYPE. This callable must also be callable on the host.
+ * @param seed Value to seed RNG with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns RNG instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE,
+          typename TRANSFORM_TYPE>
+[[nodiscard]] RNGSharedPtr<VALUE_TYPE>
+create_rng(DISTRIBUTION_TYPE distribution, TRANSFORM_TYPE transform,
+           std::uint64_t seed, sycl::device device, std::size_t device_index,
+           std::string platform_name = "default",
+           std::string generator_name = "default") {
+  generator_name =
+      Private::get_env_string("NESO_RNG_TOOLKIT_GENERATOR", generator_name);
+
+  return Private::create_on_platform<VALUE_TYPE>(
+      platform_name, device, device_index,
+      [&](auto platform) -> RNGSharedPtr<VALUE_TYPE> {
+        if constexpr (std::is_same_v<decltype(platform),
+                                     StdLibPlatform<VALUE_TYPE>>) {
+          return platform.create_rng(distribution, transform, seed, device,
+                                     device_index, generator_name);
+        } else {
+          auto rng = platform.create_rng(distribution, seed, device,
+                                         device_index, generator_name);
+          if (rng == nullptr) {
+            return nullptr;
+          }
+          return std::make_shared<TransformRNG<VALUE_TYPE, TRANSFORM_TYPE>>(
+              rng, device, device_index, transform);
+        }
+      });
+}
+
+/**
+ * This is the function users could call to create an Engine instance. An
+ * Engine is not bound to a distribution, instead the distribution is passed
+ * with each request for samples.
+ *
+ * @param seed Value to seed Engine with.
+ * @param device SYCL Device samples are to be created on.
+ * @param device_index Index of SYCL device on the SYCL platform.
+ * @param platform_name Name of preferred RNG platform, default="default".
+ * @param generator_name Name of preferred RNG generator method,
+ * default="default".
+ * @returns Engine instance. nullptr on Error.
+ */
+template <typename VALUE_TYPE>
+[[nodiscard]] EngineSharedPtr<VALUE_TYPE>
+create_engine(std::uint64_t seed, sycl::device device,
+              std::size_t device_index, std::string platform_name = "default",
+              std::string generator_name = "default") {
+  generator_name =
+      Private::get_env_string("NESO_RNG_TOOLKIT_GENERATOR", generator_name);
+
+  return Private::create_on_platform<VALUE_TYPE>(
+      platform_name, device, device_index, [&](auto platform) {
+        return platform.create_engine(seed, device, device_index,
+                                      generator_name);
+      });
+}
+
 extern template RNGSharedPtr<double>
 create_rng(Distribution::Uniform<double> distribution, std::uint64_t seed,
            sycl::device device, std::size_t device_index,
@@ -105,6 +540,21 @@ create_rng(Distribution::Normal<double> distribution, std::uint64_t seed,
            sycl::device device, std::size_t device_index,
            std::string platform_name, std::string generator_name);
 
+extern template RNGSharedPtr<std::uint32_t>
+create_rng(Distribution::Bits<std::uint32_t> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name, std::string generator_name);
+
+extern template RNGSharedPtr<std::uint64_t>
+create_rng(Distribution::Bits<std::uint64_t> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name, std::string generator_name);
+
+extern template EngineSharedPtr<double>
+create_engine(std::uint64_t seed, sycl::device device,
+              std::size_t device_index, std::string platform_name,
+              std::string generator_name);
+
 } // namespace NESO::RNGToolkit
 
 #endif
@@ -0,0 +1,363 @@
+#ifndef _NESO_RNG_TOOLKIT_DISCRETE_HPP_
+#define _NESO_RNG_TOOLKIT_DISCRETE_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Compute the full 128-bit product of two 64-bit values. Callable from device
+ * code.
+ *
+ * @param[in] a First value.
+ * @param[in] b Second value.
+ * @param[out] lo Lower 64 bits of the product.
+ * @returns Upper 64 bits of the product.
+ */
+inline std::uint64_t mul_64(const std::uint64_t a, const std::uint64_t b,
+                            std::uint64_t &lo) {
+  const std::uint64_t a_lo = a & 0xFFFFFFFF;
+  const std::uint64_t a_hi = a >> 32;
+  const std::uint64_t b_lo = b & 0xFFFFFFFF;
+  const std::uint64_t b_hi = b >> 32;
+  const std::uint64_t p_0 = a_lo * b_lo;
+  const std::uint64_t p_1 = a_lo * b_hi;
+  const std::uint64_t p_2 = a_hi * b_lo;
+  const std::uint64_t p_3 = a_hi * b_hi;
+  const std::uint64_t middle =
+      (p_0 >> 32) + (p_1 & 0xFFFFFFFF) + (p_2 & 0xFFFFFFFF);
+  lo = (middle << 32) | (p_0 & 0xFFFFFFFF);
+  return p_3 + (p_1 >> 32) + (p_2 >> 32) + (middle >> 32);
+}
+
+/**
+ * Sample an integer uniformly from [0, range) without bias using the method
+ * of Lemire, "Fast random integer generation in an interval" (2019). Callable
+ * from device code.
+ *
+ * @param stream Source of random bits.
+ * @param range Number of values to sample from, must be non-zero.
+ * @returns Sample in [0, range).
+ */
+inline std::uint64_t sample_bounded(PhiloxStream &stream,
+                                    const std::uint64_t range) {
+  if (range <= 0xFFFFFFFF) {
+    const std::uint32_t s = static_cast<std::uint32_t>(range);
+    std::uint64_t m = static_cast<std::uint64_t>(stream.next_uint32()) * s;
+    std::uint32_t l = static_cast<std::uint32_t>(m);
+    if (l < s) {
+      // The division is only required in the rare case that the sample might
+      // be rejected.
+      const std::uint32_t t = (0u - s) % s;
+      while (l < t) {
+        m = static_cast<std::uint64_t>(stream.next_uint32()) * s;
+        l = static_cast<std::uint32_t>(m);
+      }
+    }
+    return m >> 32;
+  } else {
+    std::uint64_t l;
+    std::uint64_t m = mul_64(stream.next_uint64(), range, l);
+    if (l < range) {
+      const std::uint64_t t = (0ull - range) % range;
+      while (l < t) {
+        m = mul_64(stream.next_uint64(), range, l);
+      }
+    }
+    return m;
+  }
+}
+
+/**
+ * Sample random bits. Callable from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename BITS_TYPE>
+inline BITS_TYPE sample_discrete(
+    [[maybe_unused]] const Distribution::Bits<BITS_TYPE> &distribution,
+    PhiloxStream &stream) {
+  if constexpr (sizeof(BITS_TYPE) == 8) {
+    return stream.next_uint64();
+  } else {
+    return stream.next_uint32();
+  }
+}
+
+/**
+ * Sample from a UniformInt distribution. Callable from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline INT_TYPE
+sample_discrete(const Distribution::UniformInt<INT_TYPE> &distribution,
+                PhiloxStream &stream) {
+  using UINT_TYPE = std::make_unsigned_t<INT_TYPE>;
+  const UINT_TYPE a = static_cast<UINT_TYPE>(distribution.a);
+  const UINT_TYPE width = static_cast<UINT_TYPE>(distribution.b) - a;
+  const std::uint64_t range = static_cast<std::uint64_t>(width) + 1;
+  // The range is zero if the interval is every 64-bit value.
+  const std::uint64_t offset =
+      (range == 0) ? stream.next_uint64() : sample_bounded(stream, range);
+  return static_cast<INT_TYPE>(static_cast<UINT_TYPE>(a + offset));
+}
+
+/**
+ * Sample from a Bernoulli distribution. Callable from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline INT_TYPE
+sample_discrete(const Distribution::Bernoulli<INT_TYPE> &distribution,
+                PhiloxStream &stream) {
+  const REAL_TYPE p = static_cast<REAL_TYPE>(distribution.p);
+  return (stream.next_uniform<REAL_TYPE>() < p) ? 1 : 0;
+}
+
+/**
+ * Sample from an alias table with one bounded integer and one 32-bit
+ * comparison, i.e. in constant time for any number of categories. Callable
+ * from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline INT_TYPE
+sample_discrete(const Distribution::Alias<INT_TYPE> &distribution,
+                PhiloxStream &stream) {
+  const std::uint32_t bucket = static_cast<std::uint32_t>(
+      sample_bounded(stream, distribution.num_categories));
+  const std::uint32_t alias = distribution.d_alias[bucket];
+  const bool keep = stream.next_uint32() < distribution.d_threshold[bucket];
+  return static_cast<INT_TYPE>((keep || (alias == bucket)) ? bucket : alias);
+}
+
+/**
+ * Sample from a Poisson distribution. For small means the uniform samples are
+ * multiplied until the product falls below exp(-lambda). For larger means the
+ * transformed rejection method PTRS of Hormann, "The transformed rejection
+ * method for generating Poisson random variables" (1993) is used which
+ * requires approximately 1.2 pairs of uniform samples per sample for any
+ * mean. Callable from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline INT_TYPE
+sample_discrete(const Distribution::Poisson<INT_TYPE> &distribution,
+                PhiloxStream &stream) {
+  const REAL_TYPE lambda = static_cast<REAL_TYPE>(distribution.lambda);
+  if (!(lambda > REAL_TYPE(0.0))) {
+    return 0;
+  }
+
+  if (lambda < REAL_TYPE(10.0)) {
+    const REAL_TYPE exp_neg_lambda = sycl::exp(-lambda);
+    INT_TYPE k = 0;
+    REAL_TYPE product = stream.next_uniform<REAL_TYPE>();
+    while (product > exp_neg_lambda) {
+      k++;
+      product *= stream.next_uniform<REAL_TYPE>();
+    }
+    return k;
+  }
+
+  // Constants are converted to REAL_TYPE such that no arithmetic is performed
+  // in double precision for single precision engines.
+  using R = REAL_TYPE;
+  const R sqrt_lambda = sycl::sqrt(lambda);
+  const R log_lambda = sycl::log(lambda);
+  const R b = R(0.931) + R(2.53) * sqrt_lambda;
+  const R a = R(-0.059) + R(0.02483) * b;
+  const R log_inv_alpha = sycl::log(R(1.1239) + R(1.1328) / (b - R(3.4)));
+  const R v_r = R(0.9277) - R(3.6224) / (b - R(2.0));
+  while (true) {
+    const R u = stream.next_uniform<R>() - R(0.5);
+    const R v = stream.next_uniform<R>();
+    const R us = R(0.5) - sycl::fabs(u);
+    const R k = sycl::floor((R(2.0) * a / us + b) * u + lambda + R(0.43));
+    if ((us >= R(0.07)) && (v <= v_r)) {
+      return static_cast<INT_TYPE>(k);
+    }
+    if ((k < R(0.0)) || ((us < R(0.013)) && (v > us))) {
+      continue;
+    }
+    if (sycl::log(v) + log_inv_alpha - sycl::log(a / (us * us) + b) <=
+        -lambda + k * log_lambda - sycl::lgamma(k + R(1.0))) {
+      return static_cast<INT_TYPE>(k);
+    }
+  }
+}
+
+/**
+ * @returns The error of the Stirling approximation to log(k!), i.e.
+ * log(k!) - (k + 0.5) log(k + 1) + (k + 1) - 0.5 log(2 pi). Callable from
+ * device code.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE stirling_approximation_tail(const REAL_TYPE k) {
+  constexpr REAL_TYPE tail[10] = {
+      0.0810614667953272,  0.0413406959554092,  0.0276779256849983,
+      0.02079067210376509, 0.0166446911898211,  0.0138761288230707,
+      0.0118967099458917,  0.0104112652619720,  0.00925546218271273,
+      0.00833056343336287};
+  if (k <= REAL_TYPE(9.0)) {
+    return tail[static_cast<int>(k)];
+  }
+  const REAL_TYPE kp1 = k + REAL_TYPE(1.0);
+  const REAL_TYPE kp1_squared = kp1 * kp1;
+  return (static_cast<REAL_TYPE>(1.0 / 12.0) -
+          (static_cast<REAL_TYPE>(1.0 / 360.0) -
+           static_cast<REAL_TYPE>(1.0 / 1260.0) / kp1_squared) /
+              kp1_squared) /
+         kp1;
+}
+
+/**
+ * Sample from a Binomial distribution with p <= 0.5. If n * p is small the
+ * number of geometrically distributed waiting times which fit in n trials is
+ * counted. Otherwise the transformed rejection method with squeeze BTRS of
+ * Hormann, "The generation of binomial random variates" (1993) is used. Like
+ * BTPE this requires a bounded expected number of uniform samples for any n.
+ * Callable from device code.
+ *
+ * @param n Number of trials.
+ * @param p Probability of success, must be in (0, 0.5].
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline INT_TYPE sample_binomial(const INT_TYPE n, const REAL_TYPE p,
+                                PhiloxStream &stream) {
+  using R = REAL_TYPE;
+  const R count = static_cast<R>(n);
+  if (count * p < R(10.0)) {
+    const R log_q = sycl::log1p(-p);
+    R geometric_sum = R(0.0);
+    INT_TYPE k = 0;
+    while (true) {
+      geometric_sum += sycl::ceil(sycl::log(stream.next_uniform<R>()) / log_q);
+      if (geometric_sum > count) {
+        return k;
+      }
+      k++;
+    }
+  }
+
+  const R stddev = sycl::sqrt(count * p * (R(1.0) - p));
+  const R b = R(1.15) + R(2.53) * stddev;
+  const R a = R(-0.0873) + R(0.0248) * b + R(0.01) * p;
+  const R c = count * p + R(0.5);
+  const R v_r = R(0.92) - R(4.2) / b;
+  const R r = p / (R(1.0) - p);
+  const R alpha = (R(2.83) + R(5.1) / b) * stddev;
+  const R m = sycl::floor((count + R(1.0)) * p);
+  while (true) {
+    const R u = stream.next_uniform<R>() - R(0.5);
+    R v = stream.next_uniform<R>();
+    const R us = R(0.5) - sycl::fabs(u);
+    const R k = sycl::floor((R(2.0) * a / us + b) * u + c);
+    if ((k < R(0.0)) || (k > count)) {
+      continue;
+    }
+    if ((us >= R(0.07)) && (v <= v_r)) {
+      return static_cast<INT_TYPE>(k);
+    }
+    v = sycl::log(v * alpha / (a / (us * us) + b));
+    const R upper_bound =
+        (m + R(0.5)) * sycl::log((m + R(1.0)) / (r * (count - m + R(1.0)))) +
+        (count + R(1.0)) *
+            sycl::log((count - m + R(1.0)) / (count - k + R(1.0))) +
+        (k + R(0.5)) * sycl::log(r * (count - k + R(1.0)) / (k + R(1.0))) +
+        stirling_approximation_tail(m) +
+        stirling_approximation_tail(count - m) -
+        stirling_approximation_tail(k) - stirling_approximation_tail(count - k);
+    if (v <= upper_bound) {
+      return static_cast<INT_TYPE>(k);
+    }
+  }
+}
+
+/**
+ * Sample from a Binomial distribution. Callable from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline INT_TYPE
+sample_discrete(const Distribution::Binomial<INT_TYPE> &distribution,
+                PhiloxStream &stream) {
+  const INT_TYPE n = distribution.n;
+  const REAL_TYPE p = static_cast<REAL_TYPE>(distribution.p);
+  if ((n <= 0) || !(p > REAL_TYPE(0.0))) {
+    return 0;
+  }
+  if (p >= REAL_TYPE(1.0)) {
+    return n;
+  }
+  // The methods assume p <= 0.5 hence sample the failures otherwise.
+  if (p > REAL_TYPE(0.5)) {
+    return n - sample_binomial(n, REAL_TYPE(1.0) - p, stream);
+  }
+  return sample_binomial(n, p, stream);
+}
+
+/**
+ * Submit a kernel which samples a discrete distribution. Sample i is computed
+ * from the Philox stream with index i, and the key is formed from four
+ * samples of the standard Uniform distribution, hence the samples do not
+ * depend on how the kernel is executed.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Distribution to sample.
+ * @param d_key Device pointer to four samples from the standard Uniform
+ * distribution.
+ * @param d_ptr Device pointer to fill with num_samples samples.
+ * @param num_samples Number of samples.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename REAL_TYPE, typename DISTRIBUTION_TYPE, typename INT_TYPE>
+inline sycl::event submit_discrete(sycl::queue &queue,
+                                   const DISTRIBUTION_TYPE distribution,
+                                   const REAL_TYPE *d_key, INT_TYPE *d_ptr,
+                                   const std::size_t num_samples,
+                                   sycl::event event = sycl::event{},
+                                   const Distribution::Strided layout =
+                                       Distribution::Strided{}) {
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    d_ptr[Distribution::get_strided_index(layout, ix)] =
+        sample_discrete<REAL_TYPE>(distribution, stream);
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef _NESO_RNG_TOOLKIT_DISTRIBUTION_HPP_
 #define _NESO_RNG_TOOLKIT_DISTRIBUTION_HPP_
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -107,6 +109,439 @@ template <typename VALUE_TYPE> struct Normal {
   VALUE_TYPE stddev{1.0};
 };
 
+/**
+ * Samples should be distributed ~Exponential(lambda) with density
+ * lambda * exp(-lambda * x) for x >= 0, i.e. lambda is the rate and the mean
+ * is 1 / lambda.
+ */
+template <typename VALUE_TYPE> struct Exponential {
+  VALUE_TYPE lambda{1.0};
+};
+
+/**
+ * Samples should be distributed as exp(X) where X ~ Normal(m, s*s).
+ */
+template <typename VALUE_TYPE> struct LogNormal {
+  VALUE_TYPE m{0.0};
+  VALUE_TYPE s{1.0};
+};
+
+/**
+ * Samples should be distributed ~Gamma(alpha, beta) with density proportional
+ * to x^(alpha - 1) * exp(-x / beta) for x > 0, i.e. alpha is the shape and
+ * beta is the scale.
+ */
+template <typename VALUE_TYPE> struct Gamma {
+  VALUE_TYPE alpha{1.0};
+  VALUE_TYPE beta{1.0};
+};
+
+/**
+ * Samples should be uniformly distributed unsigned integers, i.e. each bit of
+ * each sample is independently 0 or 1 with equal probability. BITS_TYPE must
+ * be std::uint32_t or std::uint64_t.
+ */
+template <typename BITS_TYPE> struct Bits {};
+
+/**
+ * Samples should be uniformly distributed fixed point values in [0, 1). A
+ * sample k represents the value k * 2^-N where N is the number of bits in
+ * FIXED_TYPE. FIXED_TYPE must be std::uint8_t or std::uint16_t.
+ */
+template <typename FIXED_TYPE> struct UniformFixedPoint {};
+
+/**
+ * Integer samples should be uniformly distributed in the closed interval
+ * [a, b] as for std::uniform_int_distribution.
+ */
+template <typename INT_TYPE> struct UniformInt {
+  INT_TYPE a{0};
+  INT_TYPE b{1};
+};
+
+/**
+ * Integer samples should be 1 with probability p and 0 otherwise.
+ */
+template <typename INT_TYPE> struct Bernoulli {
+  double p{0.5};
+};
+
+/**
+ * Integer samples should be distributed ~Poisson(lambda).
+ */
+template <typename INT_TYPE> struct Poisson {
+  double lambda{1.0};
+};
+
+/**
+ * Integer samples should be distributed ~Binomial(n, p), i.e. the number of
+ * successes in n trials with probability p of success.
+ */
+template <typename INT_TYPE> struct Binomial {
+  INT_TYPE n{1};
+  double p{0.5};
+};
+
+/**
+ * Integer samples should be in [0, num_categories) where category k is
+ * sampled with a probability proportional to the weight of k. The device
+ * arrays form an alias table and are created by AliasTable::build from the
+ * weights, the arrays must remain valid until the samples have been drawn.
+ * Category k is sampled with probability d_threshold[k] / 2^32 when a
+ * uniformly chosen bucket is k, otherwise d_alias[k] is sampled, and buckets
+ * with d_alias[k] == k always sample k.
+ */
+template <typename INT_TYPE> struct Alias {
+  const std::uint32_t *d_threshold{nullptr};
+  const std::uint32_t *d_alias{nullptr};
+  std::size_t num_categories{0};
+};
+
+/**
+ * Integer samples form a uniformly random permutation within each segment,
+ * e.g. to pair the particles in each cell for binary collisions. d_offsets
+ * is the exclusive prefix sum of the segment sizes with num_segments + 1
+ * entries, as for CellPositions, and num_samples should be
+ * d_offsets[num_segments]. The samples d_offsets[s] <= i < d_offsets[s + 1]
+ * are the indices d_offsets[s], ..., d_offsets[s + 1] - 1 in a random order.
+ * d_offsets is a device pointer which must remain valid until the samples
+ * have been drawn. max_segment_size is an upper bound on the size of every
+ * segment, which bounds the number of sorting kernels; zero means the bound
+ * is num_samples. A bound smaller than the largest segment leaves the
+ * permutation of that segment non-uniform.
+ */
+template <typename INT_TYPE> struct SegmentedPermutation {
+  const std::size_t *d_offsets{nullptr};
+  std::size_t num_segments{0};
+  std::size_t max_segment_size{0};
+};
+
+/**
+ * Samples should be distributed with a tabulated density on [x_0, x_m]. The
+ * density is linear between the interval endpoint values d_left[i] and
+ * d_right[i] on each interval [d_x[i], d_x[i + 1]] and d_cdf holds the
+ * normalised cumulative distribution at the m + 1 points. Sample u of the
+ * standard Uniform distribution is mapped through the inverse cumulative
+ * distribution, the interval is found through the guide table d_guide where
+ * entry g is the interval which contains the value g / num_guide of the
+ * cumulative distribution. The device arrays are created by
+ * InverseCDFTable and must remain valid until the samples have been drawn.
+ */
+template <typename VALUE_TYPE> struct Tabulated {
+  const VALUE_TYPE *d_x{nullptr};
+  const VALUE_TYPE *d_cdf{nullptr};
+  const VALUE_TYPE *d_left{nullptr};
+  const VALUE_TYPE *d_right{nullptr};
+  const std::uint32_t *d_guide{nullptr};
+  std::size_t num_intervals{0};
+  std::size_t num_guide{0};
+};
+
+/**
+ * Samples should be drawn by rejection. Candidates are drawn from the proposal
+ * distribution, a Uniform, Normal or Exponential distribution, and candidate x
+ * is accepted with probability accept(x). The accept callable must be device
+ * copyable and return either a bool, i.e. a predicate, or an acceptance
+ * probability in [0, 1]. acceptance_rate is the expected fraction of accepted
+ * candidates which sizes the first batch of candidates, the Engine refines the
+ * estimate from the candidates it draws. Each sample which is not filled from
+ * the first batch draws at most max_trials further candidates. The Engine
+ * keeps one refined estimate per distribution type and tag, hence
+ * distributions of the same type whose accept callables capture different
+ * values, e.g. different truncation bounds, should pass different tags.
+ */
+template <typename PROPOSAL_TYPE, typename ACCEPT_TYPE> struct Rejection {
+  PROPOSAL_TYPE proposal;
+  ACCEPT_TYPE accept;
+  double acceptance_rate{0.5};
+  std::size_t max_trials{1000000};
+  std::uint64_t tag{0};
+};
+template <typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+Rejection(PROPOSAL_TYPE, ACCEPT_TYPE) -> Rejection<PROPOSAL_TYPE, ACCEPT_TYPE>;
+template <typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+Rejection(PROPOSAL_TYPE, ACCEPT_TYPE, double)
+    -> Rejection<PROPOSAL_TYPE, ACCEPT_TYPE>;
+template <typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+Rejection(PROPOSAL_TYPE, ACCEPT_TYPE, double, std::size_t)
+    -> Rejection<PROPOSAL_TYPE, ACCEPT_TYPE>;
+template <typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+Rejection(PROPOSAL_TYPE, ACCEPT_TYPE, double, std::size_t, std::uint64_t)
+    -> Rejection<PROPOSAL_TYPE, ACCEPT_TYPE>;
+
+/**
+ * Helper function to determine which parameters a sample should use for the
+ * distributions which read parameters from device arrays. If d_offsets is
+ * nullptr then sample i uses parameters i. Otherwise the samples are grouped
+ * into num_segments contiguous segments where segment s contains the samples
+ * d_offsets[s] <= i < d_offsets[s + 1], and the samples in segment s use
+ * parameters s. This function is callable from device code.
+ *
+ * @param d_offsets Device pointer to num_segments + 1 segment offsets or
+ * nullptr.
+ * @param num_segments Number of segments.
+ * @param index Index of the sample.
+ * @returns Index of the parameters for the sample.
+ */
+inline std::size_t get_parameter_index(const std::size_t *d_offsets,
+                                       const std::size_t num_segments,
+                                       const std::size_t index) {
+  if (d_offsets == nullptr) {
+    return index;
+  }
+  // Find the last segment s such that d_offsets[s] <= index.
+  std::size_t low = 0;
+  std::size_t high = num_segments;
+  while ((high - low) > 1) {
+    const std::size_t mid = low + (high - low) / 2;
+    if (d_offsets[mid] <= index) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+/**
+ * Sample i should be uniformly distributed in [d_a[j], d_b[j]) where j is
+ * determined from i by get_parameter_index. The parameter arrays are device
+ * pointers which must remain valid until the samples have been drawn.
+ */
+template <typename VALUE_TYPE> struct UniformArray {
+  const VALUE_TYPE *d_a{nullptr};
+  const VALUE_TYPE *d_b{nullptr};
+  const std::size_t *d_offsets{nullptr};
+  std::size_t num_segments{0};
+};
+
+/**
+ * Sample i should be distributed ~Normal(d_mean[j], d_stddev[j]*d_stddev[j])
+ * where j is determined from i by get_parameter_index. The parameter arrays
+ * are device pointers which must remain valid until the samples have been
+ * drawn.
+ */
+template <typename VALUE_TYPE> struct NormalArray {
+  const VALUE_TYPE *d_mean{nullptr};
+  const VALUE_TYPE *d_stddev{nullptr};
+  const std::size_t *d_offsets{nullptr};
+  std::size_t num_segments{0};
+};
+
+/**
+ * The layout of vector valued samples in memory. For num_samples vectors of
+ * dimension ndim, component d of vector i is stored at index
+ *   AoS: i * ndim + d,
+ *   SoA: d * num_samples + i.
+ */
+enum class Layout { AoS, SoA };
+
+/**
+ * Describes where samples are written in memory when they are not written
+ * contiguously. Samples are written in blocks of block_size contiguous values
+ * and the start of consecutive blocks are stride values apart, i.e. sample j
+ * is written to index (j / block_size) * stride + j % block_size. For
+ * example
+ *   - a single component of num_components interleaved components uses
+ *     block_size = 1 and stride = num_components with the pointer offset to
+ *     the first value of the component,
+ *   - a 2D pitched allocation with rows of width values and a pitch of
+ *     pitch values uses block_size = width and stride = pitch.
+ */
+struct Strided {
+  std::size_t block_size{1};
+  std::size_t stride{1};
+};
+
+/**
+ * Callable from device code.
+ *
+ * @param layout Strided layout.
+ * @param index Index of a value in the contiguous order.
+ * @returns Index the value is written to in the strided layout.
+ */
+inline std::size_t get_strided_index(const Strided &layout,
+                                     const std::size_t index) {
+  if (layout.block_size == layout.stride) {
+    return index;
+  }
+  return (index / layout.block_size) * layout.stride +
+         index % layout.block_size;
+}
+
+/**
+ * Samples are the points of the Sobol low-discrepancy sequence in the unit
+ * hypercube of dimension ndim, at most 1024, with the direction numbers of
+ * Joe and Kuo. Each point is a vector of ndim values in the open interval
+ * (0, 1), hence the number of values drawn must be a multiple of ndim, and
+ * with the SoA layout each component of the points drawn by one call is
+ * contiguous. The first point drawn is point offset of the sequence, e.g.
+ * ranks draw disjoint slices of one sequence with different offsets. If
+ * scrambled is true each dimension is randomised by an Owen (nested uniform)
+ * scramble determined by the seed, the scrambled points remain a
+ * low-discrepancy sequence and each point is uniformly distributed.
+ */
+template <typename VALUE_TYPE> struct Sobol {
+  std::size_t ndim{1};
+  bool scrambled{false};
+  std::uint64_t offset{0};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * Samples of a Uniform or Normal distribution which are stratified. The n
+ * samples drawn by one call are the quantiles of the distribution at
+ * (i + u_i) / n for i = 0, ..., n - 1 where u_i ~ Uniform(0, 1), i.e. sample
+ * i is drawn from the i-th of n equally likely strata.
+ */
+template <typename DISTRIBUTION_TYPE> struct Stratified {
+  DISTRIBUTION_TYPE distribution;
+};
+
+/**
+ * Samples of a Uniform or Normal distribution which form a Latin hypercube
+ * design. The n values drawn by one call are n / ndim points of dimension
+ * ndim, stored in the given layout, and for each dimension the points occupy
+ * every one of the n / ndim equally likely strata of the distribution
+ * exactly once, in an independent random order for each dimension.
+ */
+template <typename DISTRIBUTION_TYPE> struct LatinHypercube {
+  DISTRIBUTION_TYPE distribution;
+  std::size_t ndim{1};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * Samples of a Uniform or Normal distribution which are antithetic pairs.
+ * For the n samples drawn by one call the first h = (n + 1) / 2 samples are
+ * independent and sample h + i is the reflection of sample i about the mean
+ * of the distribution, i.e. a + b - x or 2 * mean - x.
+ */
+template <typename DISTRIBUTION_TYPE> struct Antithetic {
+  DISTRIBUTION_TYPE distribution;
+};
+
+/**
+ * Samples are velocity vectors of dimension ndim (at most 3). Component d of
+ * each sample is distributed with drift drift[d] and scale
+ * thermal_velocity[d], i.e. a drifting bi-Maxwellian if the scales differ.
+ *
+ * If kappa is zero the components are independent and component d is
+ * distributed ~Normal(drift[d], thermal_velocity[d]*thermal_velocity[d]).
+ *
+ * If kappa is non-zero samples are from the kappa distribution with density
+ * proportional to
+ *
+ *   (1 + sum_d ((v_d - drift[d]) / thermal_velocity[d])^2 / (2 kappa))
+ *     ^ -(kappa + 1)
+ *
+ * which tends to the Maxwellian case as kappa tends to infinity. The value
+ * 2 * kappa + 2 - ndim must be positive, e.g. for ndim = 3 kappa must be
+ * greater than 0.5.
+ */
+template <typename VALUE_TYPE> struct Maxwellian {
+  /// Maximum dimension of the samples.
+  static constexpr std::size_t max_ndim = 3;
+  std::size_t ndim{3};
+  VALUE_TYPE drift[max_ndim]{0.0, 0.0, 0.0};
+  VALUE_TYPE thermal_velocity[max_ndim]{1.0, 1.0, 1.0};
+  VALUE_TYPE kappa{0.0};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * Samples are unit vectors of dimension ndim (at most 3) which are uniformly
+ * distributed on the unit sphere, i.e. isotropic directions. For ndim = 2 the
+ * samples are uniformly distributed on the unit circle and for ndim = 1 the
+ * samples are -1 or 1 with equal probability.
+ */
+template <typename VALUE_TYPE> struct UnitSphere {
+  /// Maximum dimension of the samples.
+  static constexpr std::size_t max_ndim = 3;
+  std::size_t ndim{3};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * Samples are vectors of dimension ndim (at most 3) which are uniformly
+ * distributed in the unit ball, i.e. the unit disk for ndim = 2 and the
+ * interval (-1, 1) for ndim = 1.
+ */
+template <typename VALUE_TYPE> struct UnitBall {
+  /// Maximum dimension of the samples.
+  static constexpr std::size_t max_ndim = 3;
+  std::size_t ndim{3};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * The shape of the mesh cells positions are sampled in. Each cell is
+ * described by a number of points of dimension ndim:
+ *   Box: 2 points, the lower and upper corners of an axis-aligned box,
+ *        ndim = 1, 2 or 3.
+ *   Triangle: 3 vertices, ndim = 2 or 3.
+ *   Quadrilateral: 4 vertices ordered around the boundary of a convex
+ *        planar quadrilateral, ndim = 2 or 3.
+ *   Tetrahedron: 4 vertices, ndim = 3.
+ */
+enum class CellShape { Box, Triangle, Quadrilateral, Tetrahedron };
+
+/**
+ * Samples are positions of dimension ndim uniformly distributed in mesh
+ * cells. Sample i is in cell j where j is determined from i by
+ * get_parameter_index, i.e. d_offsets is the exclusive prefix sum of the
+ * number of samples in each cell, and num_samples should be
+ * d_offsets[num_cells]. The points of cell j are the values
+ * d_cells[j * num_points * ndim + p * ndim + d] for point p and component d.
+ * The arrays are device pointers which must remain valid until the samples
+ * have been drawn.
+ */
+template <typename VALUE_TYPE> struct CellPositions {
+  CellShape shape{CellShape::Box};
+  std::size_t ndim{2};
+  const VALUE_TYPE *d_cells{nullptr};
+  const std::size_t *d_offsets{nullptr};
+  std::size_t num_cells{0};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * Samples are paths of a Wiener process, i.e. Brownian motion, over
+ * num_steps steps of length dt. Each sample is num_steps values which are
+ * either the increments W(t_k) - W(t_{k-1}) ~ Normal(0, dt), or if cumulative
+ * is true the values W(t_k) of the path with W(0) = 0, for k = 1, ...,
+ * num_steps. The steps of each path are the components of the vector valued
+ * sample, i.e. with the SoA layout the values for step k of all paths are
+ * contiguous.
+ */
+template <typename VALUE_TYPE> struct Wiener {
+  VALUE_TYPE dt{1.0};
+  std::size_t num_steps{1};
+  bool cumulative{false};
+  Layout layout{Layout::AoS};
+};
+
+/**
+ * Samples are vectors of dimension ndim distributed ~Normal(mean, C) where
+ * the covariance C = L L^T is given by its lower triangular Cholesky factor
+ * L. Sample i uses parameter set j where j is determined from i by
+ * get_parameter_index, except that all samples use parameter set 0 if
+ * d_offsets is nullptr and num_segments is 1. Parameter set j has mean
+ * d_mean[j * ndim + d] and factor entries
+ * L_rc = d_factor[j * ndim * ndim + r * ndim + c] for c <= r, the entries
+ * above the diagonal are not read. The factors of covariance matrices are
+ * computed on the device by cholesky_factor. The arrays are device pointers
+ * which must remain valid until the samples have been drawn.
+ */
+template <typename VALUE_TYPE> struct MultivariateNormal {
+  std::size_t ndim{3};
+  const VALUE_TYPE *d_mean{nullptr};
+  const VALUE_TYPE *d_factor{nullptr};
+  const std::size_t *d_offsets{nullptr};
+  std::size_t num_segments{1};
+  Layout layout{Layout::AoS};
+};
+
 } // namespace Distribution
 
 } // namespace NESO::RNGToolkit
@@ -0,0 +1,1704 @@
+#ifndef _NESO_RNG_TOOLKIT_ENGINE_HPP_
+#define _NESO_RNG_TOOLKIT_ENGINE_HPP_
+
+#include "cells.hpp"
+#include "discrete.hpp"
+#include "distribution.hpp"
+#include "gamma.hpp"
+#include "multivariate.hpp"
+#include "permutation.hpp"
+#include "philox.hpp"
+#include "rejection.hpp"
+#include "sphere.hpp"
+#include "state.hpp"
+#include "tabulated.hpp"
+#include "typedefs.hpp"
+#include "wiener.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Map a sample from the standard Uniform distribution on [0, 1) to the
+ * distribution of sample index. Callable from device code.
+ *
+ * @param distribution Distribution to map the sample to.
+ * @param sample Sample from the standard Uniform distribution.
+ * @param index Index of the sample.
+ * @returns Sample from the distribution.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE
+scale_sample(const Distribution::UniformArray<VALUE_TYPE> &distribution,
+             const VALUE_TYPE sample, const std::size_t index) {
+  const std::size_t px = Distribution::get_parameter_index(
+      distribution.d_offsets, distribution.num_segments, index);
+  const VALUE_TYPE a = distribution.d_a[px];
+  const VALUE_TYPE b = distribution.d_b[px];
+  const VALUE_TYPE value = sample * (b - a) + a;
+  // Ensure the sample is actually in [a, b) after rounding.
+  if (value >= b) {
+    return sycl::nextafter(b, std::numeric_limits<VALUE_TYPE>::lowest());
+  }
+  return (value < a) ? a : value;
+}
+
+/**
+ * Map a sample from the standard Normal distribution to the distribution of
+ * sample index. Callable from device code.
+ *
+ * @param distribution Distribution to map the sample to.
+ * @param sample Sample from the standard Normal distribution.
+ * @param index Index of the sample.
+ * @returns Sample from the distribution.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE
+scale_sample(const Distribution::NormalArray<VALUE_TYPE> &distribution,
+             const VALUE_TYPE sample, const std::size_t index) {
+  const std::size_t px = Distribution::get_parameter_index(
+      distribution.d_offsets, distribution.num_segments, index);
+  return sample * distribution.d_stddev[px] + distribution.d_mean[px];
+}
+
+/**
+ * Draw a pair of samples from the standard Uniform distribution on [0, 1)
+ * from a Philox stream. Callable from device code.
+ *
+ * @param stream Philox stream to draw the pair from.
+ * @param samples Output pair of samples.
+ */
+template <typename VALUE_TYPE>
+inline void
+sample_standard_pair(const Distribution::UniformArray<VALUE_TYPE> &,
+                     PhiloxStream &stream, VALUE_TYPE *samples) {
+  samples[0] = stream.next_uniform<VALUE_TYPE>();
+  samples[1] = stream.next_uniform<VALUE_TYPE>();
+}
+
+/**
+ * Draw a pair of samples from the standard Normal distribution from a Philox
+ * stream with the Box-Muller transform. Callable from device code.
+ *
+ * @param stream Philox stream to draw the pair from.
+ * @param samples Output pair of samples.
+ */
+template <typename VALUE_TYPE>
+inline void
+sample_standard_pair(const Distribution::NormalArray<VALUE_TYPE> &,
+                     PhiloxStream &stream, VALUE_TYPE *samples) {
+  using R = VALUE_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  const R r = sycl::sqrt(R(-2.0) * sycl::log(stream.next_uniform<R>()));
+  const R theta = two_pi * stream.next_uniform<R>();
+  samples[0] = r * sycl::cos(theta);
+  samples[1] = r * sycl::sin(theta);
+}
+
+/**
+ * Submit a kernel which samples a distribution with per sample parameters.
+ * Each work item draws a pair of standard samples from its own Philox
+ * stream and writes them scaled by the parameters of their indices, hence
+ * each sample is written once.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Distribution to sample, UniformArray or NormalArray.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to write num_samples samples to.
+ * @param num_samples Number of samples.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline sycl::event
+submit_array_samples(sycl::queue &queue, const DISTRIBUTION_TYPE distribution,
+                     const VALUE_TYPE *d_key, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples,
+                     sycl::event event = sycl::event{},
+                     const Distribution::Strided layout =
+                         Distribution::Strided{}) {
+  const std::size_t num_pairs = (num_samples + 1) / 2;
+  return queue.parallel_for(sycl::range<1>(num_pairs), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    VALUE_TYPE samples[2];
+    sample_standard_pair(distribution, stream, samples);
+    for (std::size_t sx = 0; sx < 2; sx++) {
+      const std::size_t index = 2 * ix + sx;
+      if (index < num_samples) {
+        d_ptr[Distribution::get_strided_index(layout, index)] =
+            scale_sample(distribution, samples[sx], index);
+      }
+    }
+  });
+}
+
+/**
+ * Submit a kernel which samples Maxwellian or kappa distributed velocity
+ * vectors. Each vector uses its own Philox stream: the standard Normal
+ * components are drawn in pairs with the Box-Muller transform, then for the
+ * kappa distribution a Chi-squared sample W with 2 * kappa + 2 - ndim
+ * degrees of freedom is drawn as a Gamma(dof / 2, 2) sample and the
+ * components are scaled by sqrt(2 kappa / W). The drift and thermal velocity
+ * are applied before each component is stored once.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Distribution to sample.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to write ndim * num_samples values to.
+ * @param num_samples Number of vectors.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename VALUE_TYPE>
+inline sycl::event
+submit_maxwellian(sycl::queue &queue,
+                  const Distribution::Maxwellian<VALUE_TYPE> distribution,
+                  const VALUE_TYPE *d_key, VALUE_TYPE *d_ptr,
+                  const std::size_t num_samples,
+                  sycl::event event = sycl::event{},
+                  const Distribution::Strided layout =
+                      Distribution::Strided{}) {
+  using R = VALUE_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  constexpr std::size_t max_ndim = Distribution::Maxwellian<R>::max_ndim;
+  const std::size_t k_ndim = distribution.ndim;
+  const bool k_soa = distribution.layout == Distribution::Layout::SoA;
+  const bool k_kappa = distribution.kappa != R(0.0);
+  const R k_two_kappa = R(2.0) * distribution.kappa;
+  const Distribution::Gamma<R> k_chi{
+      R(0.5) * (k_two_kappa + R(2.0) - static_cast<R>(k_ndim)), R(2.0)};
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    R z[max_ndim];
+    for (std::size_t dx = 0; dx < k_ndim; dx += 2) {
+      const R r = sycl::sqrt(R(-2.0) * sycl::log(stream.next_uniform<R>()));
+      const R theta = two_pi * stream.next_uniform<R>();
+      z[dx] = r * sycl::cos(theta);
+      if (dx + 1 < k_ndim) {
+        z[dx + 1] = r * sycl::sin(theta);
+      }
+    }
+    R scaling = 1.0;
+    if (k_kappa) {
+      scaling = sycl::sqrt(k_two_kappa / sample_gamma(k_chi, stream));
+    }
+    for (std::size_t dx = 0; dx < k_ndim; dx++) {
+      const std::size_t index =
+          k_soa ? dx * num_samples + ix : ix * k_ndim + dx;
+      d_ptr[Distribution::get_strided_index(layout, index)] =
+          distribution.drift[dx] +
+          distribution.thermal_velocity[dx] * scaling * z[dx];
+    }
+  });
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename DISTRIBUTION_TYPE>
+inline std::size_t get_num_values(const DISTRIBUTION_TYPE &,
+                                  const std::size_t num_samples) {
+  return num_samples;
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename VALUE_TYPE>
+inline std::size_t
+get_num_values(const Distribution::Maxwellian<VALUE_TYPE> &distribution,
+               const std::size_t num_samples) {
+  return distribution.ndim * num_samples;
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename VALUE_TYPE>
+inline std::size_t
+get_num_values(const Distribution::UnitSphere<VALUE_TYPE> &distribution,
+               const std::size_t num_samples) {
+  return distribution.ndim * num_samples;
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename VALUE_TYPE>
+inline std::size_t
+get_num_values(const Distribution::UnitBall<VALUE_TYPE> &distribution,
+               const std::size_t num_samples) {
+  return distribution.ndim * num_samples;
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename VALUE_TYPE>
+inline std::size_t
+get_num_values(const Distribution::CellPositions<VALUE_TYPE> &distribution,
+               const std::size_t num_samples) {
+  return distribution.ndim * num_samples;
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename VALUE_TYPE>
+inline std::size_t get_num_values(
+    const Distribution::MultivariateNormal<VALUE_TYPE> &distribution,
+    const std::size_t num_samples) {
+  return distribution.ndim * num_samples;
+}
+
+/**
+ * @returns The number of values num_samples samples of a distribution occupy.
+ */
+template <typename VALUE_TYPE>
+inline std::size_t
+get_num_values(const Distribution::Wiener<VALUE_TYPE> &distribution,
+               const std::size_t num_samples) {
+  return distribution.num_steps * num_samples;
+}
+
+/**
+ * Copy contiguous values into a strided layout.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param layout Layout to write the values in.
+ * @param d_src Device pointer to num_values contiguous values.
+ * @param d_dst Device pointer to write the values to.
+ * @param num_values Number of values to copy.
+ * @returns Event for the kernel.
+ */
+template <typename VALUE_TYPE>
+inline sycl::event submit_scatter(sycl::queue &queue,
+                                  const Distribution::Strided layout,
+                                  const VALUE_TYPE *d_src, VALUE_TYPE *d_dst,
+                                  const std::size_t num_values) {
+  const std::size_t k_block_size = layout.block_size;
+  const std::size_t k_stride = layout.stride;
+  return queue.parallel_for(sycl::range<1>(num_values), [=](auto idx) {
+    const std::size_t ix = idx;
+    d_dst[(ix / k_block_size) * k_stride + ix % k_block_size] = d_src[ix];
+  });
+}
+
+} // namespace Private
+
+/**
+ * An Engine is a single RNG stream which is not bound to a distribution.
+ * Instead the distribution, and the parameters of the distribution, are
+ * passed with each request for samples. All requests advance the same stream.
+ */
+template <typename VALUE_TYPE> struct Engine {
+  virtual ~Engine() {
+    for (auto &scratch : this->scratch_allocations) {
+      sycl::free(scratch.first, this->queue);
+    }
+  }
+
+  /// The SYCL device this Engine is created on.
+  sycl::device device;
+  /// The index in the platform of the device.
+  std::size_t device_index;
+  /// The name of the platform.
+  std::string platform_name{"undefined"};
+  /// The SYCL queue on which samples are post processed.
+  sycl::queue queue;
+
+  /**
+   * Start to draw random samples from a Uniform distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(Distribution::Uniform<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) = 0;
+
+  /**
+   * Start to draw random samples from a Normal distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(Distribution::Normal<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) = 0;
+
+  /**
+   * Start to draw random samples from an Exponential distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::Exponential<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr, const std::size_t num_samples) = 0;
+
+  /**
+   * Start to draw random samples from a LogNormal distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::LogNormal<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr, const std::size_t num_samples) = 0;
+
+  /**
+   * Start to draw random samples from a Gamma distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) = 0;
+
+  /**
+   * Start to draw random samples from a Uniform distribution and write the
+   * samples in a strided layout. Platforms which create the samples with
+   * their own loops or kernels override this to write the layout directly,
+   * otherwise the samples are copied into the layout, see submit_scattered.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(Distribution::Uniform<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) {
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from a Normal distribution and write the
+   * samples in a strided layout, see the Uniform overload.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(Distribution::Normal<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) {
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from an Exponential distribution and write
+   * the samples in a strided layout, see the Uniform overload.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::Exponential<VALUE_TYPE> distribution,
+                     const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) {
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from a LogNormal distribution and write the
+   * samples in a strided layout, see the Uniform overload.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::LogNormal<VALUE_TYPE> distribution,
+                     const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) {
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from a Gamma distribution and write the
+   * samples in a strided layout, see the Uniform overload.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) {
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from a Uniform distribution where the
+   * parameters are read from device arrays. The samples are drawn and scaled
+   * by a single kernel with a Philox stream per pair of samples.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::UniformArray<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from a Uniform distribution where the
+   * parameters are read from device arrays and write the samples in a strided
+   * layout. The kernel which draws the samples writes the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::UniformArray<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_array_samples(this->queue, distribution,
+                                               d_key, d_ptr, num_samples,
+                                               event, layout);
+        });
+  }
+
+  /**
+   * Start to draw random samples from a Normal distribution where the
+   * parameters are read from device arrays. The samples are drawn with the
+   * Box-Muller transform and scaled by a single kernel with a Philox stream
+   * per pair of samples.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::NormalArray<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw random samples from a Normal distribution where the
+   * parameters are read from device arrays and write the samples in a strided
+   * layout. The kernel which draws the samples writes the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::NormalArray<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_array_samples(this->queue, distribution,
+                                               d_key, d_ptr, num_samples,
+                                               event, layout);
+        });
+  }
+
+  /**
+   * Start to draw velocity vectors from a Maxwellian or kappa distribution.
+   * The vectors are drawn, scaled and stored by a single kernel with a
+   * Philox stream per vector.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors,
+   * i.e. distribution.ndim * num_samples values.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::Maxwellian<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw velocity vectors from a Maxwellian or kappa distribution
+   * and write the values in a strided layout. The kernel which draws the
+   * vectors writes the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::Maxwellian<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    const std::size_t ndim = distribution.ndim;
+    if ((ndim < 1) || (ndim > distribution.max_ndim)) {
+      std::cout << "Maxwellian dimension " + std::to_string(ndim) +
+                       " is not supported."
+                << std::endl;
+      return -101;
+    }
+
+    // The degrees of freedom of the Chi-squared distribution for the kappa
+    // distribution need not be an integer but must be positive.
+    if (distribution.kappa != 0.0) {
+      const VALUE_TYPE dof = 2.0 * distribution.kappa + 2.0 - ndim;
+      if (!(dof > 0.0)) {
+        std::cout << "Kappa value " + std::to_string(distribution.kappa) +
+                         " is not supported for dimension " +
+                         std::to_string(ndim) + "."
+                  << std::endl;
+        return -102;
+      }
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_maxwellian(this->queue, distribution, d_key,
+                                            d_ptr, num_samples, event, layout);
+        });
+  }
+
+  /**
+   * Start to draw correlated Normal vectors. The standard Normal samples are
+   * drawn and mapped to mean + L z by a single kernel with a Philox stream
+   * per vector. Platforms with a multivariate Normal generator may override
+   * this to draw vectors with a single parameter set.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors,
+   * i.e. distribution.ndim * num_samples values.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::MultivariateNormal<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw correlated Normal vectors and write the values in a
+   * strided layout. The kernel which draws the vectors writes the layout
+   * directly. Platforms which override the contiguous overload with a vendor
+   * generator override this to copy those vectors into the layout.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  submit_get_samples(Distribution::MultivariateNormal<VALUE_TYPE> distribution,
+                     const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    if (distribution.ndim == 0) {
+      std::cout << "Multivariate Normal dimension 0 is not supported."
+                << std::endl;
+      return -101;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_multivariate_normal(
+              this->queue, distribution, d_key, d_ptr, num_samples, event,
+              layout);
+        });
+  }
+
+  /**
+   * Start to draw Wiener process paths, i.e. Brownian increments or the
+   * cumulative path over a number of steps. The Normal samples are drawn,
+   * scaled and summed by a single kernel.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples paths,
+   * i.e. distribution.num_steps * num_samples values.
+   * @param[in] num_samples Number of paths to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::Wiener<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw Wiener process paths and write the values in a strided
+   * layout. The kernel which draws the paths writes the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples paths.
+   * @param[in] num_samples Number of paths to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::Wiener<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    if (distribution.num_steps == 0) {
+      std::cout << "Wiener paths require at least one step." << std::endl;
+      return -101;
+    }
+    if (!(distribution.dt >= 0.0) || !std::isfinite(distribution.dt)) {
+      std::cout << "Invalid Wiener step length: " +
+                       std::to_string(distribution.dt)
+                << std::endl;
+      return -110;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_wiener(this->queue, distribution, d_key,
+                                        d_ptr, num_samples, event, layout);
+        });
+  }
+
+  /**
+   * Start to draw samples from a tabulated distribution, see
+   * InverseCDFTable. The samples are generated and mapped through the
+   * inverse cumulative distribution by a single kernel.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::Tabulated<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw samples from a tabulated distribution and write the
+   * samples in a strided layout. The kernel which draws the samples writes
+   * the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::Tabulated<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    if ((distribution.num_intervals == 0) || (distribution.num_guide == 0)) {
+      std::cout << "Cannot sample a tabulated distribution with no intervals."
+                << std::endl;
+      return -112;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_tabulated(this->queue, distribution, d_key,
+                                           d_ptr, num_samples, event, layout);
+        });
+  }
+
+  /**
+   * Start to draw isotropic unit vectors, i.e. directions uniformly
+   * distributed on the unit sphere. The vectors are computed directly by a
+   * single kernel without rejection.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors,
+   * i.e. distribution.ndim * num_samples values.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::UnitSphere<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_sphere(distribution, Distribution::Strided{}, d_ptr,
+                               num_samples);
+  }
+
+  /**
+   * Start to draw isotropic unit vectors and write the values in a strided
+   * layout. The kernel which draws the vectors writes the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::UnitSphere<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    return this->submit_sphere(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw vectors uniformly distributed in the unit ball. The vectors
+   * are computed directly by a single kernel without rejection.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors,
+   * i.e. distribution.ndim * num_samples values.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::UnitBall<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_sphere(distribution, Distribution::Strided{}, d_ptr,
+                               num_samples);
+  }
+
+  /**
+   * Start to draw vectors uniformly distributed in the unit ball and write
+   * the values in a strided layout. The kernel which draws the vectors writes
+   * the layout directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::UnitBall<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    return this->submit_sphere(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw positions uniformly distributed in mesh cells and the index
+   * of the cell of each position. The positions and cell indices are written
+   * by a single kernel without rejection. Wait on d_ptr for both.
+   *
+   * @param[in] distribution Cells to draw positions in.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples positions,
+   * i.e. distribution.ndim * num_samples values.
+   * @param[in, out] d_cell_ids Device pointer to fill with the cell index of
+   * each position.
+   * @param[in] num_samples Number of positions to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int submit_get_samples(Distribution::CellPositions<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, INT_TYPE *d_cell_ids,
+                         const std::size_t num_samples) {
+    return this->submit_cell_positions(distribution, Distribution::Strided{},
+                                       d_ptr, d_cell_ids, num_samples);
+  }
+
+  /**
+   * Start to draw positions uniformly distributed in mesh cells.
+   *
+   * @param[in] distribution Cells to draw positions in.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples positions,
+   * i.e. distribution.ndim * num_samples values.
+   * @param[in] num_samples Number of positions to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::CellPositions<VALUE_TYPE> distribution,
+                         VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_cell_positions(distribution, Distribution::Strided{},
+                                       d_ptr,
+                                       static_cast<std::size_t *>(nullptr),
+                                       num_samples);
+  }
+
+  /**
+   * Start to draw positions uniformly distributed in mesh cells and write the
+   * values in a strided layout. The kernel which draws the positions writes
+   * the layout directly.
+   *
+   * @param[in] distribution Cells to draw positions in.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples positions.
+   * @param[in] num_samples Number of positions to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int submit_get_samples(Distribution::CellPositions<VALUE_TYPE> distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    return this->submit_cell_positions(distribution, layout, d_ptr,
+                                       static_cast<std::size_t *>(nullptr),
+                                       num_samples);
+  }
+
+  /**
+   * Start to draw random 32 or 64-bit words.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename BITS_TYPE>
+  int submit_get_samples(Distribution::Bits<BITS_TYPE> distribution,
+                         BITS_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_discrete(distribution, Distribution::Strided{}, d_ptr,
+                                 num_samples);
+  }
+
+  /**
+   * Start to draw integer samples uniformly from [a, b].
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int submit_get_samples(Distribution::UniformInt<INT_TYPE> distribution,
+                         INT_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_discrete(distribution, Distribution::Strided{}, d_ptr,
+                                 num_samples);
+  }
+
+  /**
+   * Start to draw integer samples from a Bernoulli distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int submit_get_samples(Distribution::Bernoulli<INT_TYPE> distribution,
+                         INT_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_discrete(distribution, Distribution::Strided{}, d_ptr,
+                                 num_samples);
+  }
+
+  /**
+   * Start to draw integer samples from a weighted discrete distribution
+   * described by an alias table.
+   *
+   * @param[in] distribution Distribution to draw samples from, see
+   * AliasTable.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int submit_get_samples(Distribution::Alias<INT_TYPE> distribution,
+                         INT_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_discrete(distribution, Distribution::Strided{}, d_ptr,
+                                 num_samples);
+  }
+
+  /**
+   * Start to draw integer samples from a Poisson distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int submit_get_samples(Distribution::Poisson<INT_TYPE> distribution,
+                         INT_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_discrete(distribution, Distribution::Strided{}, d_ptr,
+                                 num_samples);
+  }
+
+  /**
+   * Start to draw integer samples from a Binomial distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int submit_get_samples(Distribution::Binomial<INT_TYPE> distribution,
+                         INT_TYPE *d_ptr, const std::size_t num_samples) {
+    return this->submit_discrete(distribution, Distribution::Strided{}, d_ptr,
+                                 num_samples);
+  }
+
+  /**
+   * Start to draw samples by rejection. The candidates are drawn, tested and
+   * compacted on the device, and the samples the first batch of candidates
+   * does not fill draw further candidates on the device, hence exactly
+   * num_samples samples are written and the host waits once. The size of the
+   * first batch is adapted to the fraction of accepted candidates observed
+   * by previous calls with the same distribution type and tag.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+  int submit_get_samples(
+      Distribution::Rejection<PROPOSAL_TYPE, ACCEPT_TYPE> distribution,
+      VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    static_assert(Private::is_rejection_proposal_v<PROPOSAL_TYPE, VALUE_TYPE>,
+                  "The proposal must be a Uniform, Normal or Exponential "
+                  "distribution of the Engine value type.");
+    int err = SUCCESS;
+    if ((err = this->check_not_in_flight(d_ptr)) != SUCCESS) {
+      return err;
+    }
+    if (!(distribution.acceptance_rate > 0.0) ||
+        (distribution.acceptance_rate > 1.0) ||
+        (distribution.max_trials == 0)) {
+      std::cout << "Rejection sampling requires an acceptance rate in (0, 1] "
+                   "and at least one trial."
+                << std::endl;
+      return -107;
+    }
+
+    const std::pair<std::type_index, std::uint64_t> type{
+        typeid(distribution), distribution.tag};
+    auto it = this->rejection_acceptance_rates.find(type);
+    const double acceptance_rate =
+        (it == this->rejection_acceptance_rates.end())
+            ? distribution.acceptance_rate
+            : it->second;
+    const std::size_t num_candidates =
+        Private::get_num_rejection_candidates(num_samples, acceptance_rate);
+    const std::size_t num_chunks =
+        Private::get_num_rejection_chunks(num_candidates);
+
+    VALUE_TYPE *d_candidates = nullptr;
+    std::uint64_t *d_counts = nullptr;
+    if (num_samples > 0) {
+      d_candidates = this->get_scratch(num_candidates);
+      d_counts = sycl::malloc_device<std::uint64_t>(
+          Private::get_num_rejection_counts(num_candidates), this->queue);
+      if ((d_candidates == nullptr) || (d_counts == nullptr)) {
+        this->release_scratch(d_candidates);
+        if (d_counts != nullptr) {
+          sycl::free(d_counts, this->queue);
+        }
+        return -103;
+      }
+    }
+
+    // The number of accepted candidates in the first batch and the number of
+    // samples which exceeded max_trials are copied to the host with the
+    // samples.
+    auto counts = std::make_shared<std::vector<std::uint64_t>>(2, 0);
+    if ((err = this->submit_philox(
+             d_ptr, num_samples,
+             [=](const VALUE_TYPE *d_key, sycl::event event) {
+               event = Private::submit_rejection<VALUE_TYPE>(
+                   this->queue, distribution, d_key, d_candidates, d_counts,
+                   d_ptr, num_samples, num_candidates, event);
+               return this->queue.memcpy(counts->data(), d_counts + num_chunks,
+                                         2 * sizeof(std::uint64_t), event);
+             })) != SUCCESS) {
+      this->release_scratch(d_candidates);
+      if (d_counts != nullptr) {
+        sycl::free(d_counts, this->queue);
+      }
+      return err;
+    }
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+
+    // Update the estimate of the acceptance rate and detect samples which
+    // were not accepted once the samples are complete.
+    auto philox_post_process = std::move(this->map_ptr_post_process.at(d_ptr));
+    this->map_ptr_post_process[d_ptr] = [=]() -> int {
+      int err_wait = philox_post_process();
+      if (err_wait == SUCCESS) {
+        this->rejection_acceptance_rates[type] =
+            static_cast<double>(std::max(counts->at(0), std::uint64_t{1})) /
+            static_cast<double>(num_candidates);
+        if (counts->at(1) > 0) {
+          std::cout << std::to_string(counts->at(1)) +
+                           " samples exceeded the maximum number of "
+                           "rejection trials."
+                    << std::endl;
+          err_wait = -108;
+        }
+      }
+      this->release_scratch(d_candidates);
+      sycl::free(d_counts, this->queue);
+      return err_wait;
+    };
+    return SUCCESS;
+  }
+
+  /**
+   * Start to draw a uniformly random permutation of the indices within each
+   * segment. The random keys are drawn from Philox streams keyed by this
+   * Engine and sorted within each segment on the device. The number of
+   * sorting kernels is set by distribution.max_segment_size and the host does
+   * not wait on the device.
+   *
+   * @param[in] distribution Segments to permute.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples indices.
+   * @param[in] num_samples Total number of indices, i.e.
+   * distribution.d_offsets[distribution.num_segments].
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int
+  submit_get_samples(Distribution::SegmentedPermutation<INT_TYPE> distribution,
+                     INT_TYPE *d_ptr, const std::size_t num_samples) {
+    static_assert(std::is_integral_v<INT_TYPE>,
+                  "Permutations require an integer sample type.");
+    int err = SUCCESS;
+    if ((err = this->check_not_in_flight(d_ptr)) != SUCCESS) {
+      return err;
+    }
+    if ((num_samples > 0) && ((distribution.d_offsets == nullptr) ||
+                              (distribution.num_segments == 0))) {
+      std::cout << "Permutations require at least one segment." << std::endl;
+      return -109;
+    }
+
+    std::uint64_t *d_keys = nullptr;
+    std::size_t *d_segments = nullptr;
+    auto free_workspace = [=]() {
+      if (d_keys != nullptr) {
+        sycl::free(d_keys, this->queue);
+      }
+      if (d_segments != nullptr) {
+        sycl::free(d_segments, this->queue);
+      }
+    };
+    if (num_samples > 0) {
+      d_keys = sycl::malloc_device<std::uint64_t>(num_samples, this->queue);
+      d_segments = sycl::malloc_device<std::size_t>(num_samples, this->queue);
+      if ((d_keys == nullptr) || (d_segments == nullptr)) {
+        free_workspace();
+        return -103;
+      }
+    }
+
+    if ((err = this->submit_philox(
+             d_ptr, num_samples,
+             [=](const VALUE_TYPE *d_key, sycl::event event) {
+               return Private::submit_segmented_permutation(
+                   this->queue, distribution, d_key, d_keys, d_segments,
+                   d_ptr, num_samples, event);
+             })) != SUCCESS) {
+      free_workspace();
+      return err;
+    }
+
+    auto philox_post_process = std::move(this->map_ptr_post_process.at(d_ptr));
+    this->map_ptr_post_process[d_ptr] = [=]() -> int {
+      const int err_wait = philox_post_process();
+      free_workspace();
+      return err_wait;
+    };
+    return SUCCESS;
+  }
+
+  /**
+   * Start to draw random samples from a distribution and write the samples in
+   * a strided layout. The distributions which are sampled by the kernels of
+   * this library have overloads which write the layout directly, the
+   * remaining distributions are copied into the layout, see
+   * submit_scattered.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  int submit_get_samples(DISTRIBUTION_TYPE distribution,
+                         const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                         const std::size_t num_samples) {
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Start to draw integer samples from a discrete distribution, i.e. Bits,
+   * UniformInt, Bernoulli, Alias, Poisson or Binomial, and write the samples
+   * in a strided layout. The kernel which draws the samples writes the layout
+   * directly.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE, typename INT_TYPE>
+  std::enable_if_t<std::is_integral_v<INT_TYPE>, int>
+  submit_get_samples(DISTRIBUTION_TYPE distribution,
+                     const Distribution::Strided layout, INT_TYPE *d_ptr,
+                     const std::size_t num_samples) {
+    return this->submit_discrete(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Wait for the random samples to be computed.
+   *
+   * @param[in, out] d_ptr Device pointer to which is currently being populated
+   * with samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int wait_get_samples(VALUE_TYPE *d_ptr) {
+    auto it = this->map_ptr_post_process.find(d_ptr);
+    if (it == this->map_ptr_post_process.end()) {
+      return this->wait_get_samples_internal(d_ptr);
+    } else {
+      return this->run_post_process(it);
+    }
+  }
+
+  /**
+   * Wait for integer random samples to be computed.
+   *
+   * @param[in, out] d_ptr Device pointer to which is currently being populated
+   * with samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE> int wait_get_samples(INT_TYPE *d_ptr) {
+    auto it = this->map_ptr_post_process.find(d_ptr);
+    if (it == this->map_ptr_post_process.end()) {
+      std::cout << "No samples are being drawn into the passed pointer."
+                << std::endl;
+      return -105;
+    } else {
+      return this->run_post_process(it);
+    }
+  }
+
+  /**
+   * Draw random samples from a distribution. Internally this function calls
+   * submit_get_samples and wait_get_samples.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE, typename SAMPLE_TYPE>
+  int get_samples(DISTRIBUTION_TYPE distribution, SAMPLE_TYPE *d_ptr,
+                  const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->submit_get_samples(distribution, d_ptr, num_samples)) !=
+        SUCCESS) {
+      return err;
+    }
+    return this->wait_get_samples(d_ptr);
+  }
+
+  /**
+   * Draw positions uniformly distributed in mesh cells and the index of the
+   * cell of each position. Internally this function calls submit_get_samples
+   * and wait_get_samples.
+   *
+   * @param[in] distribution Cells to draw positions in.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples positions.
+   * @param[in, out] d_cell_ids Device pointer to fill with the cell index of
+   * each position.
+   * @param[in] num_samples Number of positions to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  int get_samples(Distribution::CellPositions<VALUE_TYPE> distribution,
+                  VALUE_TYPE *d_ptr, INT_TYPE *d_cell_ids,
+                  const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->submit_get_samples(distribution, d_ptr, d_cell_ids,
+                                        num_samples)) != SUCCESS) {
+      return err;
+    }
+    return this->wait_get_samples(d_ptr);
+  }
+
+  /**
+   * Draw random samples from a distribution and write the samples in a
+   * strided layout. Internally this function calls submit_get_samples and
+   * wait_get_samples.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE, typename SAMPLE_TYPE>
+  int get_samples(DISTRIBUTION_TYPE distribution,
+                  const Distribution::Strided layout, SAMPLE_TYPE *d_ptr,
+                  const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->submit_get_samples(distribution, layout, d_ptr,
+                                        num_samples)) != SUCCESS) {
+      return err;
+    }
+    return this->wait_get_samples(d_ptr);
+  }
+
+  /**
+   * Save the state of the Engine to a compact binary blob. An Engine created
+   * with the same arguments which loads the blob continues the stream of this
+   * Engine exactly, including the keys of the distributions which are drawn
+   * by Philox kernels. Samples which are being drawn should be waited for
+   * before the state is saved.
+   *
+   * @param[out] state Blob the state is written to.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int save_state([[maybe_unused]] std::vector<std::uint8_t> &state) {
+    std::cout << "The " + this->platform_name +
+                     " Engine does not support saving its state."
+              << std::endl;
+    return -6;
+  }
+
+  /**
+   * Load a state saved by save_state of an Engine created with the same
+   * arguments.
+   *
+   * @param[in] state Blob the state is read from.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  load_state([[maybe_unused]] const std::vector<std::uint8_t> &state) {
+    std::cout << "The " + this->platform_name +
+                     " Engine does not support loading its state."
+              << std::endl;
+    return -6;
+  }
+
+protected:
+  /// Work to complete, per pointer, in place of waiting on the platform.
+  std::map<void *, std::function<int()>> map_ptr_post_process;
+  /// Device scratch allocations owned by the Engine and their sizes.
+  std::map<VALUE_TYPE *, std::size_t> scratch_allocations;
+  /// Device scratch allocations which are not in use.
+  std::vector<VALUE_TYPE *> scratch_free;
+  /// Fraction of accepted candidates observed for each Rejection type and
+  /// tag.
+  std::map<std::pair<std::type_index, std::uint64_t>, double>
+      rejection_acceptance_rates;
+
+  /**
+   * Get device scratch space from the allocations which are not in use, or
+   * allocate new scratch space if none are large enough.
+   *
+   * @param num_values Required number of values.
+   * @returns Device pointer to scratch space. nullptr on Error.
+   */
+  inline VALUE_TYPE *get_scratch(const std::size_t num_values) {
+    for (auto it = this->scratch_free.begin(); it != this->scratch_free.end();
+         it++) {
+      VALUE_TYPE *d_scratch = *it;
+      if (this->scratch_allocations.at(d_scratch) >= num_values) {
+        this->scratch_free.erase(it);
+        return d_scratch;
+      }
+    }
+    VALUE_TYPE *d_scratch =
+        sycl::malloc_device<VALUE_TYPE>(num_values, this->queue);
+    if (d_scratch != nullptr) {
+      this->scratch_allocations[d_scratch] = num_values;
+    }
+    return d_scratch;
+  }
+
+  /**
+   * Return scratch space from get_scratch such that it may be reused.
+   *
+   * @param d_scratch Device pointer from get_scratch or nullptr.
+   */
+  inline void release_scratch(VALUE_TYPE *d_scratch) {
+    if (d_scratch != nullptr) {
+      this->scratch_free.push_back(d_scratch);
+    }
+  }
+
+  /**
+   * Check that samples are not already being drawn into a pointer, i.e. that
+   * the pointer has no post process which is not yet waited on.
+   *
+   * @param d_ptr Device pointer samples are about to be drawn into.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int check_not_in_flight(void *d_ptr) {
+    if (this->map_ptr_post_process.count(d_ptr) > 0) {
+      std::cout << "Samples are already being drawn into the passed pointer."
+                << std::endl;
+      return -111;
+    }
+    return SUCCESS;
+  }
+
+  /**
+   * Remove a post process from map_ptr_post_process and run it.
+   *
+   * @param it Iterator to the post process in map_ptr_post_process.
+   * @returns Error code from the post process.
+   */
+  inline int
+  run_post_process(typename decltype(map_ptr_post_process)::iterator it) {
+    auto post_process = std::move(it->second);
+    this->map_ptr_post_process.erase(it);
+    return post_process();
+  }
+
+  /**
+   * Start to draw samples from a discrete distribution. The samples are
+   * computed on the device by a kernel which uses a Philox stream per sample.
+   * The key for the Philox streams is drawn from this Engine, hence the
+   * samples are reproducible for a given seed and advance the stream of this
+   * Engine.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE, typename INT_TYPE>
+  inline int submit_discrete(DISTRIBUTION_TYPE distribution,
+                             const Distribution::Strided layout,
+                             INT_TYPE *d_ptr, const std::size_t num_samples) {
+    static_assert(std::is_integral_v<INT_TYPE>,
+                  "Discrete distributions require an integer sample type.");
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    if constexpr (std::is_same_v<DISTRIBUTION_TYPE,
+                                 Distribution::Alias<INT_TYPE>>) {
+      if (distribution.num_categories == 0) {
+        std::cout << "Cannot sample an alias table with no categories."
+                  << std::endl;
+        return -106;
+      }
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_discrete<VALUE_TYPE>(this->queue, distribution,
+                                                      d_key, d_ptr, num_samples,
+                                                      event, layout);
+        });
+  }
+
+  /**
+   * Check that a strided layout is valid, i.e. the blocks are not empty and
+   * do not overlap.
+   *
+   * @param[in] layout Layout to check.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int check_layout(const Distribution::Strided layout) {
+    if ((layout.block_size == 0) || (layout.stride < layout.block_size)) {
+      std::cout << "Strided layout with block size " +
+                       std::to_string(layout.block_size) + " and stride " +
+                       std::to_string(layout.stride) + " is not valid."
+                << std::endl;
+      return -104;
+    }
+    return SUCCESS;
+  }
+
+  /**
+   * Start to draw random samples from a distribution which the platform
+   * samples with an opaque vendor generator and write the samples in a
+   * strided layout. A vendor generator only writes contiguous values, hence
+   * the samples are drawn into scratch space owned by the Engine and copied
+   * into the layout by a second kernel once they are computed. The
+   * distributions which are sampled by the kernels of this library write the
+   * layout directly and do not use this path.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  inline int submit_scattered(DISTRIBUTION_TYPE distribution,
+                              const Distribution::Strided layout,
+                              VALUE_TYPE *d_ptr,
+                              const std::size_t num_samples) {
+    int err = SUCCESS;
+    if (((err = this->check_not_in_flight(d_ptr)) != SUCCESS) ||
+        ((err = this->check_layout(layout)) != SUCCESS)) {
+      return err;
+    }
+    if (layout.block_size == layout.stride) {
+      return this->submit_get_samples(distribution, d_ptr, num_samples);
+    }
+
+    const std::size_t num_values =
+        Private::get_num_values(distribution, num_samples);
+    VALUE_TYPE *d_scratch = nullptr;
+    if (num_values > 0) {
+      if ((d_scratch = this->get_scratch(num_values)) == nullptr) {
+        return -103;
+      }
+    }
+
+    if ((err = this->submit_get_samples(distribution, d_scratch,
+                                        num_samples)) != SUCCESS) {
+      this->release_scratch(d_scratch);
+      return err;
+    }
+
+    this->map_ptr_post_process[d_ptr] = [=]() -> int {
+      const int err_wait = this->wait_get_samples(d_scratch);
+      if ((err_wait == SUCCESS) && (num_values > 0)) {
+        Private::submit_scatter(this->queue, layout, d_scratch, d_ptr,
+                                num_values)
+            .wait_and_throw();
+      }
+      this->release_scratch(d_scratch);
+      return err_wait;
+    };
+    return SUCCESS;
+  }
+
+  /**
+   * Start to draw vectors on the unit sphere or in the unit ball.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples vectors.
+   * @param[in] num_samples Number of vectors to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  inline int submit_sphere(DISTRIBUTION_TYPE distribution,
+                           const Distribution::Strided layout,
+                           VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    const std::size_t ndim = distribution.ndim;
+    if ((ndim < 1) || (ndim > distribution.max_ndim)) {
+      std::cout << "Sphere dimension " + std::to_string(ndim) +
+                       " is not supported."
+                << std::endl;
+      return -101;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_sphere<VALUE_TYPE>(this->queue, distribution,
+                                                    d_key, d_ptr, num_samples,
+                                                    event, layout);
+        });
+  }
+
+  /**
+   * Start to draw positions uniformly distributed in mesh cells and the index
+   * of the cell of each position. The cell indices are written contiguously.
+   *
+   * @param[in] distribution Cells to draw positions in.
+   * @param[in] layout Describes where in d_ptr the position values are
+   * written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples positions.
+   * @param[in, out] d_cell_ids Device pointer to fill with the cell index of
+   * each position or nullptr.
+   * @param[in] num_samples Number of positions to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename INT_TYPE>
+  inline int
+  submit_cell_positions(Distribution::CellPositions<VALUE_TYPE> distribution,
+                        const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                        INT_TYPE *d_cell_ids, const std::size_t num_samples) {
+    static_assert(std::is_integral_v<INT_TYPE>,
+                  "Cell indices require an integer type.");
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    if (!Private::is_valid_cell_dimension(distribution.shape,
+                                          distribution.ndim)) {
+      std::cout << "Cell dimension " + std::to_string(distribution.ndim) +
+                       " is not supported for the cell shape."
+                << std::endl;
+      return -101;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_cell_positions(this->queue, distribution,
+                                                d_key, d_ptr, d_cell_ids,
+                                                num_samples, event, layout);
+        });
+  }
+
+  /**
+   * Start to draw samples from a Gamma distribution with a kernel which uses
+   * a Philox stream per sample. For platforms which do not provide a Gamma
+   * distribution.
+   *
+   * @param[in] distribution Distribution to draw samples from.
+   * @param[in] layout Describes where in d_ptr the sample values are written.
+   * @param[in, out] d_ptr Device pointer to fill with num_samples samples.
+   * @param[in] num_samples Number of samples to place in device buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int submit_philox_gamma(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) {
+    int err = SUCCESS;
+    if ((err = this->check_layout(layout)) != SUCCESS) {
+      return err;
+    }
+    return this->submit_philox(
+        d_ptr, num_samples, [=](const VALUE_TYPE *d_key, sycl::event event) {
+          return Private::submit_gamma<VALUE_TYPE>(this->queue, distribution,
+                                                   d_key, d_ptr, num_samples,
+                                                   event, layout);
+        });
+  }
+
+  /**
+   * Start to draw samples with a kernel which uses a Philox stream per
+   * sample. The key for the Philox streams is drawn from this Engine, hence
+   * the samples are reproducible for a given seed and advance the stream of
+   * this Engine. The kernel is submitted immediately, dependent on the
+   * samples which form the key, and waiting on d_ptr waits for the kernel.
+   *
+   * @param[in, out] d_ptr Device pointer the kernel fills with samples.
+   * @param[in] num_samples Number of samples, the kernel is not submitted if
+   * this is zero.
+   * @param[in] submit_kernel Callable which is passed a device pointer to the
+   * four key values and the event for the key values, submits the kernel and
+   * returns the event for the kernel.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename SUBMIT_TYPE>
+  inline int submit_philox(void *d_ptr, const std::size_t num_samples,
+                           SUBMIT_TYPE submit_kernel) {
+    int err = SUCCESS;
+    if ((err = this->check_not_in_flight(d_ptr)) != SUCCESS) {
+      return err;
+    }
+    constexpr std::size_t num_key_values = 4;
+    VALUE_TYPE *d_key = this->get_scratch(num_key_values);
+    if (d_key == nullptr) {
+      return -103;
+    }
+    sycl::event event{};
+    if (((err = this->submit_get_samples(
+              Distribution::Uniform<VALUE_TYPE>{0.0, 1.0}, d_key,
+              num_key_values)) != SUCCESS) ||
+        ((err = this->get_samples_event(d_key, event)) != SUCCESS)) {
+      this->release_scratch(d_key);
+      return err;
+    }
+    if (num_samples > 0) {
+      event = submit_kernel(d_key, event);
+    }
+
+    this->map_ptr_post_process[d_ptr] = [=]() mutable -> int {
+      event.wait_and_throw();
+      this->release_scratch(d_key);
+      return SUCCESS;
+    };
+    return SUCCESS;
+  }
+
+  /**
+   * Wait for the samples drawn by the platform to be computed. This is
+   * implemented by each platform and is called by wait_get_samples, or by the
+   * post processing registered for the pointer.
+   *
+   * @param[in, out] d_ptr Device pointer to which is currently being populated
+   * with samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int wait_get_samples_internal(VALUE_TYPE *d_ptr) = 0;
+
+  /**
+   * Get an event which completes when the samples drawn by the platform into
+   * a pointer are computed, such that kernels which read the samples can be
+   * submitted without the host waiting. Platforms which do not compute the
+   * samples in SYCL kernels wait for the samples and return an empty event.
+   *
+   * @param[in, out] d_ptr Device pointer to which is currently being populated
+   * with samples.
+   * @param[out] event Event which completes when the samples are computed.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int get_samples_event(VALUE_TYPE *d_ptr, sycl::event &event) {
+    event = sycl::event{};
+    return this->wait_get_samples_internal(d_ptr);
+  }
+};
+
+template <typename VALUE_TYPE>
+using EngineSharedPtr = std::shared_ptr<Engine<VALUE_TYPE>>;
+
+} // namespace NESO::RNGToolkit
+
+#endif
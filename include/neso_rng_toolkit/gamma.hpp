@@ -0,0 +1,92 @@
+#ifndef _NESO_RNG_TOOLKIT_GAMMA_HPP_
+#define _NESO_RNG_TOOLKIT_GAMMA_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Sample the Gamma distribution with the method of Marsaglia and Tsang,
+ * "A simple method for generating gamma variables" (2000). A shape alpha < 1
+ * is sampled as Gamma(alpha + 1) * U^(1 / alpha). Callable from device code.
+ *
+ * @param distribution Distribution to sample.
+ * @param stream Source of random bits.
+ * @returns Sample from the distribution.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE
+sample_gamma(const Distribution::Gamma<REAL_TYPE> &distribution,
+             PhiloxStream &stream) {
+  using R = REAL_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  const bool boost = distribution.alpha < R(1.0);
+  const R alpha = boost ? distribution.alpha + R(1.0) : distribution.alpha;
+  const R d = alpha - R(1.0) / R(3.0);
+  const R c = R(1.0) / sycl::sqrt(R(9.0) * d);
+
+  R sample = R(0.0);
+  while (true) {
+    R x = R(0.0);
+    R v = R(0.0);
+    do {
+      x = sycl::sqrt(R(-2.0) * sycl::log(stream.next_uniform<R>())) *
+          sycl::cos(two_pi * stream.next_uniform<R>());
+      v = R(1.0) + c * x;
+    } while (v <= R(0.0));
+    v = v * v * v;
+    const R u = stream.next_uniform<R>();
+    const R x2 = x * x;
+    if ((u < R(1.0) - R(0.0331) * x2 * x2) ||
+        (sycl::log(u) < R(0.5) * x2 + d * (R(1.0) - v + sycl::log(v)))) {
+      sample = d * v;
+      break;
+    }
+  }
+  if (boost) {
+    sample *= sycl::pow(stream.next_uniform<R>(), R(1.0) / distribution.alpha);
+  }
+  return distribution.beta * sample;
+}
+
+/**
+ * Submit a kernel which samples the Gamma distribution with a Philox stream
+ * per sample.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Distribution to sample.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to fill with num_samples samples.
+ * @param num_samples Number of samples.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename REAL_TYPE>
+inline sycl::event
+submit_gamma(sycl::queue &queue,
+             const Distribution::Gamma<REAL_TYPE> distribution,
+             const REAL_TYPE *d_key, REAL_TYPE *d_ptr,
+             const std::size_t num_samples,
+             sycl::event event = sycl::event{},
+             const Distribution::Strided layout = Distribution::Strided{}) {
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    d_ptr[Distribution::get_strided_index(layout, ix)] =
+        sample_gamma(distribution, stream);
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
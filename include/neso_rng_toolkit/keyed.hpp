@@ -0,0 +1,156 @@
+#ifndef _NESO_RNG_TOOLKIT_KEYED_HPP_
+#define _NESO_RNG_TOOLKIT_KEYED_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "rejection.hpp"
+#include "sobol.hpp"
+#include "typedefs.hpp"
+#include <map>
+
+namespace NESO::RNGToolkit {
+
+/**
+ * Draws samples which are a pure function of a seed, a 64-bit key, e.g. a
+ * global particle id, a step counter and the index of the sample for the
+ * key. The samples of a key are therefore identical however keys are
+ * distributed between MPI ranks or ordered on a rank, and there is no state
+ * to migrate with the keys. The samples of key and step are the Philox4x32-10
+ * output for the counters (i, step_lo, key_lo, key_hi) for i = 0, 1, 2, ...
+ * The Philox key is hash(seed ^ hash(step_hi)) with the SplitMix64 finaliser
+ * as hash, hence the upper 32 bits of the step select an unrelated key and
+ * neighbouring seeds do not share streams.
+ *
+ *    KeyedSampler<double> sampler(queue, seed);
+ *    sampler.get_samples(Distribution::Normal<double>{0.0, 1.0}, d_ids,
+ *                        num_ids, step, num_per_key, d_ptr);
+ */
+template <typename VALUE_TYPE> struct KeyedSampler {
+  /// Queue on which samples are drawn.
+  sycl::queue queue;
+  /// The seed shared by all keys.
+  std::uint64_t seed;
+
+  /**
+   * Create a sampler.
+   *
+   * @param queue SYCL queue on which samples are drawn.
+   * @param seed Value to seed the samples of every key with.
+   */
+  KeyedSampler(sycl::queue queue, const std::uint64_t seed)
+      : queue(queue), seed(seed) {}
+
+  /**
+   * Create the stream of random values of a key and step. Callable from
+   * device code, e.g. to draw keyed samples inside a particle loop.
+   *
+   * @param seed Seed of the sampler.
+   * @param key Key to draw values for.
+   * @param step Step to draw values for.
+   * @returns Stream of the values of the key and step.
+   */
+  static inline Private::PhiloxStream
+  get_stream(const std::uint64_t seed, const std::uint64_t key,
+             const std::uint64_t step) {
+    const std::uint64_t philox_key =
+        Private::sobol_hash(seed ^ Private::sobol_hash(step >> 32));
+    Private::PhiloxStream stream(static_cast<std::uint32_t>(philox_key),
+                                 static_cast<std::uint32_t>(philox_key >> 32),
+                                 key);
+    stream.set_block(step << 32);
+    return stream;
+  }
+
+  /**
+   * Submit a kernel which draws samples for a number of keys. Sample j of key
+   * i is written to d_ptr[i * num_per_key + j] for the AoS layout and to
+   * d_ptr[j * num_keys + i] for the SoA layout.
+   *
+   * @param distribution Uniform, Normal or Exponential distribution to sample.
+   * @param d_keys Device pointer to num_keys keys. If nullptr the keys are
+   * 0, 1, ..., num_keys - 1.
+   * @param num_keys Number of keys to draw samples for.
+   * @param step Step to draw samples for.
+   * @param num_per_key Number of samples to draw for each key.
+   * @param d_ptr Device pointer to num_keys * num_per_key values.
+   * @param layout Order of the samples in d_ptr.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  int submit_get_samples(
+      const DISTRIBUTION_TYPE distribution, const std::uint64_t *d_keys,
+      const std::size_t num_keys, const std::uint64_t step,
+      const std::size_t num_per_key, VALUE_TYPE *d_ptr,
+      const Distribution::Layout layout = Distribution::Layout::AoS) {
+    static_assert(
+        Private::is_rejection_proposal_v<DISTRIBUTION_TYPE, VALUE_TYPE>,
+        "Keyed samplers sample Uniform, Normal or Exponential "
+        "distributions of VALUE_TYPE.");
+    sycl::event event{};
+    if ((num_keys > 0) && (num_per_key > 0)) {
+      const std::uint64_t k_seed = this->seed;
+      const bool soa = layout == Distribution::Layout::SoA;
+      event = this->queue.parallel_for(
+          sycl::range<1>(num_keys), [=](auto idx) {
+            const std::size_t ix = idx;
+            const std::uint64_t key = (d_keys == nullptr) ? ix : d_keys[ix];
+            auto stream = get_stream(k_seed, key, step);
+            for (std::size_t jx = 0; jx < num_per_key; jx++) {
+              const std::size_t index =
+                  soa ? jx * num_keys + ix : ix * num_per_key + jx;
+              d_ptr[index] = Private::sample_proposal(distribution, stream);
+            }
+          });
+    }
+    this->map_ptr_event[d_ptr] = event;
+    return SUCCESS;
+  }
+
+  /**
+   * Wait for the samples drawn into a pointer.
+   *
+   * @param d_ptr Device pointer passed to submit_get_samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int wait_get_samples(VALUE_TYPE *d_ptr) {
+    auto it = this->map_ptr_event.find(d_ptr);
+    if (it == this->map_ptr_event.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    it->second.wait_and_throw();
+    this->map_ptr_event.erase(it);
+    return SUCCESS;
+  }
+
+  /**
+   * Draw samples for a number of keys and wait for the samples, see
+   * submit_get_samples.
+   *
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  int get_samples(const DISTRIBUTION_TYPE distribution,
+                  const std::uint64_t *d_keys, const std::size_t num_keys,
+                  const std::uint64_t step, const std::size_t num_per_key,
+                  VALUE_TYPE *d_ptr,
+                  const Distribution::Layout layout =
+                      Distribution::Layout::AoS) {
+    int err = SUCCESS;
+    if ((err = this->submit_get_samples(distribution, d_keys, num_keys, step,
+                                        num_per_key, d_ptr, layout)) !=
+        SUCCESS) {
+      return err;
+    }
+    return this->wait_get_samples(d_ptr);
+  }
+
+protected:
+  /// The events of the kernels which write to the pointers.
+  std::map<VALUE_TYPE *, sycl::event> map_ptr_event;
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef _NESO_RNG_TOOLKIT_MULTIVARIATE_HPP_
+#define _NESO_RNG_TOOLKIT_MULTIVARIATE_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+#include <limits>
+
+namespace NESO::RNGToolkit {
+
+/**
+ * Compute the lower triangular Cholesky factors L of symmetric positive
+ * semi-definite covariance matrices C = L L^T on the device, e.g. one matrix
+ * per cell. Each matrix is factored by its own work item. Matrix j has entries
+ * C_rc = d_covariance[j * ndim * ndim + r * ndim + c] and the factor is
+ * written in the same layout with zeros above the diagonal, the factor of a
+ * semi-definite matrix has zero columns for the degenerate directions.
+ *
+ * @param queue SYCL queue to compute the factors on.
+ * @param d_covariance Device pointer to num_matrices covariance matrices.
+ * @param d_factor Device pointer to write num_matrices factors to.
+ * @param ndim Dimension of the matrices.
+ * @param num_matrices Number of matrices.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename VALUE_TYPE>
+inline int cholesky_factor(sycl::queue &queue, const VALUE_TYPE *d_covariance,
+                           VALUE_TYPE *d_factor, const std::size_t ndim,
+                           const std::size_t num_matrices) {
+  if (ndim == 0) {
+    std::cout << "Cannot factor matrices of dimension 0." << std::endl;
+    return -1;
+  }
+  if (num_matrices == 0) {
+    return SUCCESS;
+  }
+  int *d_num_failed = sycl::malloc_device<int>(1, queue);
+  if (d_num_failed == nullptr) {
+    std::cout << "Failed to allocate device memory." << std::endl;
+    return -2;
+  }
+  queue.fill(d_num_failed, 0, 1).wait_and_throw();
+
+  // A pivot which is negative by more than rounding indicates that the matrix
+  // is not positive semi-definite.
+  constexpr VALUE_TYPE tolerance =
+      VALUE_TYPE(16.0) * std::numeric_limits<VALUE_TYPE>::epsilon();
+  queue
+      .parallel_for(
+          sycl::range<1>(num_matrices),
+          [=](auto idx) {
+            const std::size_t offset = idx * ndim * ndim;
+            const VALUE_TYPE *C = d_covariance + offset;
+            VALUE_TYPE *L = d_factor + offset;
+            bool valid = true;
+            for (std::size_t cx = 0; cx < ndim; cx++) {
+              VALUE_TYPE pivot = C[cx * ndim + cx];
+              for (std::size_t kx = 0; kx < cx; kx++) {
+                pivot -= L[cx * ndim + kx] * L[cx * ndim + kx];
+              }
+              valid = valid && (pivot >= -tolerance * C[cx * ndim + cx]);
+              const VALUE_TYPE diagonal =
+                  sycl::sqrt(sycl::fmax(pivot, VALUE_TYPE(0.0)));
+              L[cx * ndim + cx] = diagonal;
+              for (std::size_t rx = cx + 1; rx < ndim; rx++) {
+                VALUE_TYPE value = C[rx * ndim + cx];
+                for (std::size_t kx = 0; kx < cx; kx++) {
+                  value -= L[rx * ndim + kx] * L[cx * ndim + kx];
+                }
+                L[rx * ndim + cx] = (diagonal > VALUE_TYPE(0.0))
+                                        ? value / diagonal
+                                        : VALUE_TYPE(0.0);
+                L[cx * ndim + rx] = VALUE_TYPE(0.0);
+              }
+            }
+            if (!valid) {
+              sycl::atomic_ref<int, sycl::memory_order::relaxed,
+                               sycl::memory_scope::device,
+                               sycl::access::address_space::global_space>
+                  num_failed(*d_num_failed);
+              num_failed.fetch_add(1);
+            }
+          })
+      .wait_and_throw();
+
+  int num_failed = 0;
+  queue.memcpy(&num_failed, d_num_failed, sizeof(int)).wait_and_throw();
+  sycl::free(d_num_failed, queue);
+  if (num_failed > 0) {
+    std::cout << std::to_string(num_failed) +
+                     " covariance matrices are not positive semi-definite."
+              << std::endl;
+    return -3;
+  }
+  return SUCCESS;
+}
+
+namespace Private {
+
+/**
+ * Submit a kernel which samples correlated Normal vectors, i.e.
+ * x = mean + L z for a vector z of standard Normal samples. Each vector uses
+ * its own Philox stream and the components of z are drawn in pairs with the
+ * Box-Muller transform by the same kernel which applies L. The components of
+ * z are held in the output vector of the work item and the rows are computed
+ * from the last to the first such that row r only reads components which are
+ * not yet overwritten.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Distribution to sample.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to write ndim * num_samples values to.
+ * @param num_samples Number of vectors.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename VALUE_TYPE>
+inline sycl::event submit_multivariate_normal(
+    sycl::queue &queue,
+    const Distribution::MultivariateNormal<VALUE_TYPE> distribution,
+    const VALUE_TYPE *d_key, VALUE_TYPE *d_ptr, const std::size_t num_samples,
+    sycl::event event = sycl::event{},
+    const Distribution::Strided layout = Distribution::Strided{}) {
+  using R = VALUE_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  const std::size_t k_ndim = distribution.ndim;
+  const bool k_soa = distribution.layout == Distribution::Layout::SoA;
+  const R *k_mean = distribution.d_mean;
+  const R *k_factor = distribution.d_factor;
+  const std::size_t *k_offsets = distribution.d_offsets;
+  const std::size_t k_num_segments = distribution.num_segments;
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    const std::size_t px =
+        ((k_offsets == nullptr) && (k_num_segments == 1))
+            ? 0
+            : Distribution::get_parameter_index(k_offsets, k_num_segments, ix);
+    const R *mean = k_mean + px * k_ndim;
+    const R *L = k_factor + px * k_ndim * k_ndim;
+    auto get_index = [=](const std::size_t dx) {
+      return Distribution::get_strided_index(
+          layout, k_soa ? dx * num_samples + ix : ix * k_ndim + dx);
+    };
+
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    for (std::size_t dx = 0; dx < k_ndim; dx += 2) {
+      const R r = sycl::sqrt(R(-2.0) * sycl::log(stream.next_uniform<R>()));
+      const R theta = two_pi * stream.next_uniform<R>();
+      d_ptr[get_index(dx)] = r * sycl::cos(theta);
+      if (dx + 1 < k_ndim) {
+        d_ptr[get_index(dx + 1)] = r * sycl::sin(theta);
+      }
+    }
+    for (std::size_t rx = k_ndim; rx-- > 0;) {
+      R value = mean[rx];
+      for (std::size_t cx = 0; cx <= rx; cx++) {
+        value += L[rx * k_ndim + cx] * d_ptr[get_index(cx)];
+      }
+      d_ptr[get_index(rx)] = value;
+    }
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
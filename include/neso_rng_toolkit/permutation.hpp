@@ -0,0 +1,130 @@
+#ifndef _NESO_RNG_TOOLKIT_PERMUTATION_HPP_
+#define _NESO_RNG_TOOLKIT_PERMUTATION_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Submit one compare-exchange step of a bitonic sorting network which is
+ * applied to every segment independently. Element l of a segment is compared
+ * with element l ^ mask. A segment of length n is sorted as if it were padded
+ * to a power of two with values larger than every key, hence partners beyond
+ * the end of the segment are not exchanged. The elements are ordered by the
+ * random key and then by the index, i.e. a strict total order.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param d_offsets Device pointer to the segment offsets.
+ * @param d_segments Device pointer to the segment of each element.
+ * @param d_keys Device pointer to the random key of each element.
+ * @param d_ptr Device pointer to the index of each element.
+ * @param num_samples Total number of elements.
+ * @param mask Mask which determines the partner of each element.
+ * @param event Event the kernel depends on.
+ * @returns Event for the kernel.
+ */
+template <typename INT_TYPE>
+inline sycl::event
+submit_segmented_bitonic_step(sycl::queue &queue, const std::size_t *d_offsets,
+                              const std::size_t *d_segments,
+                              std::uint64_t *d_keys, INT_TYPE *d_ptr,
+                              const std::size_t num_samples,
+                              const std::size_t mask, sycl::event event) {
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    const std::size_t segment = d_segments[ix];
+    const std::size_t start = d_offsets[segment];
+    const std::size_t size = d_offsets[segment + 1] - start;
+    const std::size_t local = ix - start;
+    const std::size_t partner = local ^ mask;
+    if ((partner <= local) || (partner >= size)) {
+      return;
+    }
+    const std::size_t jx = start + partner;
+    const std::uint64_t key_i = d_keys[ix];
+    const std::uint64_t key_j = d_keys[jx];
+    const INT_TYPE index_i = d_ptr[ix];
+    const INT_TYPE index_j = d_ptr[jx];
+    if ((key_i > key_j) || ((key_i == key_j) && (index_i > index_j))) {
+      d_keys[ix] = key_j;
+      d_keys[jx] = key_i;
+      d_ptr[ix] = index_j;
+      d_ptr[jx] = index_i;
+    }
+  });
+}
+
+/**
+ * Submit the kernels which write a uniformly random permutation of the
+ * indices of each segment. Each element is assigned a random 64-bit key from
+ * its own Philox stream and the elements of each segment are sorted by key
+ * with a bitonic sorting network, hence the number of kernels only depends
+ * on the bound on the size of the largest segment and every kernel is
+ * parallel over all elements. The bound is distribution.max_segment_size, or
+ * num_samples if it is zero, hence the kernels are submitted without the
+ * host waiting on the device.
+ *
+ * @param queue SYCL queue to submit the kernels to.
+ * @param distribution Segments to permute.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_keys Device pointer to space for num_samples random keys.
+ * @param d_segments Device pointer to space for num_samples values.
+ * @param d_ptr Device pointer to fill with num_samples indices.
+ * @param num_samples Total number of elements.
+ * @param event Event the first kernel depends on, e.g. the event for the key.
+ * @returns Event for the last kernel.
+ */
+template <typename REAL_TYPE, typename INT_TYPE>
+inline sycl::event submit_segmented_permutation(
+    sycl::queue &queue,
+    const Distribution::SegmentedPermutation<INT_TYPE> distribution,
+    const REAL_TYPE *d_key, std::uint64_t *d_keys, std::size_t *d_segments,
+    INT_TYPE *d_ptr, const std::size_t num_samples,
+    sycl::event event = sycl::event{}) {
+  const std::size_t *k_offsets = distribution.d_offsets;
+  const std::size_t k_num_segments = distribution.num_segments;
+  const std::size_t max_size =
+      ((distribution.max_segment_size > 0) &&
+       (distribution.max_segment_size < num_samples))
+          ? distribution.max_segment_size
+          : num_samples;
+
+  event = queue.parallel_for(
+      sycl::range<1>(num_samples), event, [=](auto idx) {
+        const std::size_t ix = idx;
+        PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                            get_key_word(d_key[2], d_key[3]), ix);
+        d_keys[ix] = stream.next_uint64();
+        d_ptr[ix] = static_cast<INT_TYPE>(ix);
+        d_segments[ix] =
+            Distribution::get_parameter_index(k_offsets, k_num_segments, ix);
+      });
+
+  // Blocks of size k are sorted by a step which compares element l with
+  // element l ^ (k - 1), i.e. the two halves are merged as a bitonic
+  // sequence, followed by the half-cleaner steps l ^ (k / 4), ..., l ^ 1.
+  // The steps for blocks larger than twice a segment leave the sorted
+  // segment unchanged, hence a bound larger than the largest segment only
+  // costs additional kernels.
+  for (std::size_t k = 2; k / 2 < max_size; k *= 2) {
+    event = submit_segmented_bitonic_step(queue, k_offsets, d_segments, d_keys,
+                                          d_ptr, num_samples, k - 1, event);
+    for (std::size_t j = k / 4; j > 0; j /= 2) {
+      event = submit_segmented_bitonic_step(queue, k_offsets, d_segments,
+                                            d_keys, d_ptr, num_samples, j,
+                                            event);
+    }
+  }
+  return event;
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
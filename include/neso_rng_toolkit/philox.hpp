@@ -0,0 +1,349 @@
+#ifndef _NESO_RNG_TOOLKIT_PHILOX_HPP_
+#define _NESO_RNG_TOOLKIT_PHILOX_HPP_
+
+#include "typedefs.hpp"
+#include <cstdint>
+#include <limits>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * The Philox4x32-10 counter based generator of Salmon et al. "Parallel
+ * random numbers: as easy as 1, 2, 3" (2011). The output is a function of a
+ * 128-bit counter and a 64-bit key only, hence each work item of a kernel may
+ * sample an independent stream without any state in device memory. All
+ * functions are callable from device code.
+ */
+struct Philox4x32x10 {
+  static constexpr std::uint32_t multiplier_0 = 0xD2511F53;
+  static constexpr std::uint32_t multiplier_1 = 0xCD9E8D57;
+  static constexpr std::uint32_t weyl_0 = 0x9E3779B9;
+  static constexpr std::uint32_t weyl_1 = 0xBB67AE85;
+
+  /**
+   * Apply the 10 rounds of the generator to a counter.
+   *
+   * @param[in] counter Counter to generate output for.
+   * @param[in] key Key to generate output for.
+   * @param[out] output Four 32-bit outputs for the counter and key.
+   */
+  static inline void generate(const std::uint32_t counter[4],
+                              const std::uint32_t key[2],
+                              std::uint32_t output[4]) {
+    std::uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+    std::uint32_t k[2] = {key[0], key[1]};
+    for (int rx = 0; rx < 10; rx++) {
+      const std::uint64_t product_0 =
+          static_cast<std::uint64_t>(multiplier_0) * c[0];
+      const std::uint64_t product_1 =
+          static_cast<std::uint64_t>(multiplier_1) * c[2];
+      const std::uint32_t hi_0 = static_cast<std::uint32_t>(product_0 >> 32);
+      const std::uint32_t lo_0 = static_cast<std::uint32_t>(product_0);
+      const std::uint32_t hi_1 = static_cast<std::uint32_t>(product_1 >> 32);
+      const std::uint32_t lo_1 = static_cast<std::uint32_t>(product_1);
+      c[0] = hi_1 ^ c[1] ^ k[0];
+      c[1] = lo_1;
+      c[2] = hi_0 ^ c[3] ^ k[1];
+      c[3] = lo_0;
+      k[0] += weyl_0;
+      k[1] += weyl_1;
+    }
+    for (int ix = 0; ix < 4; ix++) {
+      output[ix] = c[ix];
+    }
+  }
+};
+
+/**
+ * A sequence of random values for a single work item. The sequence is the
+ * output of Philox4x32-10 with a fixed key for the counters
+ * (i, 0, stream_lo, stream_hi) for i = 0, 1, 2, ..., hence distinct streams
+ * with the same key are independent. Callable from device code.
+ */
+struct PhiloxStream {
+  std::uint32_t key[2];
+  std::uint32_t counter[4];
+  std::uint32_t buffer[4];
+  int buffer_index{4};
+
+  /**
+   * Create a stream.
+   *
+   * @param key_0 First word of the key.
+   * @param key_1 Second word of the key.
+   * @param stream Index of the stream.
+   */
+  PhiloxStream(const std::uint32_t key_0, const std::uint32_t key_1,
+               const std::uint64_t stream)
+      : key{key_0, key_1},
+        counter{0, 0, static_cast<std::uint32_t>(stream),
+                static_cast<std::uint32_t>(stream >> 32)} {}
+
+  /**
+   * @returns The number of blocks of four values the stream has generated.
+   */
+  inline std::uint64_t get_block() const {
+    return (static_cast<std::uint64_t>(this->counter[1]) << 32) |
+           this->counter[0];
+  }
+
+  /**
+   * Position the stream at the start of a block of four values. Values of
+   * the current block which were not yet returned are discarded.
+   *
+   * @param block Index of the next block to generate.
+   */
+  inline void set_block(const std::uint64_t block) {
+    this->counter[0] = static_cast<std::uint32_t>(block);
+    this->counter[1] = static_cast<std::uint32_t>(block >> 32);
+    this->buffer_index = 4;
+  }
+
+  /**
+   * @returns The next 32 random bits of the stream.
+   */
+  inline std::uint32_t next_uint32() {
+    if (this->buffer_index == 4) {
+      Philox4x32x10::generate(this->counter, this->key, this->buffer);
+      if (++this->counter[0] == 0) {
+        ++this->counter[1];
+      }
+      this->buffer_index = 0;
+    }
+    return this->buffer[this->buffer_index++];
+  }
+
+  /**
+   * @returns The next 64 random bits of the stream.
+   */
+  inline std::uint64_t next_uint64() {
+    const std::uint64_t lo = this->next_uint32();
+    const std::uint64_t hi = this->next_uint32();
+    return (hi << 32) | lo;
+  }
+
+  /**
+   * @returns A sample from the Uniform distribution on the open interval
+   * (0, 1). The samples are the midpoints of 2^52 intervals for double and
+   * 2^23 intervals for float such that every sample, including the largest,
+   * is exactly representable.
+   */
+  template <typename REAL_TYPE> inline REAL_TYPE next_uniform();
+};
+
+template <> inline double PhiloxStream::next_uniform<double>() {
+  // The 52 bit value is offset by one half such that 0 and 1 are excluded,
+  // the largest sample is 1 - 2^-53 which requires all 53 significand bits.
+  return (static_cast<double>(this->next_uint64() >> 12) + 0.5) * 0x1.0p-52;
+}
+
+template <> inline float PhiloxStream::next_uniform<float>() {
+  // The largest sample is 1 - 2^-24 which requires all 24 significand bits.
+  return (static_cast<float>(this->next_uint32() >> 9) + 0.5f) * 0x1.0p-23f;
+}
+
+/**
+ * Form one 32-bit word of a Philox key from two samples of the standard
+ * Uniform distribution. Samples equal to one, which some platforms return,
+ * are clamped to the largest word. Callable from device code.
+ */
+template <typename REAL_TYPE>
+inline std::uint32_t get_key_word(const REAL_TYPE u_0, const REAL_TYPE u_1) {
+  const REAL_TYPE scale = static_cast<REAL_TYPE>(4294967296.0);
+  // The largest value below 2^32 which the type represents.
+  const REAL_TYPE max_word =
+      scale - static_cast<REAL_TYPE>(0.5) * scale *
+                  std::numeric_limits<REAL_TYPE>::epsilon();
+  auto to_word = [=](const REAL_TYPE u) {
+    const REAL_TYPE w = u * scale;
+    return static_cast<std::uint32_t>((w < max_word) ? w : max_word);
+  };
+  const std::uint32_t w_0 = to_word(u_0);
+  const std::uint32_t w_1 = to_word(u_1);
+  return w_0 ^ ((w_1 << 16) | (w_1 >> 16));
+}
+
+/**
+ * Form one 32-bit word of a Philox key from two random words, e.g. words
+ * drawn from an RNG for Bits. Callable from device code.
+ */
+inline std::uint32_t get_key_word(const std::uint32_t w_0,
+                                  const std::uint32_t w_1) {
+  return w_0 ^ ((w_1 << 16) | (w_1 >> 16));
+}
+
+/**
+ * The natural logarithm of x in [2^-63, 1] computed with additions,
+ * multiplications, fused multiply-adds and exact scalings by powers of two
+ * only. IEEE 754 defines these operations to the bit, hence host and device
+ * code give identical values unless the compiler reassociates floating point
+ * expressions. Callable from device code.
+ *
+ * @param x Value to compute the logarithm of.
+ * @returns The logarithm of x to within a few units in the last place.
+ */
+template <typename REAL_TYPE> inline REAL_TYPE deterministic_log(REAL_TYPE x) {
+  using R = REAL_TYPE;
+  // x = m 2^e with m in [sqrt(1/2), sqrt(2)).
+  R m = x;
+  R e = R(0.0);
+  for (int p = 32; p > 0; p /= 2) {
+    const R scale = static_cast<R>(std::uint64_t{1} << p);
+    const R scaled = m * scale;
+    if (scaled < R(1.4142135623730951)) {
+      m = scaled;
+      e -= static_cast<R>(p);
+    }
+  }
+  // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1) in [-0.172, 0.172]. The
+  // reciprocal of m + 1 is formed by Newton iterations from a linear guess.
+  const R d = m + R(1.0);
+  R y = sycl::fma(-d, R(0.24264068711928516), R(1.0));
+  for (int ix = 0; ix < 4; ix++) {
+    y = sycl::fma(y, sycl::fma(-d, y, R(1.0)), y);
+  }
+  const R s = (m - R(1.0)) * y;
+  const R s2 = s * s;
+  // The series of atanh(s) / s in s^2, truncated after s^20.
+  const R coefficients[11] = {
+      R(0.047619047619047616), R(0.05263157894736842), R(0.058823529411764705),
+      R(0.06666666666666667),  R(0.07692307692307693), R(0.09090909090909091),
+      R(0.1111111111111111),   R(0.14285714285714285), R(0.2),
+      R(0.3333333333333333),   R(1.0)};
+  R series = coefficients[0];
+  for (int ix = 1; ix < 11; ix++) {
+    series = sycl::fma(series, s2, coefficients[ix]);
+  }
+  return sycl::fma(e, R(0.6931471805599453), (s + s) * series);
+}
+
+/**
+ * The square root of x in [0, 2^63] computed from exact scalings by powers
+ * of four and Newton iterations for the reciprocal square root, see
+ * deterministic_log for the reproducibility. Callable from device code.
+ *
+ * @param x Value to compute the square root of.
+ * @returns The square root of x to within one unit in the last place.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE deterministic_sqrt(REAL_TYPE x) {
+  using R = REAL_TYPE;
+  // x = w 4^h with w in [1/2, 2), the scale is 2^h.
+  R w = x;
+  R scale = R(1.0);
+  for (int p = 16; p > 0; p /= 2) {
+    const R up = static_cast<R>(std::uint64_t{1} << (2 * p));
+    const R down = R(1.0) / up;
+    const R half_scale = static_cast<R>(std::uint64_t{1} << p);
+    if ((w * up < R(2.0)) && (w > R(0.0))) {
+      w *= up;
+      scale /= half_scale;
+    } else if (w >= R(0.5) * up) {
+      w *= down;
+      scale *= half_scale;
+    }
+  }
+  // The chord of 1 / sqrt(w) on [1/2, 2] is within 18 percent.
+  R y = sycl::fma(w, R(-0.4714045207910316), R(1.6499158227686108));
+  for (int ix = 0; ix < 5; ix++) {
+    y = sycl::fma(y * R(0.5), sycl::fma(-(w * y), y, R(1.0)), y);
+  }
+  R r = w * y;
+  r = sycl::fma(y * R(0.5), sycl::fma(-r, r, w), r);
+  return r * scale;
+}
+
+/**
+ * The sine and cosine of 2 pi u for u in [0, 1) computed with exact
+ * reductions to the first octant and Taylor polynomials, see
+ * deterministic_log for the reproducibility. Callable from device code.
+ *
+ * @param[in] u Fraction of a full turn.
+ * @param[out] sin_value The sine of 2 pi u.
+ * @param[out] cos_value The cosine of 2 pi u.
+ */
+template <typename REAL_TYPE>
+inline void deterministic_sincos_2pi(const REAL_TYPE u, REAL_TYPE &sin_value,
+                                     REAL_TYPE &cos_value) {
+  using R = REAL_TYPE;
+  // 2 pi u = (pi / 2) (q + f) with f in [0, 1), and f is reflected into
+  // [0, 1/2], all of which is exact.
+  const R x = R(4.0) * u;
+  const int q = static_cast<int>(x);
+  R f = x - static_cast<R>(q);
+  const bool reflect = f > R(0.5);
+  if (reflect) {
+    f = R(1.0) - f;
+  }
+  const R f2 = f * f;
+  // The Taylor coefficients of sin(pi f / 2) / f and cos(pi f / 2) in f^2,
+  // truncated after (pi f / 2)^19 and (pi f / 2)^18.
+  const R sin_coefficients[10] = {
+      R(-4.377065467313742e-14),  R(6.0669357311061955e-12),
+      R(-6.688035109811468e-10),  R(5.692172921967927e-08),
+      R(-3.598843235212085e-06),  R(0.00016044118478735983),
+      R(-0.004681754135318688),   R(0.07969262624616705),
+      R(-0.6459640975062463),     R(1.5707963267948966)};
+  const R cos_coefficients[10] = {
+      R(-5.294400200734623e-13),  R(6.565963114979473e-11),
+      R(-6.386603083791852e-09),  R(4.710874778818172e-07),
+      R(-2.5202042373060607e-05), R(0.0009192602748394266),
+      R(-0.02086348076335296),    R(0.25366950790104803),
+      R(-1.2337005501361697),     R(1.0)};
+  R sin_series = sin_coefficients[0];
+  R cos_series = cos_coefficients[0];
+  for (int ix = 1; ix < 10; ix++) {
+    sin_series = sycl::fma(sin_series, f2, sin_coefficients[ix]);
+    cos_series = sycl::fma(cos_series, f2, cos_coefficients[ix]);
+  }
+  const R s = reflect ? cos_series : f * sin_series;
+  const R c = reflect ? f * sin_series : cos_series;
+  // Rotate by q quarter turns.
+  sin_value = (q == 0) ? s : ((q == 1) ? c : ((q == 2) ? -s : -c));
+  cos_value = (q == 0) ? c : ((q == 1) ? -s : ((q == 2) ? -c : s));
+}
+
+/**
+ * The Box-Muller2 transform of the philox4x32x10 generators of the stdlib and
+ * oneMKL platforms. Two 32-bit words w_1, w_2 are mapped to the uniform
+ * samples u_i = w_i 2^-32, where u_1 = 0 is replaced by 2^-32, and to the
+ * pair sqrt(-2 ln u_1) sin(2 pi u_2), sqrt(-2 ln u_1) cos(2 pi u_2). The
+ * elementary functions are the deterministic functions above, hence the
+ * samples of host and device code are bit-identical. Callable from device
+ * code.
+ *
+ * @param[in] w_1 Word which sets the radius.
+ * @param[in] w_2 Word which sets the angle.
+ * @param[in] mean Mean of the samples.
+ * @param[in] stddev Standard deviation of the samples.
+ * @param[out] z_0 First sample of the pair.
+ * @param[out] z_1 Second sample of the pair.
+ */
+template <typename REAL_TYPE>
+inline void box_muller2(const std::uint32_t w_1, const std::uint32_t w_2,
+                        const REAL_TYPE mean, const REAL_TYPE stddev,
+                        REAL_TYPE &z_0, REAL_TYPE &z_1) {
+  using R = REAL_TYPE;
+  // Rounding to float may reach one, the largest sample is below one.
+  const R below_one = R(1.0) - R(0.5) * std::numeric_limits<R>::epsilon();
+  auto to_uniform = [=](const std::uint32_t w) {
+    const R u = static_cast<R>(w) * R(0x1.0p-32);
+    return (u < below_one) ? u : below_one;
+  };
+  const R u_1 = (w_1 > 0) ? to_uniform(w_1) : R(0x1.0p-32);
+  const R u_2 = to_uniform(w_2);
+  const R r = deterministic_sqrt(R(-2.0) * deterministic_log(u_1));
+  R sin_value;
+  R cos_value;
+  deterministic_sincos_2pi(u_2, sin_value, cos_value);
+  z_0 = sycl::fma(stddev, r * sin_value, mean);
+  z_1 = sycl::fma(stddev, r * cos_value, mean);
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -2,6 +2,7 @@
 #define _NESO_RNG_TOOLKIT_PLATFORM_HPP_
 
 #include "distribution.hpp"
+#include "engine.hpp"
 #include "rng.hpp"
 #include "typedefs.hpp"
 #include <set>
@@ -74,6 +75,49 @@ public:
   create_rng(Distribution::Normal<VALUE_TYPE> distribution, std::uint64_t seed,
              sycl::device device, std::size_t device_index,
              std::string generator_name) = 0;
+
+  /*
+   * Create an RNG instance which samples random 32-bit words.
+   *
+   * @param distribution Distribution RNG samples should be from.
+   * @param seed Value to seed RNG with.
+   * @param device SYCL Device samples are to be created on.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param generator_name Name of preferred RNG generator method.
+   * @returns RNG instance. nullptr on Error.
+   */
+  virtual RNGSharedPtr<std::uint32_t>
+  create_rng(Distribution::Bits<std::uint32_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) = 0;
+
+  /*
+   * Create an RNG instance which samples random 64-bit words.
+   *
+   * @param distribution Distribution RNG samples should be from.
+   * @param seed Value to seed RNG with.
+   * @param device SYCL Device samples are to be created on.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param generator_name Name of preferred RNG generator method.
+   * @returns RNG instance. nullptr on Error.
+   */
+  virtual RNGSharedPtr<std::uint64_t>
+  create_rng(Distribution::Bits<std::uint64_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) = 0;
+
+  /*
+   * Create an Engine instance.
+   *
+   * @param seed Value to seed Engine with.
+   * @param device SYCL Device samples are to be created on.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param generator_name Name of preferred RNG generator method.
+   * @returns Engine instance. nullptr on Error.
+   */
+  virtual EngineSharedPtr<VALUE_TYPE>
+  create_engine(std::uint64_t seed, sycl::device device,
+                std::size_t device_index, std::string generator_name) = 0;
 };
 
 } // namespace NESO::RNGToolkit
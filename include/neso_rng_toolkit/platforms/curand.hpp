@@ -41,6 +41,28 @@ struct CurandPlatform : public Platform<VALUE_TYPE> {
   create_rng([[maybe_unused]] Distribution::Normal<VALUE_TYPE> distribution,
              std::uint64_t seed, [[maybe_unused]] sycl::device device,
              std::size_t device_index, std::string generator_name) override;
+
+  virtual RNGSharedPtr<std::uint32_t>
+  create_rng(Distribution::Bits<std::uint32_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) override;
+
+  virtual RNGSharedPtr<std::uint64_t>
+  create_rng(Distribution::Bits<std::uint64_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) override;
+
+  virtual EngineSharedPtr<VALUE_TYPE>
+  create_engine(std::uint64_t seed, sycl::device device,
+                std::size_t device_index,
+                std::string generator_name) override;
+
+protected:
+  template <typename BITS_TYPE>
+  RNGSharedPtr<BITS_TYPE>
+  create_bits_rng(Distribution::Bits<BITS_TYPE> distribution,
+                  std::uint64_t seed, sycl::device device,
+                  std::size_t device_index, std::string generator_name);
 };
 
 extern template struct CurandPlatform<double>;
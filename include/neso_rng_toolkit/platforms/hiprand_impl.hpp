@@ -41,9 +41,22 @@ inline bool check_error_code(hiprandStatus_t err) {
   return true;
 }
 
+namespace Private {
+
+/// The SYCL backend of HIP devices, whose native memory objects are HIP
+/// device pointers.
+#ifdef SYCL_EXT_ONEAPI_BACKEND_HIP
+inline constexpr sycl::backend hiprand_backend = sycl::backend::ext_oneapi_hip;
+#else
+inline constexpr sycl::backend hiprand_backend = sycl::backend::hip;
+#endif
+
+} // namespace Private
+
 template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
 
   virtual ~hipRANDRNG() {
+    this->buffer_event.wait_and_throw();
     if (this->d_even_buffer != nullptr) {
       check_error_code(hipFreeAsync(this->d_even_buffer, this->stream));
     }
@@ -68,6 +81,27 @@ template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
 
   std::map<VALUE_TYPE *, std::size_t> map_ptr_num_samples;
 
+  /// Seed the generator was created with.
+  std::uint64_t seed;
+  /// Number of values drawn from the generator, i.e. the offset of the
+  /// generator in its sequence.
+  std::uint64_t offset{0};
+  /// Number of 32-bit generator values each sample consumes. The default
+  /// hipRAND generator consumes one value per float and two per double for the
+  /// Uniform, Normal and LogNormal distributions, where the Normal and
+  /// LogNormal samples are formed in Box-Muller pairs from two floats or two
+  /// doubles, and one value per 32-bit and two per 64-bit word for Bits.
+  std::uint64_t offset_per_sample{sizeof(VALUE_TYPE) / sizeof(std::uint32_t)};
+
+  /// Applies the transform to samples drawn into a SYCL buffer, empty if the
+  /// samples are not transformed.
+  std::function<sycl::event(sycl::queue, sycl::buffer<VALUE_TYPE, 1> &,
+                            std::size_t, std::size_t)>
+      buffer_transform;
+  /// Event for the last command group which draws samples into a SYCL
+  /// buffer. The generator is not used concurrently by the host task.
+  sycl::event buffer_event;
+
   virtual int wait_get_samples([[maybe_unused]] VALUE_TYPE *d_ptr) override {
     if (!this->rng_good) {
       return -1;
@@ -86,7 +120,7 @@ template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
 
   virtual int submit_get_samples(VALUE_TYPE *d_ptr,
                                  const std::size_t num_samples) override {
-
+    this->buffer_event.wait_and_throw();
     if (!this->rng_good) {
       return -2;
     }
@@ -95,7 +129,166 @@ template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
     if (num_samples == 0) {
       return SUCCESS;
     }
+    return this->submit_generate(d_ptr, num_samples);
+  }
+
+  /**
+   * Draw samples directly into a SYCL buffer. A host task passes the native
+   * device memory of the buffer to the hipRAND generator, hence there is no
+   * scratch space or copy, and the SYCL runtime orders the host task with
+   * the other commands which access the buffer. Errors in the host task are
+   * returned by the next call.
+   */
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    this->buffer_event.wait_and_throw();
+    if (!this->rng_good) {
+      return -2;
+    }
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+
+    this->buffer_event = this->queue.submit([&](sycl::handler &cgh) {
+      // The native memory is the whole buffer, hence the accessor covers the
+      // whole buffer and the offset is applied to the native pointer.
+      sycl::accessor accessor(buffer, cgh, sycl::read_write);
+      cgh.host_task([=](sycl::interop_handle handle) {
+        VALUE_TYPE *d_ptr = reinterpret_cast<VALUE_TYPE *>(
+            handle.get_native_mem<Private::hiprand_backend>(accessor));
+        this->rng_good = this->rng_good &&
+                         check_error_code(hipSetDevice(
+                             static_cast<int>(this->device_index)));
+        this->rng_good =
+            this->rng_good &&
+            (this->submit_generate(d_ptr + offset, num_samples) == SUCCESS);
+        // The host task completes once the samples are written.
+        this->rng_good = this->rng_good &&
+                         check_error_code(hipStreamSynchronize(this->stream));
+      });
+    });
+    if (this->buffer_transform) {
+      this->buffer_event =
+          this->buffer_transform(this->queue, buffer, offset, num_samples);
+    }
+    return SUCCESS;
+  }
+
+  /**
+   * Save the seed and the number of values drawn from the generator, see
+   * RNG::save_state. hipRAND does not expose the state of its generators,
+   * hence the state is restored by seeding the generator and setting its
+   * offset.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    state.clear();
+    Private::write_state(state, this->platform_name);
+    Private::write_state(state, this->seed);
+    Private::write_state(state, this->offset);
+    return SUCCESS;
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    std::size_t offset = 0;
+    std::uint64_t seed = 0;
+    std::uint64_t generator_offset = 0;
+    if (!Private::read_state_platform(state, offset, this->platform_name) ||
+        !Private::read_state(state, offset, seed) ||
+        !Private::read_state(state, offset, generator_offset) ||
+        (offset != state.size())) {
+      return Private::invalid_state(this->platform_name);
+    }
+    this->rng_good =
+        this->rng_good && check_error_code(hiprandSetPseudoRandomGeneratorSeed(
+                              this->generator, seed));
+    this->rng_good =
+        this->rng_good && check_error_code(hiprandSetGeneratorOffset(
+                              this->generator, generator_offset));
+    if (!this->rng_good) {
+      return -1;
+    }
+    this->seed = seed;
+    this->offset = generator_offset;
+    return SUCCESS;
+  }
+
+  /**
+   * Create a RNG instance that calls hipRAND.
+   *
+   * @param device SYCL device that is also a HIP device on which to compute
+   * samples.
+   * @param device_index Index of device on node.
+   * @param rng RNG type from which to sample.
+   * @param seed Seed to initialise RNG with.
+   * @param dist Wrapper function that abstracts the various RNG sampling
+   * functions.
+   * @param requires_even_number_of_samples If true then the sampler will only
+   * sample an even number of values.
+   */
+  hipRANDRNG(
+      sycl::device device, std::size_t device_index, hiprandRngType_t rng,
+      std::uint64_t seed,
+      std::function<hiprandStatus_t(hiprandGenerator_t, VALUE_TYPE *,
+                                    std::size_t)>
+          dist,
+      std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)> transform,
+      const bool requires_even_number_of_samples)
+      : device(device), queue(device), device_index(device_index), rng(rng),
+        dist(dist), transform(transform),
+        requires_even_number_of_samples(requires_even_number_of_samples),
+        seed(seed) {
+
+    this->platform_name = "hipRAND";
+
+    this->rng_good =
+        this->rng_good &&
+        check_error_code(hipSetDevice(static_cast<int>(device_index)));
+    this->rng_good =
+        this->rng_good && check_error_code(hipStreamCreate(&this->stream));
+
+    this->rng_good =
+        this->rng_good &&
+        check_error_code(hiprandCreateGenerator(&this->generator, this->rng));
+
+    this->rng_good =
+        this->rng_good &&
+        check_error_code(hiprandSetStream(this->generator, this->stream));
+
+    this->rng_good =
+        this->rng_good && check_error_code(hiprandSetPseudoRandomGeneratorSeed(
+                              this->generator, seed));
+
+    if (this->requires_even_number_of_samples) {
+
+      void *tmp_ptr = nullptr;
+      this->rng_good =
+          this->rng_good &&
+          check_error_code(hipMallocAsync(
+              &tmp_ptr, this->even_buffer_size * sizeof(VALUE_TYPE),
+              this->stream));
+
+      this->d_even_buffer = static_cast<VALUE_TYPE *>(tmp_ptr);
+
+      this->rng_good = this->rng_good &&
+                       check_error_code(hipStreamSynchronize(this->stream));
+      this->rng_good = this->rng_good && (this->d_even_buffer != nullptr);
+    }
+  }
 
+protected:
+  /**
+   * Submit the hipRAND calls which draw samples into device memory.
+   *
+   * @param d_ptr Device pointer to fill with num_samples samples.
+   * @param num_samples Number of samples, greater than zero.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int submit_generate(VALUE_TYPE *d_ptr,
+                             const std::size_t num_samples) {
     // The hipRAND normal and lognormal (?) generators will error if the
     // alignment of the output buffers is not twice the standard alignment.
     const std::size_t offset_start =
@@ -131,6 +324,7 @@ template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
           this->rng_good &&
           check_error_code(this->dist(this->generator, this->d_even_buffer,
                                       this->even_buffer_size));
+      this->offset += this->even_buffer_size * this->offset_per_sample;
       this->rng_good = this->rng_good &&
                        check_error_code(hipStreamSynchronize(this->stream));
 
@@ -177,6 +371,7 @@ template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
 
       if (check_error_code(this->dist(this->generator, d_ptr + offset_start,
                                       num_samples_remaining))) {
+        this->offset += num_samples_remaining * this->offset_per_sample;
         return this->rng_good ? SUCCESS : -3;
       } else {
         return -1;
@@ -185,68 +380,6 @@ template <typename VALUE_TYPE> struct hipRANDRNG : RNG<VALUE_TYPE> {
       return this->rng_good ? SUCCESS : -4;
     }
   }
-
-  /**
-   * Create a RNG instance that calls hipRAND.
-   *
-   * @param device SYCL device that is also a HIP device on which to compute
-   * samples.
-   * @param device_index Index of device on node.
-   * @param rng RNG type from which to sample.
-   * @param seed Seed to initialise RNG with.
-   * @param dist Wrapper function that abstracts the various RNG sampling
-   * functions.
-   * @param requires_even_number_of_samples If true then the sampler will only
-   * sample an even number of values.
-   */
-  hipRANDRNG(
-      sycl::device device, std::size_t device_index, hiprandRngType_t rng,
-      std::uint64_t seed,
-      std::function<hiprandStatus_t(hiprandGenerator_t, VALUE_TYPE *,
-                                    std::size_t)>
-          dist,
-      std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)> transform,
-      const bool requires_even_number_of_samples)
-      : device(device), queue(device), device_index(device_index), rng(rng),
-        dist(dist), transform(transform),
-        requires_even_number_of_samples(requires_even_number_of_samples) {
-
-    this->platform_name = "hipRAND";
-
-    this->rng_good =
-        this->rng_good &&
-        check_error_code(hipSetDevice(static_cast<int>(device_index)));
-    this->rng_good =
-        this->rng_good && check_error_code(hipStreamCreate(&this->stream));
-
-    this->rng_good =
-        this->rng_good &&
-        check_error_code(hiprandCreateGenerator(&this->generator, this->rng));
-
-    this->rng_good =
-        this->rng_good &&
-        check_error_code(hiprandSetStream(this->generator, this->stream));
-
-    this->rng_good =
-        this->rng_good && check_error_code(hiprandSetPseudoRandomGeneratorSeed(
-                              this->generator, seed));
-
-    if (this->requires_even_number_of_samples) {
-
-      void *tmp_ptr = nullptr;
-      this->rng_good =
-          this->rng_good &&
-          check_error_code(hipMallocAsync(
-              &tmp_ptr, this->even_buffer_size * sizeof(VALUE_TYPE),
-              this->stream));
-
-      this->d_even_buffer = static_cast<VALUE_TYPE *>(tmp_ptr);
-
-      this->rng_good = this->rng_good &&
-                       check_error_code(hipStreamSynchronize(this->stream));
-      this->rng_good = this->rng_good && (this->d_even_buffer != nullptr);
-    }
-  }
 };
 
 inline std::function<hiprandStatus_t(hiprandGenerator_t, double *, std::size_t)>
@@ -282,6 +415,268 @@ get_hiprand_normal_dist(const float mean, const float stddev) {
   };
 }
 
+inline std::function<hiprandStatus_t(hiprandGenerator_t, std::uint32_t *,
+                                     std::size_t)>
+get_hiprand_bits_dist(std::uint32_t) {
+  return [=](hiprandGenerator_t generator, std::uint32_t *d_ptr,
+             std::size_t num_samples) -> hiprandStatus_t {
+    return hiprandGenerate(generator, d_ptr, num_samples);
+  };
+}
+
+inline std::function<hiprandStatus_t(hiprandGenerator_t, std::uint64_t *,
+                                     std::size_t)>
+get_hiprand_bits_dist(std::uint64_t) {
+  return [=](hiprandGenerator_t generator, std::uint64_t *d_ptr,
+             std::size_t num_samples) -> hiprandStatus_t {
+    // Each 64-bit word is formed from two 32-bit words of the generator.
+    return hiprandGenerate(generator, reinterpret_cast<std::uint32_t *>(d_ptr),
+                           2 * num_samples);
+  };
+}
+
+inline std::function<hiprandStatus_t(hiprandGenerator_t, double *, std::size_t)>
+get_hiprand_lognormal_dist(const double m, const double s) {
+  return [=](hiprandGenerator_t generator, double *d_ptr,
+             std::size_t num_samples) -> hiprandStatus_t {
+    return hiprandGenerateLogNormalDouble(generator, d_ptr, num_samples, m, s);
+  };
+}
+
+inline std::function<hiprandStatus_t(hiprandGenerator_t, float *, std::size_t)>
+get_hiprand_lognormal_dist(const float m, const float s) {
+  return [=](hiprandGenerator_t generator, float *d_ptr,
+             std::size_t num_samples) -> hiprandStatus_t {
+    return hiprandGenerateLogNormal(generator, d_ptr, num_samples, m, s);
+  };
+}
+
+/**
+ * Map a hipRAND sample in (0,1] to the interval [a,b). Callable from device
+ * code.
+ *
+ * @param a Lower bound of the interval.
+ * @param b Upper bound of the interval.
+ * @param max_allowed_value Largest value less than b.
+ * @param original hipRAND sample in (0,1].
+ * @returns Sample in [a,b).
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE map_hiprand_uniform(const VALUE_TYPE a, const VALUE_TYPE b,
+                                  const VALUE_TYPE max_allowed_value,
+                                  const VALUE_TYPE original) {
+  // Transform the interval from (0, 1] to [0, 1) then to [a, b).
+  const VALUE_TYPE value = (1.0 - original) * (b - a) + a;
+  // Ensure after all that we are actually in [a, b)
+  if (value >= b) {
+    return max_allowed_value;
+  }
+  return (value < a) ? a : value;
+}
+
+/**
+ * Our interface follows the C++ standard and defines the interval as [a,b).
+ * hipRAND samples values in (0,1]. This function returns a function which
+ * transforms hipRAND samples to be in [a,b).
+ *
+ * @param distribution Uniform distribution to transform samples to.
+ * @returns Function which transforms samples in place.
+ */
+template <typename VALUE_TYPE>
+inline std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)>
+get_hiprand_uniform_transform(Distribution::Uniform<VALUE_TYPE> distribution) {
+  return [=](sycl::queue queue, VALUE_TYPE *d_ptr, std::size_t num_samples) {
+    const VALUE_TYPE k_a = distribution.a;
+    const VALUE_TYPE k_b = distribution.b;
+    const VALUE_TYPE k_max_allowed_value = Distribution::previous_value(k_b);
+    queue
+        .parallel_for(sycl::range<1>(num_samples),
+                      [=](auto idx) {
+                        d_ptr[idx] = map_hiprand_uniform(
+                            k_a, k_b, k_max_allowed_value, d_ptr[idx]);
+                      })
+        .wait_and_throw();
+  };
+}
+
+/**
+ * hipRAND samples values in (0,1]. This function returns a function which
+ * transforms hipRAND samples drawn into a range of a SYCL buffer to be in
+ * [a,b).
+ *
+ * @param distribution Uniform distribution to transform samples to.
+ * @returns Function which transforms samples in place and returns the event
+ * for the kernel.
+ */
+template <typename VALUE_TYPE>
+inline std::function<sycl::event(sycl::queue, sycl::buffer<VALUE_TYPE, 1> &,
+                                 std::size_t, std::size_t)>
+get_hiprand_uniform_buffer_transform(
+    Distribution::Uniform<VALUE_TYPE> distribution) {
+  return [=](sycl::queue queue, sycl::buffer<VALUE_TYPE, 1> &buffer,
+             std::size_t offset, std::size_t num_samples) {
+    const VALUE_TYPE k_a = distribution.a;
+    const VALUE_TYPE k_b = distribution.b;
+    const VALUE_TYPE k_max_allowed_value = Distribution::previous_value(k_b);
+    return queue.submit([&](sycl::handler &cgh) {
+      sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                              sycl::id<1>(offset), sycl::read_write);
+      cgh.parallel_for(sycl::range<1>(num_samples), [=](auto idx) {
+        accessor[idx] =
+            map_hiprand_uniform(k_a, k_b, k_max_allowed_value, accessor[idx]);
+      });
+    });
+  };
+}
+
+/**
+ * hipRAND samples Uniform values in (0,1]. This function returns a function
+ * which transforms hipRAND samples to an Exponential distribution by
+ * inversion. As zero is never sampled the logarithm is always finite.
+ *
+ * @param distribution Exponential distribution to transform samples to.
+ * @returns Function which transforms samples in place.
+ */
+template <typename VALUE_TYPE>
+inline std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)>
+get_hiprand_exponential_transform(
+    Distribution::Exponential<VALUE_TYPE> distribution) {
+  return [=](sycl::queue queue, VALUE_TYPE *d_ptr, std::size_t num_samples) {
+    const VALUE_TYPE k_mean =
+        static_cast<VALUE_TYPE>(1.0) / distribution.lambda;
+    queue
+        .parallel_for(sycl::range<1>(num_samples),
+                      [=](auto idx) {
+                        d_ptr[idx] = -k_mean * sycl::log(d_ptr[idx]);
+                      })
+        .wait_and_throw();
+  };
+}
+
+/**
+ * @returns Function which leaves samples unmodified.
+ */
+template <typename VALUE_TYPE>
+inline std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)>
+get_hiprand_identity_transform() {
+  return [=]([[maybe_unused]] sycl::queue queue,
+             [[maybe_unused]] VALUE_TYPE *d_ptr,
+             [[maybe_unused]] std::size_t num_samples) {};
+}
+
+/**
+ * Engine implementation for hipRAND. This wraps a hipRANDRNG and sets
+ * the sampling function and transform on each call.
+ */
+template <typename VALUE_TYPE> struct hipRANDEngine : Engine<VALUE_TYPE> {
+  virtual ~hipRANDEngine() = default;
+
+  std::shared_ptr<hipRANDRNG<VALUE_TYPE>> rng;
+
+  // The transform must be applied to the samples on wait, hence we record the
+  // transform for each pointer in flight.
+  std::map<VALUE_TYPE *,
+           std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)>>
+      map_ptr_transform;
+
+  virtual int submit_get_samples(Distribution::Uniform<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    this->rng->dist = get_hiprand_uniform_dist(static_cast<VALUE_TYPE>(0.0));
+    this->rng->requires_even_number_of_samples = false;
+    this->map_ptr_transform[d_ptr] =
+        get_hiprand_uniform_transform(distribution);
+    return this->rng->submit_get_samples(d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Normal<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    this->rng->dist =
+        get_hiprand_normal_dist(distribution.mean, distribution.stddev);
+    this->rng->requires_even_number_of_samples = true;
+    this->map_ptr_transform[d_ptr] =
+        get_hiprand_identity_transform<VALUE_TYPE>();
+    return this->rng->submit_get_samples(d_ptr, num_samples);
+  }
+
+  virtual int
+  submit_get_samples(Distribution::Exponential<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    this->rng->dist = get_hiprand_uniform_dist(static_cast<VALUE_TYPE>(0.0));
+    this->rng->requires_even_number_of_samples = false;
+    this->map_ptr_transform[d_ptr] =
+        get_hiprand_exponential_transform(distribution);
+    return this->rng->submit_get_samples(d_ptr, num_samples);
+  }
+
+  virtual int
+  submit_get_samples(Distribution::LogNormal<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    this->rng->dist =
+        get_hiprand_lognormal_dist(distribution.m, distribution.s);
+    this->rng->requires_even_number_of_samples = true;
+    this->map_ptr_transform[d_ptr] =
+        get_hiprand_identity_transform<VALUE_TYPE>();
+    return this->rng->submit_get_samples(d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    // hipRAND has no Gamma distribution and the rejection methods for the
+    // Gamma distribution do not map onto a fixed number of hipRAND samples,
+    // hence the samples are drawn by a Philox kernel keyed by this Engine.
+    return this->submit_philox_gamma(distribution, Distribution::Strided{},
+                                     d_ptr, num_samples);
+  }
+
+  /**
+   * The Gamma samples are drawn by a Philox kernel which writes the strided
+   * layout directly.
+   */
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_philox_gamma(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Save the state of the generator, see Engine::save_state.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    return this->rng->save_state(state);
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    return this->rng->load_state(state);
+  }
+
+  /**
+   * Create an Engine instance that calls hiprand.
+   *
+   * @param rng hipRANDRNG instance to draw samples with. This instance must
+   * have been created with requires_even_number_of_samples true such that the
+   * buffer required to sample from Normal distributions is allocated.
+   */
+  hipRANDEngine(std::shared_ptr<hipRANDRNG<VALUE_TYPE>> rng) : rng(rng) {
+    this->device = rng->device;
+    this->device_index = rng->device_index;
+    this->platform_name = rng->platform_name;
+    this->queue = rng->queue;
+  }
+
+protected:
+  virtual int wait_get_samples_internal(VALUE_TYPE *d_ptr) override {
+    this->rng->transform = this->map_ptr_transform.at(d_ptr);
+    this->map_ptr_transform.erase(d_ptr);
+    return this->rng->wait_get_samples(d_ptr);
+  }
+};
+
 template <typename VALUE_TYPE>
 RNGSharedPtr<VALUE_TYPE> hipRANDPlatform<VALUE_TYPE>::create_rng(
     [[maybe_unused]] Distribution::Uniform<VALUE_TYPE> distribution,
@@ -293,47 +688,14 @@ RNGSharedPtr<VALUE_TYPE> hipRANDPlatform<VALUE_TYPE>::create_rng(
                                   std::size_t)>
         dist = get_hiprand_uniform_dist(static_cast<VALUE_TYPE>(0.0));
 
-    /**
-     * Our interface follows the C++ standard and defines the interval as
-     * [a,b). hipRAND samples values in (0,1]. Hence we transform the output to
-     * be in [a,b).
-     */
-
-    sycl::queue queue{device};
     std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)> transform =
-        [=](sycl::queue queue, VALUE_TYPE *d_ptr, std::size_t num_samples) {
-          const VALUE_TYPE k_max_allowed_value =
-              Distribution::previous_value(distribution.b);
-          const VALUE_TYPE k_a = distribution.a;
-          const VALUE_TYPE k_b = distribution.b;
-          const VALUE_TYPE k_width = k_b - k_a;
-          queue
-              .parallel_for(sycl::range<1>(num_samples),
-                            [=](auto idx) {
-                              const VALUE_TYPE original = d_ptr[idx];
-                              // Transform the interval from (0, 1] to [0, 1).
-                              const VALUE_TYPE swapped_interval =
-                                  1.0 - original;
-                              // Transform to [a, b);
-                              VALUE_TYPE transform_interval =
-                                  swapped_interval * k_width + k_a;
-                              // Ensure after all that we are actually in [a,
-                              // b)
-                              transform_interval = (transform_interval < k_a)
-                                                       ? k_a
-                                                       : transform_interval;
-                              transform_interval = (transform_interval >= k_b)
-                                                       ? k_max_allowed_value
-                                                       : transform_interval;
-                              d_ptr[idx] = transform_interval;
-                            })
-              .wait_and_throw();
-        };
+        get_hiprand_uniform_transform(distribution);
 
-    return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(
-        std::make_shared<hipRANDRNG<VALUE_TYPE>>(device, device_index,
-                                                 HIPRAND_RNG_PSEUDO_DEFAULT,
-                                                 seed, dist, transform, false));
+    auto rng = std::make_shared<hipRANDRNG<VALUE_TYPE>>(
+        device, device_index, HIPRAND_RNG_PSEUDO_DEFAULT, seed, dist, transform,
+        false);
+    rng->buffer_transform = get_hiprand_uniform_buffer_transform(distribution);
+    return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(rng);
   } else {
     return nullptr;
   }
@@ -352,11 +714,8 @@ RNGSharedPtr<VALUE_TYPE> hipRANDPlatform<VALUE_TYPE>::create_rng(
         dist = get_hiprand_normal_dist(distribution.mean, distribution.stddev);
 
     // No transform is needed for hiprand Normal distribution.
-    sycl::queue queue{device};
     std::function<void(sycl::queue, VALUE_TYPE *, std::size_t)> transform =
-        [=]([[maybe_unused]] sycl::queue queue,
-            [[maybe_unused]] VALUE_TYPE *d_ptr,
-            [[maybe_unused]] std::size_t num_samples) {};
+        get_hiprand_identity_transform<VALUE_TYPE>();
 
     return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(
         std::make_shared<hipRANDRNG<VALUE_TYPE>>(device, device_index,
@@ -367,6 +726,62 @@ RNGSharedPtr<VALUE_TYPE> hipRANDPlatform<VALUE_TYPE>::create_rng(
   }
 }
 
+template <typename VALUE_TYPE>
+RNGSharedPtr<std::uint32_t> hipRANDPlatform<VALUE_TYPE>::create_rng(
+    Distribution::Bits<std::uint32_t> distribution, std::uint64_t seed,
+    sycl::device device, std::size_t device_index,
+    std::string generator_name) {
+  return this->create_bits_rng(distribution, seed, device, device_index,
+                               generator_name);
+}
+
+template <typename VALUE_TYPE>
+RNGSharedPtr<std::uint64_t> hipRANDPlatform<VALUE_TYPE>::create_rng(
+    Distribution::Bits<std::uint64_t> distribution, std::uint64_t seed,
+    sycl::device device, std::size_t device_index,
+    std::string generator_name) {
+  return this->create_bits_rng(distribution, seed, device, device_index,
+                               generator_name);
+}
+
+template <typename VALUE_TYPE>
+template <typename BITS_TYPE>
+RNGSharedPtr<BITS_TYPE> hipRANDPlatform<VALUE_TYPE>::create_bits_rng(
+    [[maybe_unused]] Distribution::Bits<BITS_TYPE> distribution,
+    std::uint64_t seed, sycl::device device, std::size_t device_index,
+    std::string generator_name) {
+  generator_name = this->get_generator_name(generator_name, "default");
+  if (this->check_generator_name(generator_name, this->generators)) {
+    auto rng = std::make_shared<hipRANDRNG<BITS_TYPE>>(
+        device, device_index, HIPRAND_RNG_PSEUDO_DEFAULT, seed,
+        get_hiprand_bits_dist(static_cast<BITS_TYPE>(0)),
+        get_hiprand_identity_transform<BITS_TYPE>(), false);
+    return std::dynamic_pointer_cast<RNG<BITS_TYPE>>(rng);
+  } else {
+    return nullptr;
+  }
+}
+
+template <typename VALUE_TYPE>
+EngineSharedPtr<VALUE_TYPE> hipRANDPlatform<VALUE_TYPE>::create_engine(
+    std::uint64_t seed, sycl::device device, std::size_t device_index,
+    std::string generator_name) {
+  generator_name = this->get_generator_name(generator_name, "default");
+  if (this->check_generator_name(generator_name, this->generators)) {
+    // The Normal distribution requires the buffer for an even number of
+    // samples hence the hipRANDRNG is created as if for a Normal
+    // distribution.
+    auto rng = std::make_shared<hipRANDRNG<VALUE_TYPE>>(
+        device, device_index, HIPRAND_RNG_PSEUDO_DEFAULT, seed,
+        get_hiprand_uniform_dist(static_cast<VALUE_TYPE>(0.0)),
+        get_hiprand_identity_transform<VALUE_TYPE>(), true);
+    return std::dynamic_pointer_cast<Engine<VALUE_TYPE>>(
+        std::make_shared<hipRANDEngine<VALUE_TYPE>>(rng));
+  } else {
+    return nullptr;
+  }
+}
+
 } // namespace NESO::RNGToolkit
 #endif
 #endif
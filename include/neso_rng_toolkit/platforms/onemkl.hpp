@@ -16,7 +16,8 @@ namespace NESO::RNGToolkit {
 template <typename VALUE_TYPE>
 struct OneMKLPlatform : public Platform<VALUE_TYPE> {
 
-  const static inline std::set<std::string> generators = {"default_engine"};
+  const static inline std::set<std::string> generators = {"default_engine",
+                                                          "philox4x32x10"};
 
   virtual ~OneMKLPlatform() = default;
 
@@ -31,6 +32,33 @@ struct OneMKLPlatform : public Platform<VALUE_TYPE> {
              std::uint64_t seed, sycl::device device,
              [[maybe_unused]] std::size_t device_index,
              std::string generator_name) override;
+
+  virtual RNGSharedPtr<std::uint32_t>
+  create_rng(Distribution::Bits<std::uint32_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) override;
+
+  virtual RNGSharedPtr<std::uint64_t>
+  create_rng(Distribution::Bits<std::uint64_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) override;
+
+  virtual EngineSharedPtr<VALUE_TYPE>
+  create_engine(std::uint64_t seed, sycl::device device,
+                std::size_t device_index,
+                std::string generator_name) override;
+
+protected:
+  template <typename BITS_TYPE>
+  RNGSharedPtr<BITS_TYPE>
+  create_bits_rng(Distribution::Bits<BITS_TYPE> distribution,
+                  std::uint64_t seed, sycl::device device,
+                  std::size_t device_index, std::string generator_name);
+
+  template <typename RNG_VALUE_TYPE, typename DIST_TYPE>
+  RNGSharedPtr<RNG_VALUE_TYPE>
+  create_generator_rng(DIST_TYPE dist, std::uint64_t seed, sycl::device device,
+                       std::string generator_name);
 };
 
 extern template struct OneMKLPlatform<double>;
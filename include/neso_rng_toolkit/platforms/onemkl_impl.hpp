@@ -5,19 +5,23 @@
 #include "../platform.hpp"
 #include "../platforms/stdlib.hpp"
 #include "../rng.hpp"
+#include "../state.hpp"
 #include "onemkl.hpp"
 #include "stdlib.hpp"
 #include <oneapi/mkl.hpp>
 
 namespace NESO::RNGToolkit {
 
-template <typename VALUE_TYPE, typename RNG_TYPE, typename DIST_TYPE>
-struct oneMKLRNG : RNG<VALUE_TYPE> {
-  virtual ~oneMKLRNG() = default;
+/**
+ * The members shared by the RNGs of the oneMKL platform: the oneMKL engine,
+ * whose state is the state of the RNG, and the event of the last call.
+ */
+template <typename VALUE_TYPE, typename RNG_TYPE>
+struct oneMKLRNGBase : RNG<VALUE_TYPE> {
+  virtual ~oneMKLRNGBase() = default;
 
   sycl::queue queue;
   RNG_TYPE rng;
-  DIST_TYPE dist;
 
   sycl::event event;
 
@@ -26,21 +30,385 @@ struct oneMKLRNG : RNG<VALUE_TYPE> {
     return SUCCESS;
   }
 
+  /**
+   * Save the state of the engine with the oneMKL save_state service routine,
+   * see RNG::save_state.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    this->event.wait_and_throw();
+    state.clear();
+    Private::write_state(state, this->platform_name);
+    const std::size_t offset = state.size();
+    state.resize(offset + oneapi::mkl::rng::get_state_size(this->rng));
+    oneapi::mkl::rng::save_state(this->rng, state.data() + offset);
+    return SUCCESS;
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    this->event.wait_and_throw();
+    std::size_t offset = 0;
+    if (!Private::read_state_platform(state, offset, this->platform_name) ||
+        (state.size() - offset !=
+         static_cast<std::size_t>(
+             oneapi::mkl::rng::get_state_size(this->rng)))) {
+      return Private::invalid_state(this->platform_name);
+    }
+    this->rng = oneapi::mkl::rng::load_state<RNG_TYPE>(this->queue,
+                                                       state.data() + offset);
+    return SUCCESS;
+  }
+
+  oneMKLRNGBase(sycl::queue queue, RNG_TYPE rng) : queue(queue), rng(rng) {
+    this->platform_name = "oneMKL";
+  }
+};
+
+template <typename VALUE_TYPE, typename RNG_TYPE, typename DIST_TYPE>
+struct oneMKLRNG : oneMKLRNGBase<VALUE_TYPE, RNG_TYPE> {
+  virtual ~oneMKLRNG() = default;
+
+  DIST_TYPE dist;
+
   virtual int submit_get_samples(VALUE_TYPE *d_ptr,
                                  const std::size_t num_samples) override {
     if (num_samples == 0) {
       this->event = sycl::event{};
     } else {
-      this->event = oneapi::mkl::rng::generate(dist, rng, num_samples, d_ptr);
+      this->event = oneapi::mkl::rng::generate(this->dist, this->rng,
+                                               num_samples, d_ptr);
+    }
+
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+
+    if (offset == 0) {
+      oneapi::mkl::rng::generate(this->dist, this->rng, num_samples, buffer);
+    } else {
+      // oneMKL always writes from the start of the buffer it is given. Note
+      // that the offset of a sub-buffer must satisfy the alignment
+      // requirements of the device.
+      sycl::buffer<VALUE_TYPE, 1> sub_buffer(buffer, sycl::id<1>(offset),
+                                             sycl::range<1>(num_samples));
+      oneapi::mkl::rng::generate(this->dist, this->rng, num_samples,
+                                 sub_buffer);
     }
 
     return SUCCESS;
   }
 
   oneMKLRNG(sycl::queue queue, RNG_TYPE rng, DIST_TYPE dist)
-      : queue(queue), rng(rng), dist(dist) {
+      : oneMKLRNGBase<VALUE_TYPE, RNG_TYPE>(queue, rng), dist(dist) {}
+};
+
+/**
+ * Normal samples of the philox4x32x10 engine. The engine draws the words of
+ * whole pairs into device scratch space, which is reused by each call, and a
+ * kernel maps each pair of words with Private::box_muller2. The
+ * philox4x32x10 generator of the stdlib platform applies the same transform
+ * on the host, hence the samples of the two platforms are bit-identical. The
+ * second sample of the last pair of a call is discarded, as for the oneMKL
+ * gaussian distribution.
+ */
+template <typename VALUE_TYPE, typename RNG_TYPE>
+struct oneMKLPhiloxGaussianRNG : oneMKLRNGBase<VALUE_TYPE, RNG_TYPE> {
+  VALUE_TYPE mean;
+  VALUE_TYPE stddev;
+  /// Device scratch space for the words of the engine.
+  std::uint32_t *d_words{nullptr};
+  /// Number of words the scratch space holds.
+  std::size_t num_words{0};
+
+  virtual ~oneMKLPhiloxGaussianRNG() {
+    if (this->d_words != nullptr) {
+      this->event.wait_and_throw();
+      sycl::free(this->d_words, this->queue);
+    }
+  }
+
+  virtual int submit_get_samples(VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      this->event = sycl::event{};
+      return SUCCESS;
+    }
+    sycl::event event_words;
+    int err = SUCCESS;
+    if ((err = this->submit_words(num_samples, event_words)) != SUCCESS) {
+      return err;
+    }
+    const std::uint32_t *k_words = this->d_words;
+    const VALUE_TYPE k_mean = this->mean;
+    const VALUE_TYPE k_stddev = this->stddev;
+    this->event = this->queue.parallel_for(
+        sycl::range<1>((num_samples + 1) / 2), event_words, [=](auto idx) {
+          const std::size_t ix = idx;
+          VALUE_TYPE z_0;
+          VALUE_TYPE z_1;
+          Private::box_muller2(k_words[2 * ix], k_words[2 * ix + 1], k_mean,
+                               k_stddev, z_0, z_1);
+          d_ptr[2 * ix] = z_0;
+          if (2 * ix + 1 < num_samples) {
+            d_ptr[2 * ix + 1] = z_1;
+          }
+        });
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+    sycl::event event_words;
+    int err = SUCCESS;
+    if ((err = this->submit_words(num_samples, event_words)) != SUCCESS) {
+      return err;
+    }
+    const std::uint32_t *k_words = this->d_words;
+    const VALUE_TYPE k_mean = this->mean;
+    const VALUE_TYPE k_stddev = this->stddev;
+    this->event = this->queue.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(event_words);
+      sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                              sycl::id<1>(offset), sycl::write_only);
+      cgh.parallel_for(sycl::range<1>((num_samples + 1) / 2), [=](auto idx) {
+        const std::size_t ix = idx;
+        VALUE_TYPE z_0;
+        VALUE_TYPE z_1;
+        Private::box_muller2(k_words[2 * ix], k_words[2 * ix + 1], k_mean,
+                             k_stddev, z_0, z_1);
+        accessor[2 * ix] = z_0;
+        if (2 * ix + 1 < num_samples) {
+          accessor[2 * ix + 1] = z_1;
+        }
+      });
+    });
+    return SUCCESS;
+  }
+
+  oneMKLPhiloxGaussianRNG(sycl::queue queue, RNG_TYPE rng,
+                          const VALUE_TYPE mean, const VALUE_TYPE stddev)
+      : oneMKLRNGBase<VALUE_TYPE, RNG_TYPE>(queue, rng), mean(mean),
+        stddev(stddev) {}
+
+protected:
+  /**
+   * Submit the generation of the words of the pairs of num_samples samples
+   * into the scratch space, after the previous call has read the words.
+   *
+   * @param[in] num_samples Number of samples.
+   * @param[out] event Event for the generation of the words.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int submit_words(const std::size_t num_samples, sycl::event &event) {
+    const std::size_t num_words = 2 * ((num_samples + 1) / 2);
+    if (num_words > this->num_words) {
+      this->event.wait_and_throw();
+      if (this->d_words != nullptr) {
+        sycl::free(this->d_words, this->queue);
+      }
+      this->d_words = sycl::malloc_device<std::uint32_t>(num_words,
+                                                         this->queue);
+      this->num_words = (this->d_words == nullptr) ? 0 : num_words;
+      if (this->d_words == nullptr) {
+        std::cout << "Failed to allocate device memory." << std::endl;
+        return -2;
+      }
+    }
+    event = oneapi::mkl::rng::generate(
+        oneapi::mkl::rng::uniform_bits<std::uint32_t>(), this->rng,
+        num_words, this->d_words, {this->event});
+    return SUCCESS;
+  }
+};
+
+template <typename VALUE_TYPE, typename RNG_TYPE>
+struct oneMKLEngine : Engine<VALUE_TYPE> {
+  virtual ~oneMKLEngine() = default;
+
+  RNG_TYPE rng;
+
+  sycl::event event;
+
+  virtual int submit_get_samples(Distribution::Uniform<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_generate(
+        oneapi::mkl::rng::uniform<VALUE_TYPE>(distribution.a, distribution.b),
+        d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Normal<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_generate(oneapi::mkl::rng::gaussian<VALUE_TYPE>(
+                                     distribution.mean, distribution.stddev),
+                                 d_ptr, num_samples);
+  }
+
+  virtual int
+  submit_get_samples(Distribution::Exponential<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    // oneMKL parameterises by displacement and scale, i.e. the mean.
+    return this->submit_generate(
+        oneapi::mkl::rng::exponential<VALUE_TYPE>(
+            static_cast<VALUE_TYPE>(0.0),
+            static_cast<VALUE_TYPE>(1.0) / distribution.lambda),
+        d_ptr, num_samples);
+  }
+
+  virtual int
+  submit_get_samples(Distribution::LogNormal<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    return this->submit_generate(
+        oneapi::mkl::rng::lognormal<VALUE_TYPE>(distribution.m, distribution.s),
+        d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_generate(
+        oneapi::mkl::rng::gamma<VALUE_TYPE>(distribution.alpha,
+                                            static_cast<VALUE_TYPE>(0.0),
+                                            distribution.beta),
+        d_ptr, num_samples);
+  }
+
+  /**
+   * Vectors which all use the first parameter set and are stored in the AoS
+   * layout are drawn by the oneMKL gaussian_mv distribution, otherwise the
+   * vectors are drawn as described by Engine.
+   */
+  virtual int
+  submit_get_samples(Distribution::MultivariateNormal<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    const std::size_t ndim = distribution.ndim;
+    if ((ndim == 0) || (distribution.d_offsets != nullptr) ||
+        (distribution.num_segments != 1) ||
+        (distribution.layout != Distribution::Layout::AoS)) {
+      return Engine<VALUE_TYPE>::submit_get_samples(distribution, d_ptr,
+                                                    num_samples);
+    }
+    int err = SUCCESS;
+    if ((err = this->check_not_in_flight(d_ptr)) != SUCCESS) {
+      return err;
+    }
+    if (num_samples == 0) {
+      this->event = sycl::event{};
+      return SUCCESS;
+    }
+    // The parameters of a oneMKL distribution are host vectors. The factor
+    // is the lower triangular T of the covariance T T^T which the full
+    // layout stores as ndim * ndim row major values.
+    std::vector<VALUE_TYPE> mean(ndim);
+    std::vector<VALUE_TYPE> factor(ndim * ndim);
+    this->queue
+        .memcpy(mean.data(), distribution.d_mean, ndim * sizeof(VALUE_TYPE))
+        .wait_and_throw();
+    this->queue
+        .memcpy(factor.data(), distribution.d_factor,
+                ndim * ndim * sizeof(VALUE_TYPE))
+        .wait_and_throw();
+    // The number generated is the number of vectors.
+    return this->submit_generate(
+        oneapi::mkl::rng::gaussian_mv<VALUE_TYPE,
+                                      oneapi::mkl::rng::layout::full>(
+            static_cast<std::uint32_t>(ndim), mean, factor),
+        d_ptr, num_samples);
+  }
+
+  /**
+   * Vectors which are drawn by the oneMKL gaussian_mv distribution are copied
+   * into the strided layout, otherwise the Philox kernel of Engine writes the
+   * layout directly.
+   */
+  virtual int
+  submit_get_samples(Distribution::MultivariateNormal<VALUE_TYPE> distribution,
+                     const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    if ((distribution.ndim == 0) || (distribution.d_offsets != nullptr) ||
+        (distribution.num_segments != 1) ||
+        (distribution.layout != Distribution::Layout::AoS)) {
+      return Engine<VALUE_TYPE>::submit_get_samples(distribution, layout,
+                                                    d_ptr, num_samples);
+    }
+    return this->submit_scattered(distribution, layout, d_ptr, num_samples);
+  }
+
+  /**
+   * Save the state of the engine with the oneMKL save_state service routine,
+   * see Engine::save_state.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    this->event.wait_and_throw();
+    state.clear();
+    Private::write_state(state, this->platform_name);
+    const std::size_t offset = state.size();
+    state.resize(offset + oneapi::mkl::rng::get_state_size(this->rng));
+    oneapi::mkl::rng::save_state(this->rng, state.data() + offset);
+    return SUCCESS;
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    this->event.wait_and_throw();
+    std::size_t offset = 0;
+    if (!Private::read_state_platform(state, offset, this->platform_name) ||
+        (state.size() - offset !=
+         static_cast<std::size_t>(
+             oneapi::mkl::rng::get_state_size(this->rng)))) {
+      return Private::invalid_state(this->platform_name);
+    }
+    this->rng = oneapi::mkl::rng::load_state<RNG_TYPE>(this->queue,
+                                                       state.data() + offset);
+    return SUCCESS;
+  }
+
+  oneMKLEngine(sycl::queue queue, RNG_TYPE rng) : rng(rng) {
+    this->queue = queue;
     this->platform_name = "oneMKL";
   }
+
+protected:
+  virtual int
+  wait_get_samples_internal([[maybe_unused]] VALUE_TYPE *d_ptr) override {
+    this->event.wait_and_throw();
+    return SUCCESS;
+  }
+
+  virtual int get_samples_event([[maybe_unused]] VALUE_TYPE *d_ptr,
+                                sycl::event &event) override {
+    event = this->event;
+    return SUCCESS;
+  }
+
+  template <typename DIST_TYPE>
+  inline int submit_generate(DIST_TYPE dist, VALUE_TYPE *d_ptr,
+                             const std::size_t num_samples) {
+    if (num_samples == 0) {
+      this->event = sycl::event{};
+    } else {
+      this->event = oneapi::mkl::rng::generate(dist, rng, num_samples, d_ptr);
+    }
+    return SUCCESS;
+  }
 };
 
 template <typename VALUE_TYPE>
@@ -48,20 +416,9 @@ RNGSharedPtr<VALUE_TYPE> OneMKLPlatform<VALUE_TYPE>::create_rng(
     [[maybe_unused]] Distribution::Uniform<VALUE_TYPE> distribution,
     std::uint64_t seed, sycl::device device,
     [[maybe_unused]] std::size_t device_index, std::string generator_name) {
-  generator_name = this->get_generator_name(generator_name, "default_engine");
-  if (this->check_generator_name(generator_name, this->generators)) {
-    sycl::queue queue(device);
-    auto engine = oneapi::mkl::rng::default_engine{queue, seed};
-    auto dist =
-        oneapi::mkl::rng::uniform<VALUE_TYPE>(distribution.a, distribution.b);
-
-    return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(
-        std::make_shared<
-            oneMKLRNG<VALUE_TYPE, decltype(engine), decltype(dist)>>(
-            queue, engine, dist));
-  } else {
-    return nullptr;
-  }
+  return this->template create_generator_rng<VALUE_TYPE>(
+      oneapi::mkl::rng::uniform<VALUE_TYPE>(distribution.a, distribution.b),
+      seed, device, generator_name);
 }
 
 template <typename VALUE_TYPE>
@@ -69,20 +426,98 @@ RNGSharedPtr<VALUE_TYPE> OneMKLPlatform<VALUE_TYPE>::create_rng(
     [[maybe_unused]] Distribution::Normal<VALUE_TYPE> distribution,
     std::uint64_t seed, sycl::device device,
     [[maybe_unused]] std::size_t device_index, std::string generator_name) {
-  generator_name = this->get_generator_name(generator_name, "default_engine");
-  if (this->check_generator_name(generator_name, this->generators)) {
+  if (this->get_generator_name(generator_name, "default_engine") ==
+      "philox4x32x10") {
     sycl::queue queue(device);
-    auto engine = oneapi::mkl::rng::default_engine(queue, seed);
-    auto dist = oneapi::mkl::rng::gaussian<VALUE_TYPE>(distribution.mean,
-                                                       distribution.stddev);
-
-    return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(
-        std::make_shared<
-            oneMKLRNG<VALUE_TYPE, decltype(engine), decltype(dist)>>(
-            queue, engine, dist));
-  } else {
+    auto engine = oneapi::mkl::rng::philox4x32x10(queue, seed);
+    return std::make_shared<
+        oneMKLPhiloxGaussianRNG<VALUE_TYPE, decltype(engine)>>(
+        queue, engine, distribution.mean, distribution.stddev);
+  }
+  return this->template create_generator_rng<VALUE_TYPE>(
+      oneapi::mkl::rng::gaussian<VALUE_TYPE>(distribution.mean,
+                                             distribution.stddev),
+      seed, device, generator_name);
+}
+
+template <typename VALUE_TYPE>
+RNGSharedPtr<std::uint32_t> OneMKLPlatform<VALUE_TYPE>::create_rng(
+    Distribution::Bits<std::uint32_t> distribution, std::uint64_t seed,
+    sycl::device device, std::size_t device_index,
+    std::string generator_name) {
+  return this->create_bits_rng(distribution, seed, device, device_index,
+                               generator_name);
+}
+
+template <typename VALUE_TYPE>
+RNGSharedPtr<std::uint64_t> OneMKLPlatform<VALUE_TYPE>::create_rng(
+    Distribution::Bits<std::uint64_t> distribution, std::uint64_t seed,
+    sycl::device device, std::size_t device_index,
+    std::string generator_name) {
+  return this->create_bits_rng(distribution, seed, device, device_index,
+                               generator_name);
+}
+
+template <typename VALUE_TYPE>
+template <typename BITS_TYPE>
+RNGSharedPtr<BITS_TYPE> OneMKLPlatform<VALUE_TYPE>::create_bits_rng(
+    [[maybe_unused]] Distribution::Bits<BITS_TYPE> distribution,
+    std::uint64_t seed, sycl::device device,
+    [[maybe_unused]] std::size_t device_index, std::string generator_name) {
+  return this->template create_generator_rng<BITS_TYPE>(
+      oneapi::mkl::rng::uniform_bits<BITS_TYPE>(), seed, device,
+      generator_name);
+}
+
+template <typename VALUE_TYPE>
+template <typename RNG_VALUE_TYPE, typename DIST_TYPE>
+RNGSharedPtr<RNG_VALUE_TYPE> OneMKLPlatform<VALUE_TYPE>::create_generator_rng(
+    DIST_TYPE dist, std::uint64_t seed, sycl::device device,
+    std::string generator_name) {
+  generator_name = this->get_generator_name(generator_name, "default_engine");
+  if (!this->check_generator_name(generator_name, this->generators)) {
     return nullptr;
   }
+  sycl::queue queue(device);
+  if (generator_name == "philox4x32x10") {
+    // The standard method of uniform is reproduced by the philox4x32x10
+    // generator of the stdlib platform, Normal RNGs of this generator are
+    // oneMKLPhiloxGaussianRNG.
+    auto engine = oneapi::mkl::rng::philox4x32x10(queue, seed);
+    return std::make_shared<
+        oneMKLRNG<RNG_VALUE_TYPE, decltype(engine), DIST_TYPE>>(queue, engine,
+                                                                dist);
+  }
+  auto engine = oneapi::mkl::rng::default_engine(queue, seed);
+  return std::make_shared<
+      oneMKLRNG<RNG_VALUE_TYPE, decltype(engine), DIST_TYPE>>(queue, engine,
+                                                              dist);
+}
+
+template <typename VALUE_TYPE>
+EngineSharedPtr<VALUE_TYPE>
+OneMKLPlatform<VALUE_TYPE>::create_engine(std::uint64_t seed,
+                                          sycl::device device,
+                                          std::size_t device_index,
+                                          std::string generator_name) {
+  generator_name = this->get_generator_name(generator_name, "default_engine");
+  if (!this->check_generator_name(generator_name, this->generators)) {
+    return nullptr;
+  }
+  sycl::queue queue(device);
+  EngineSharedPtr<VALUE_TYPE> engine;
+  if (generator_name == "philox4x32x10") {
+    auto rng = oneapi::mkl::rng::philox4x32x10(queue, seed);
+    engine =
+        std::make_shared<oneMKLEngine<VALUE_TYPE, decltype(rng)>>(queue, rng);
+  } else {
+    auto rng = oneapi::mkl::rng::default_engine(queue, seed);
+    engine =
+        std::make_shared<oneMKLEngine<VALUE_TYPE, decltype(rng)>>(queue, rng);
+  }
+  engine->device = device;
+  engine->device_index = device_index;
+  return engine;
 }
 
 } // namespace NESO::RNGToolkit
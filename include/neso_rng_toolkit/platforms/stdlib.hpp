@@ -1,19 +1,383 @@
 #ifndef _NESO_RNG_TOOLKIT_PLATFORMS_STDLIB_HPP_
 #define _NESO_RNG_TOOLKIT_PLATFORMS_STDLIB_HPP_
 
+#include "../philox.hpp"
 #include "../platform.hpp"
 #include "../rng.hpp"
+#include "../state.hpp"
+#include "../transform.hpp"
+#include <cmath>
 #include <random>
+#include <type_traits>
 
 namespace NESO::RNGToolkit {
 
-template <typename VALUE_TYPE, typename RNG_TYPE, typename DIST_TYPE>
+namespace Private {
+
+/// Number of samples the stdlib platforms create on the host per copy.
+constexpr std::size_t stdlib_block_size = 1024;
+
+/**
+ * Helper function to create samples on the host and copy them to the device.
+ * The samples are created in blocks such that the copy of a block to the
+ * device overlaps with the creation of the next block.
+ *
+ * @param queue SYCL queue to copy samples to the device with.
+ * @param d_ptr Device pointer to fill with num_samples samples.
+ * @param num_samples Number of samples to place in device buffer.
+ * @param sample Callable which returns a new sample on each call.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename VALUE_TYPE, typename SAMPLE_TYPE>
+inline int stdlib_submit_samples(sycl::queue &queue, VALUE_TYPE *d_ptr,
+                                  const std::size_t num_samples,
+                                  SAMPLE_TYPE &&sample) {
+  if (num_samples == 0) {
+    return SUCCESS;
+  }
+
+  auto d_ptr_start = d_ptr;
+  constexpr std::size_t block_size = stdlib_block_size;
+
+  // Create the random number in blocks and copy to device blockwise.
+  std::vector<VALUE_TYPE> block0(block_size);
+  std::vector<VALUE_TYPE> block1(block_size);
+
+  VALUE_TYPE *ptr_tmp;
+  VALUE_TYPE *ptr_current = block0.data();
+  VALUE_TYPE *ptr_next = block1.data();
+  std::size_t num_numbers_moved = 0;
+
+  sycl::event e;
+  while (num_numbers_moved < num_samples) {
+
+    // Create a block of samples
+    const std::size_t num_to_memcpy =
+        std::min(static_cast<std::size_t>(block_size),
+                 num_samples - num_numbers_moved);
+    for (std::size_t ix = 0; ix < num_to_memcpy; ix++) {
+      ptr_current[ix] = sample();
+    }
+
+    // Wait until the previous block finished copying before starting this
+    // copy
+    e.wait_and_throw();
+    e = queue.memcpy(d_ptr, ptr_current, num_to_memcpy * sizeof(VALUE_TYPE));
+    d_ptr += num_to_memcpy;
+    num_numbers_moved += num_to_memcpy;
+
+    // swap ptr_current and ptr_next such that the new samples are written
+    // into ptr_next whilst ptr_current is being copied to the device.
+    ptr_tmp = ptr_current;
+    ptr_current = ptr_next;
+    ptr_next = ptr_tmp;
+  }
+  e.wait_and_throw();
+
+  if (num_numbers_moved != num_samples) {
+    std::cout << "Failed to copy samples to device." << std::endl;
+    return -1;
+  }
+
+  if (d_ptr != d_ptr_start + num_samples) {
+    std::cout << "Failed to copy samples to device." << std::endl;
+    return -2;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * Helper function to create samples on the host and write them to the device
+ * in a strided layout. Each block of samples is copied to device staging space
+ * and a kernel writes the block into the layout. The copy and the kernel for a
+ * block overlap with the creation of the next block.
+ *
+ * @param queue SYCL queue to copy samples to the device with.
+ * @param layout Strided layout the samples are written in.
+ * @param d_staging Device pointer to space for 2 * stdlib_block_size values.
+ * @param d_ptr Device pointer to fill with num_samples samples.
+ * @param num_samples Number of samples to place in device buffer.
+ * @param sample Callable which returns a new sample on each call.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename VALUE_TYPE, typename SAMPLE_TYPE>
+inline int stdlib_submit_strided_samples(sycl::queue &queue,
+                                          const Distribution::Strided layout,
+                                          VALUE_TYPE *d_staging,
+                                          VALUE_TYPE *d_ptr,
+                                          const std::size_t num_samples,
+                                          SAMPLE_TYPE &&sample) {
+  constexpr std::size_t block_size = stdlib_block_size;
+  std::vector<VALUE_TYPE> blocks[2] = {std::vector<VALUE_TYPE>(block_size),
+                                       std::vector<VALUE_TYPE>(block_size)};
+  sycl::event copy_events[2];
+  sycl::event write_events[2];
+
+  std::size_t num_numbers_moved = 0;
+  for (std::size_t bx = 0; num_numbers_moved < num_samples; bx++) {
+    const std::size_t half = bx % 2;
+    const std::size_t num_to_memcpy = std::min(
+        static_cast<std::size_t>(block_size), num_samples - num_numbers_moved);
+
+    // The host block of this half is reused once its previous copy finished.
+    copy_events[half].wait_and_throw();
+    VALUE_TYPE *ptr_current = blocks[half].data();
+    for (std::size_t ix = 0; ix < num_to_memcpy; ix++) {
+      ptr_current[ix] = sample();
+    }
+
+    // The staging half is reused once its previous block was written out.
+    VALUE_TYPE *d_block = d_staging + half * block_size;
+    copy_events[half] =
+        queue.memcpy(d_block, ptr_current, num_to_memcpy * sizeof(VALUE_TYPE),
+                     write_events[half]);
+    const std::size_t k_start = num_numbers_moved;
+    write_events[half] = queue.parallel_for(
+        sycl::range<1>(num_to_memcpy), copy_events[half],
+        [=](auto idx) {
+          const std::size_t ix = idx;
+          d_ptr[Distribution::get_strided_index(layout, k_start + ix)] =
+              d_block[ix];
+        });
+    num_numbers_moved += num_to_memcpy;
+  }
+  write_events[0].wait_and_throw();
+  write_events[1].wait_and_throw();
+
+  if (num_numbers_moved != num_samples) {
+    std::cout << "Failed to copy samples to device." << std::endl;
+    return -1;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * Distribution for the stdlib RNG types which returns the output of the
+ * generator directly. For 32-bit words from a 64-bit generator each output of
+ * the generator is split into two words, and for 64-bit words from a 32-bit
+ * generator each word is formed from two outputs, least significant first.
+ */
+template <typename BITS_TYPE> struct StdLibBits {
+  bool has_next{false};
+  std::uint32_t next{0};
+
+  template <typename RNG_TYPE> inline BITS_TYPE operator()(RNG_TYPE &rng) {
+    static_assert((RNG_TYPE::word_size == 32) || (RNG_TYPE::word_size == 64),
+                  "Expected a generator with 32 or 64-bit output.");
+    static_assert(std::is_same_v<BITS_TYPE, std::uint32_t> ||
+                      std::is_same_v<BITS_TYPE, std::uint64_t>,
+                  "Bits are only sampled as 32 or 64-bit words.");
+    if constexpr (RNG_TYPE::word_size == 32) {
+      if constexpr (std::is_same_v<BITS_TYPE, std::uint32_t>) {
+        return rng();
+      } else {
+        const std::uint64_t lo = rng();
+        const std::uint64_t hi = rng();
+        return (hi << 32) | lo;
+      }
+    } else if constexpr (std::is_same_v<BITS_TYPE, std::uint64_t>) {
+      return rng();
+    } else {
+      if (this->has_next) {
+        this->has_next = false;
+        return this->next;
+      }
+      const std::uint64_t value = rng();
+      this->next = static_cast<std::uint32_t>(value >> 32);
+      this->has_next = true;
+      return static_cast<std::uint32_t>(value);
+    }
+  }
+};
+
+/**
+ * The Philox4x32-10 generator as a C++ uniform random bit generator, seeded
+ * as the oneMKL philox4x32x10 engine: the 64-bit seed is the key, the counter
+ * starts at zero and the four words of each counter are returned in order.
+ */
+struct StdLibPhilox {
+  using result_type = std::uint32_t;
+  static constexpr std::size_t word_size = 32;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFF; }
+
+  PhiloxStream stream;
+
+  StdLibPhilox(const std::uint64_t seed)
+      : stream(static_cast<std::uint32_t>(seed),
+               static_cast<std::uint32_t>(seed >> 32), 0) {}
+
+  inline result_type operator()() { return this->stream.next_uint32(); }
+};
+
+/**
+ * The standard method of the oneMKL uniform distribution for a 32-bit
+ * generator, which maps each output u of the generator to
+ * a + u (b - a) / 2^32. The conversion of u to float rounds the largest
+ * outputs to 2^32, hence samples which round to b are replaced with the
+ * largest value below b.
+ */
+template <typename VALUE_TYPE> struct StdLibPhiloxUniform {
+  VALUE_TYPE a;
+  VALUE_TYPE scale;
+  VALUE_TYPE below_b;
+
+  StdLibPhiloxUniform(const VALUE_TYPE a, const VALUE_TYPE b)
+      : a(a),
+        scale((b - a) / (static_cast<VALUE_TYPE>(4294967295u) +
+                         static_cast<VALUE_TYPE>(1.0))),
+        below_b((a < b) ? std::nextafter(b, a) : b) {}
+
+  template <typename RNG_TYPE> inline VALUE_TYPE operator()(RNG_TYPE &rng) {
+    const VALUE_TYPE sample =
+        static_cast<VALUE_TYPE>(rng()) * this->scale + this->a;
+    return (sample < this->below_b) ? sample : this->below_b;
+  }
+};
+
+/**
+ * The Box-Muller2 transform of the philox4x32x10 generator, see
+ * Private::box_muller2, which maps each pair of generator outputs to a pair of
+ * samples. The oneMKL platform applies the same transform on the device to
+ * the output of the oneMKL philox4x32x10 engine, hence the samples of the two
+ * platforms are bit-identical. The second sample of the last pair of a call is
+ * discarded, see stdlib_end_call, as the state of a oneMKL engine is the state
+ * of the generator only.
+ */
+template <typename VALUE_TYPE> struct StdLibPhiloxGaussian {
+  VALUE_TYPE mean;
+  VALUE_TYPE stddev;
+  bool has_next{false};
+  VALUE_TYPE next{0.0};
+
+  StdLibPhiloxGaussian(const VALUE_TYPE mean, const VALUE_TYPE stddev)
+      : mean(mean), stddev(stddev) {}
+
+  template <typename RNG_TYPE> inline VALUE_TYPE operator()(RNG_TYPE &rng) {
+    if (this->has_next) {
+      this->has_next = false;
+      return this->next;
+    }
+    const std::uint32_t w_1 = rng();
+    const std::uint32_t w_2 = rng();
+    VALUE_TYPE z_0;
+    box_muller2(w_1, w_2, this->mean, this->stddev, z_0, this->next);
+    this->has_next = true;
+    return z_0;
+  }
+};
+
+/**
+ * Called by StdLibRNG at the end of each call which draws samples from a
+ * distribution. Distributions which do not carry state between calls are
+ * unchanged.
+ */
+template <typename DIST_TYPE>
+inline void stdlib_end_call([[maybe_unused]] DIST_TYPE &dist) {}
+
+template <typename VALUE_TYPE>
+inline void stdlib_end_call(StdLibPhiloxGaussian<VALUE_TYPE> &dist) {
+  dist.has_next = false;
+}
+
+/**
+ * Append the state of a generator or distribution of a StdLibRNG to a state
+ * blob. The stdlib distributions are written as their parameters and cached
+ * values, see write_distribution_state.
+ */
+template <typename DIST_TYPE>
+inline void stdlib_write_state(std::vector<std::uint8_t> &state,
+                               const DIST_TYPE &dist) {
+  write_distribution_state(state, dist);
+}
+
+inline void stdlib_write_state(std::vector<std::uint8_t> &state,
+                               const std::mt19937_64 &rng) {
+  write_engine_state(state, rng);
+}
+
+inline void stdlib_write_state(std::vector<std::uint8_t> &state,
+                               const StdLibPhilox &rng) {
+  write_state(state, rng.stream);
+}
+
+template <typename BITS_TYPE>
+inline void stdlib_write_state(std::vector<std::uint8_t> &state,
+                               const StdLibBits<BITS_TYPE> &dist) {
+  write_state(state, dist.has_next);
+  write_state(state, dist.next);
+}
+
+// The oneMKL methods carry no state between calls.
+template <typename VALUE_TYPE>
+inline void stdlib_write_state(
+    [[maybe_unused]] std::vector<std::uint8_t> &state,
+    [[maybe_unused]] const StdLibPhiloxUniform<VALUE_TYPE> &dist) {}
+
+template <typename VALUE_TYPE>
+inline void stdlib_write_state(
+    [[maybe_unused]] std::vector<std::uint8_t> &state,
+    [[maybe_unused]] const StdLibPhiloxGaussian<VALUE_TYPE> &dist) {}
+
+/**
+ * Read the state of a generator or distribution of a StdLibRNG written by
+ * stdlib_write_state.
+ *
+ * @returns False if the blob does not hold the state.
+ */
+template <typename DIST_TYPE>
+inline bool stdlib_read_state(const std::vector<std::uint8_t> &state,
+                              std::size_t &offset, DIST_TYPE &dist) {
+  return read_distribution_state(state, offset, dist);
+}
+
+inline bool stdlib_read_state(const std::vector<std::uint8_t> &state,
+                              std::size_t &offset, std::mt19937_64 &rng) {
+  return read_engine_state(state, offset, rng);
+}
+
+inline bool stdlib_read_state(const std::vector<std::uint8_t> &state,
+                              std::size_t &offset, StdLibPhilox &rng) {
+  return read_state(state, offset, rng.stream);
+}
+
+template <typename BITS_TYPE>
+inline bool stdlib_read_state(const std::vector<std::uint8_t> &state,
+                              std::size_t &offset,
+                              StdLibBits<BITS_TYPE> &dist) {
+  return read_state(state, offset, dist.has_next) &&
+         read_state(state, offset, dist.next);
+}
+
+template <typename VALUE_TYPE>
+inline bool
+stdlib_read_state([[maybe_unused]] const std::vector<std::uint8_t> &state,
+                  [[maybe_unused]] std::size_t &offset,
+                  [[maybe_unused]] StdLibPhiloxUniform<VALUE_TYPE> &dist) {
+  return true;
+}
+
+template <typename VALUE_TYPE>
+inline bool
+stdlib_read_state([[maybe_unused]] const std::vector<std::uint8_t> &state,
+                  [[maybe_unused]] std::size_t &offset,
+                  [[maybe_unused]] StdLibPhiloxGaussian<VALUE_TYPE> &dist) {
+  return true;
+}
+
+} // namespace Private
+
+template <typename VALUE_TYPE, typename RNG_TYPE, typename DIST_TYPE,
+          typename TRANSFORM_TYPE = Private::IdentityTransform>
 struct StdLibRNG : public RNG<VALUE_TYPE> {
   virtual ~StdLibRNG() = default;
 
   sycl::queue queue;
   RNG_TYPE rng;
   DIST_TYPE dist;
+  TRANSFORM_TYPE transform;
 
   virtual int wait_get_samples([[maybe_unused]] VALUE_TYPE *d_ptr) override {
     return SUCCESS;
@@ -21,66 +385,265 @@ struct StdLibRNG : public RNG<VALUE_TYPE> {
 
   virtual int submit_get_samples(VALUE_TYPE *d_ptr,
                                  const std::size_t num_samples) override {
+    const int err = Private::stdlib_submit_samples(
+        this->queue, d_ptr, num_samples,
+        [&]() { return this->transform(this->dist(this->rng)); });
+    Private::stdlib_end_call(this->dist);
+    return err;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
     if (num_samples == 0) {
       return SUCCESS;
     }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
 
-    auto d_ptr_start = d_ptr;
-    constexpr std::size_t block_size = 1024;
+    // The samples are created on the host hence we write them directly through
+    // a host accessor and leave the SYCL runtime to move them to the device
+    // when they are next required.
+    sycl::host_accessor accessor(buffer, sycl::range<1>(num_samples),
+                                 sycl::id<1>(offset), sycl::write_only);
+    for (std::size_t ix = 0; ix < num_samples; ix++) {
+      accessor[ix] = this->transform(this->dist(this->rng));
+    }
+    Private::stdlib_end_call(this->dist);
 
-    // Create the random number in blocks and copy to device blockwise.
-    std::vector<VALUE_TYPE> block0(block_size);
-    std::vector<VALUE_TYPE> block1(block_size);
+    return SUCCESS;
+  }
 
-    VALUE_TYPE *ptr_tmp;
-    VALUE_TYPE *ptr_current = block0.data();
-    VALUE_TYPE *ptr_next = block1.data();
-    std::size_t num_numbers_moved = 0;
+  /**
+   * Save the state of the generator and the distribution, e.g. the 312
+   * words and the index of std::mt19937_64, see RNG::save_state.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    state.clear();
+    Private::write_state(state, this->platform_name);
+    Private::stdlib_write_state(state, this->rng);
+    Private::stdlib_write_state(state, this->dist);
+    return SUCCESS;
+  }
 
-    sycl::event e;
-    while (num_numbers_moved < num_samples) {
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    std::size_t offset = 0;
+    RNG_TYPE rng = this->rng;
+    DIST_TYPE dist = this->dist;
+    if (!Private::read_state_platform(state, offset, this->platform_name) ||
+        !Private::stdlib_read_state(state, offset, rng) ||
+        !Private::stdlib_read_state(state, offset, dist) ||
+        (offset != state.size())) {
+      return Private::invalid_state(this->platform_name);
+    }
+    this->rng = rng;
+    this->dist = dist;
+    return SUCCESS;
+  }
 
-      // Create a block of samples
-      const std::size_t num_to_memcpy =
-          std::min(static_cast<std::size_t>(block_size),
-                   num_samples - num_numbers_moved);
-      for (std::size_t ix = 0; ix < num_to_memcpy; ix++) {
-        ptr_current[ix] = this->dist(this->rng);
-      }
+  StdLibRNG(sycl::queue queue, std::uint64_t seed, DIST_TYPE dist,
+            TRANSFORM_TYPE transform = TRANSFORM_TYPE{})
+      : queue(queue), rng(RNG_TYPE{seed}), dist(dist), transform(transform) {
+    this->platform_name = "stdlib";
+  }
+};
 
-      // Wait until the previous block finished copying before starting this
-      // copy
-      e.wait_and_throw();
-      e = this->queue.memcpy(d_ptr, ptr_current,
-                             num_to_memcpy * sizeof(VALUE_TYPE));
-      d_ptr += num_to_memcpy;
-      num_numbers_moved += num_to_memcpy;
+/**
+ * Engine implementation for the C++ stdlib random implementations. The
+ * distributions are held as members, and are passed the parameters for each
+ * call, such that any state a distribution carries between samples is
+ * retained.
+ */
+template <typename VALUE_TYPE, typename RNG_TYPE>
+struct StdLibEngine : public Engine<VALUE_TYPE> {
+  virtual ~StdLibEngine() = default;
 
-      // swap ptr_current and ptr_next such that the new samples are written
-      // into ptr_next whilst ptr_current is being copied to the device.
-      ptr_tmp = ptr_current;
-      ptr_current = ptr_next;
-      ptr_next = ptr_tmp;
-    }
-    e.wait_and_throw();
+  RNG_TYPE rng;
+  std::uniform_real_distribution<VALUE_TYPE> uniform;
+  std::normal_distribution<VALUE_TYPE> normal;
+  std::exponential_distribution<VALUE_TYPE> exponential;
+  std::lognormal_distribution<VALUE_TYPE> lognormal;
+  std::gamma_distribution<VALUE_TYPE> gamma;
 
-    if (num_numbers_moved != num_samples) {
-      std::cout << "Failed to copy samples to device." << std::endl;
-      return -1;
-    }
+  virtual int submit_get_samples(Distribution::Uniform<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Uniform<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    const typename decltype(this->uniform)::param_type param(distribution.a,
+                                                             distribution.b);
+    return this->submit_host_samples(
+        layout, d_ptr, num_samples,
+        [&]() { return this->uniform(this->rng, param); });
+  }
+
+  virtual int submit_get_samples(Distribution::Normal<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Normal<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    const typename decltype(this->normal)::param_type param(
+        distribution.mean, distribution.stddev);
+    return this->submit_host_samples(
+        layout, d_ptr, num_samples,
+        [&]() { return this->normal(this->rng, param); });
+  }
+
+  virtual int
+  submit_get_samples(Distribution::Exponential<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  virtual int
+  submit_get_samples(Distribution::Exponential<VALUE_TYPE> distribution,
+                     const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    const typename decltype(this->exponential)::param_type param(
+        distribution.lambda);
+    return this->submit_host_samples(
+        layout, d_ptr, num_samples,
+        [&]() { return this->exponential(this->rng, param); });
+  }
+
+  virtual int
+  submit_get_samples(Distribution::LogNormal<VALUE_TYPE> distribution,
+                     VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  virtual int
+  submit_get_samples(Distribution::LogNormal<VALUE_TYPE> distribution,
+                     const Distribution::Strided layout, VALUE_TYPE *d_ptr,
+                     const std::size_t num_samples) override {
+    const typename decltype(this->lognormal)::param_type param(distribution.m,
+                                                               distribution.s);
+    return this->submit_host_samples(
+        layout, d_ptr, num_samples,
+        [&]() { return this->lognormal(this->rng, param); });
+  }
 
-    if (d_ptr != d_ptr_start + num_samples) {
-      std::cout << "Failed to copy samples to device." << std::endl;
-      return -2;
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    return this->submit_get_samples(distribution, Distribution::Strided{},
+                                    d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(Distribution::Gamma<VALUE_TYPE> distribution,
+                                 const Distribution::Strided layout,
+                                 VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    const typename decltype(this->gamma)::param_type param(distribution.alpha,
+                                                           distribution.beta);
+    return this->submit_host_samples(
+        layout, d_ptr, num_samples,
+        [&]() { return this->gamma(this->rng, param); });
+  }
+
+  /**
+   * Create samples on the host and write them to the device in a layout. A
+   * contiguous layout is copied directly, otherwise the samples pass through
+   * device staging space for two blocks.
+   *
+   * @param layout Strided layout the samples are written in.
+   * @param d_ptr Device pointer to fill with num_samples samples.
+   * @param num_samples Number of samples to place in device buffer.
+   * @param sample Callable which returns a new sample on each call.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename SAMPLE_TYPE>
+  int submit_host_samples(const Distribution::Strided layout,
+                          VALUE_TYPE *d_ptr, const std::size_t num_samples,
+                          SAMPLE_TYPE &&sample) {
+    int err = this->check_layout(layout);
+    if ((err != SUCCESS) || (num_samples == 0)) {
+      return err;
     }
+    if (layout.block_size == layout.stride) {
+      return Private::stdlib_submit_samples(this->queue, d_ptr, num_samples,
+                                            sample);
+    }
+    VALUE_TYPE *d_staging = this->get_scratch(2 * Private::stdlib_block_size);
+    if (d_staging == nullptr) {
+      return -103;
+    }
+    err = Private::stdlib_submit_strided_samples(
+        this->queue, layout, d_staging, d_ptr, num_samples, sample);
+    this->release_scratch(d_staging);
+    return err;
+  }
+
+  /**
+   * Save the state of the generator and of the distributions, which cache
+   * values between calls, see Engine::save_state.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    state.clear();
+    Private::write_state(state, this->platform_name);
+    Private::stdlib_write_state(state, this->rng);
+    Private::stdlib_write_state(state, this->uniform);
+    Private::stdlib_write_state(state, this->normal);
+    Private::stdlib_write_state(state, this->exponential);
+    Private::stdlib_write_state(state, this->lognormal);
+    Private::stdlib_write_state(state, this->gamma);
+    return SUCCESS;
+  }
 
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    std::size_t offset = 0;
+    RNG_TYPE rng = this->rng;
+    auto uniform = this->uniform;
+    auto normal = this->normal;
+    auto exponential = this->exponential;
+    auto lognormal = this->lognormal;
+    auto gamma = this->gamma;
+    if (!Private::read_state_platform(state, offset, this->platform_name) ||
+        !Private::stdlib_read_state(state, offset, rng) ||
+        !Private::stdlib_read_state(state, offset, uniform) ||
+        !Private::stdlib_read_state(state, offset, normal) ||
+        !Private::stdlib_read_state(state, offset, exponential) ||
+        !Private::stdlib_read_state(state, offset, lognormal) ||
+        !Private::stdlib_read_state(state, offset, gamma) ||
+        (offset != state.size())) {
+      return Private::invalid_state(this->platform_name);
+    }
+    this->rng = rng;
+    this->uniform = uniform;
+    this->normal = normal;
+    this->exponential = exponential;
+    this->lognormal = lognormal;
+    this->gamma = gamma;
     return SUCCESS;
   }
 
-  StdLibRNG(sycl::queue queue, std::uint64_t seed, DIST_TYPE dist)
-      : queue(queue), rng(RNG_TYPE{seed}), dist(dist) {
+  StdLibEngine(sycl::queue queue, std::uint64_t seed) : rng(RNG_TYPE{seed}) {
+    this->queue = queue;
     this->platform_name = "stdlib";
   }
+
+protected:
+  virtual int
+  wait_get_samples_internal([[maybe_unused]] VALUE_TYPE *d_ptr) override {
+    return SUCCESS;
+  }
 };
 
 /**
@@ -89,47 +652,164 @@ struct StdLibRNG : public RNG<VALUE_TYPE> {
 template <typename VALUE_TYPE>
 struct StdLibPlatform : public Platform<VALUE_TYPE> {
 
-  static const inline std::set<std::string> generators = {"mt19937_64"};
+  static const inline std::set<std::string> generators = {"mt19937_64",
+                                                          "philox4x32x10"};
 
   virtual ~StdLibPlatform() = default;
 
   virtual RNGSharedPtr<VALUE_TYPE>
-  create_rng([[maybe_unused]] Distribution::Uniform<VALUE_TYPE> distribution,
-             std::uint64_t seed, sycl::device device,
-             [[maybe_unused]] std::size_t device_index,
+  create_rng(Distribution::Uniform<VALUE_TYPE> distribution, std::uint64_t seed,
+             sycl::device device, std::size_t device_index,
              std::string generator_name) override {
+    return this->create_rng(distribution, Private::IdentityTransform{}, seed,
+                            device, device_index, generator_name);
+  }
+
+  virtual RNGSharedPtr<VALUE_TYPE>
+  create_rng(Distribution::Normal<VALUE_TYPE> distribution, std::uint64_t seed,
+             sycl::device device, std::size_t device_index,
+             std::string generator_name) override {
+    return this->create_rng(distribution, Private::IdentityTransform{}, seed,
+                            device, device_index, generator_name);
+  }
+
+  virtual RNGSharedPtr<std::uint32_t>
+  create_rng(Distribution::Bits<std::uint32_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) override {
+    return this->create_bits_rng(distribution, seed, device, device_index,
+                                 generator_name);
+  }
+
+  virtual RNGSharedPtr<std::uint64_t>
+  create_rng(Distribution::Bits<std::uint64_t> distribution,
+             std::uint64_t seed, sycl::device device, std::size_t device_index,
+             std::string generator_name) override {
+    return this->create_bits_rng(distribution, seed, device, device_index,
+                                 generator_name);
+  }
+
+  virtual EngineSharedPtr<VALUE_TYPE>
+  create_engine(std::uint64_t seed, sycl::device device,
+                std::size_t device_index,
+                std::string generator_name) override {
     generator_name = this->get_generator_name(generator_name, "mt19937_64");
-    if (this->check_generator_name(generator_name, this->generators)) {
-      sycl::queue queue(device);
-      return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(
-          std::make_shared<
-              StdLibRNG<VALUE_TYPE, std::mt19937_64,
-                        std::uniform_real_distribution<VALUE_TYPE>>>(
-              queue, seed,
-              std::uniform_real_distribution<VALUE_TYPE>(distribution.a,
-                                                         distribution.b)));
-    } else {
+    if (!this->check_generator_name(generator_name, this->generators)) {
       return nullptr;
     }
+    sycl::queue queue(device);
+    EngineSharedPtr<VALUE_TYPE> engine;
+    if (generator_name == "philox4x32x10") {
+      engine =
+          std::make_shared<StdLibEngine<VALUE_TYPE, Private::StdLibPhilox>>(
+              queue, seed);
+    } else {
+      engine = std::make_shared<StdLibEngine<VALUE_TYPE, std::mt19937_64>>(
+          queue, seed);
+    }
+    engine->device = device;
+    engine->device_index = device_index;
+    return engine;
   }
 
-  virtual RNGSharedPtr<VALUE_TYPE>
-  create_rng([[maybe_unused]] Distribution::Normal<VALUE_TYPE> distribution,
-             std::uint64_t seed, sycl::device device,
+  /**
+   * Create an RNG instance which applies a transform to each sample as it is
+   * created.
+   *
+   * @param distribution Distribution RNG samples should be from.
+   * @param transform Callable which maps a VALUE_TYPE sample to a VALUE_TYPE.
+   * @param seed Value to seed RNG with.
+   * @param device SYCL Device samples are to be created on.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param generator_name Name of preferred RNG generator method.
+   * @returns RNG instance. nullptr on Error.
+   */
+  template <typename TRANSFORM_TYPE>
+  RNGSharedPtr<VALUE_TYPE>
+  create_rng(Distribution::Uniform<VALUE_TYPE> distribution,
+             TRANSFORM_TYPE transform, std::uint64_t seed, sycl::device device,
              [[maybe_unused]] std::size_t device_index,
-             std::string generator_name) override {
+             std::string generator_name) {
+    return this->create_generator_rng<VALUE_TYPE>(
+        seed, device, generator_name,
+        std::uniform_real_distribution<VALUE_TYPE>(distribution.a,
+                                                   distribution.b),
+        Private::StdLibPhiloxUniform<VALUE_TYPE>(distribution.a,
+                                                 distribution.b),
+        transform);
+  }
+
+  /**
+   * Create an RNG instance which applies a transform to each sample as it is
+   * created.
+   *
+   * @param distribution Distribution RNG samples should be from.
+   * @param transform Callable which maps a VALUE_TYPE sample to a VALUE_TYPE.
+   * @param seed Value to seed RNG with.
+   * @param device SYCL Device samples are to be created on.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param generator_name Name of preferred RNG generator method.
+   * @returns RNG instance. nullptr on Error.
+   */
+  template <typename TRANSFORM_TYPE>
+  RNGSharedPtr<VALUE_TYPE>
+  create_rng(Distribution::Normal<VALUE_TYPE> distribution,
+             TRANSFORM_TYPE transform, std::uint64_t seed, sycl::device device,
+             [[maybe_unused]] std::size_t device_index,
+             std::string generator_name) {
+    return this->create_generator_rng<VALUE_TYPE>(
+        seed, device, generator_name,
+        std::normal_distribution<VALUE_TYPE>(distribution.mean,
+                                             distribution.stddev),
+        Private::StdLibPhiloxGaussian<VALUE_TYPE>(distribution.mean,
+                                                  distribution.stddev),
+        transform);
+  }
+
+protected:
+  template <typename BITS_TYPE>
+  inline RNGSharedPtr<BITS_TYPE>
+  create_bits_rng([[maybe_unused]] Distribution::Bits<BITS_TYPE> distribution,
+                  std::uint64_t seed, sycl::device device,
+                  [[maybe_unused]] std::size_t device_index,
+                  std::string generator_name) {
+    return this->create_generator_rng<BITS_TYPE>(
+        seed, device, generator_name, Private::StdLibBits<BITS_TYPE>{},
+        Private::StdLibBits<BITS_TYPE>{}, Private::IdentityTransform{});
+  }
+
+  /**
+   * Create an RNG instance with the generator of a name.
+   *
+   * @param seed Value to seed RNG with.
+   * @param device SYCL Device samples are to be created on.
+   * @param generator_name Name of preferred RNG generator method.
+   * @param dist Distribution to sample the mt19937_64 generator with.
+   * @param philox_dist Distribution to sample the philox4x32x10 generator
+   * with, which reproduces the oneMKL distribution methods.
+   * @param transform Callable which is applied to each sample.
+   * @returns RNG instance. nullptr on Error.
+   */
+  template <typename RNG_VALUE_TYPE, typename DIST_TYPE,
+            typename PHILOX_DIST_TYPE, typename TRANSFORM_TYPE>
+  inline RNGSharedPtr<RNG_VALUE_TYPE>
+  create_generator_rng(std::uint64_t seed, sycl::device device,
+                       std::string generator_name, DIST_TYPE dist,
+                       PHILOX_DIST_TYPE philox_dist,
+                       TRANSFORM_TYPE transform) {
     generator_name = this->get_generator_name(generator_name, "mt19937_64");
-    if (this->check_generator_name(generator_name, this->generators)) {
-      sycl::queue queue(device);
-      return std::dynamic_pointer_cast<RNG<VALUE_TYPE>>(
-          std::make_shared<StdLibRNG<VALUE_TYPE, std::mt19937_64,
-                                     std::normal_distribution<VALUE_TYPE>>>(
-              queue, seed,
-              std::normal_distribution<VALUE_TYPE>(distribution.mean,
-                                                   distribution.stddev)));
-    } else {
+    if (!this->check_generator_name(generator_name, this->generators)) {
       return nullptr;
     }
+    sycl::queue queue(device);
+    if (generator_name == "philox4x32x10") {
+      return std::make_shared<
+          StdLibRNG<RNG_VALUE_TYPE, Private::StdLibPhilox, PHILOX_DIST_TYPE,
+                    TRANSFORM_TYPE>>(queue, seed, philox_dist, transform);
+    }
+    return std::make_shared<StdLibRNG<RNG_VALUE_TYPE, std::mt19937_64,
+                                      DIST_TYPE, TRANSFORM_TYPE>>(
+        queue, seed, dist, transform);
   }
 };
 
@@ -0,0 +1,357 @@
+#ifndef _NESO_RNG_TOOLKIT_REDUCED_PRECISION_HPP_
+#define _NESO_RNG_TOOLKIT_REDUCED_PRECISION_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "rng.hpp"
+#include "typedefs.hpp"
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Trait for the floating point types which are sampled by packing several
+ * samples into each word of random bits.
+ */
+template <typename VALUE_TYPE>
+struct is_reduced_precision : std::false_type {};
+template <> struct is_reduced_precision<sycl::half> : std::true_type {};
+#ifdef SYCL_EXT_ONEAPI_BFLOAT16_MATH_FUNCTIONS
+template <>
+struct is_reduced_precision<sycl::ext::oneapi::bfloat16> : std::true_type {};
+#endif
+template <typename VALUE_TYPE>
+inline constexpr bool is_reduced_precision_v =
+    is_reduced_precision<VALUE_TYPE>::value;
+
+/**
+ * Get the largest value of a 16-bit floating point type which is less than a
+ * bound, i.e. the largest sample of a Uniform distribution on [a, b).
+ *
+ * @param b Upper bound.
+ * @returns Largest value of the type less than b.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE get_largest_value_below(const float b) {
+  static_assert(sizeof(VALUE_TYPE) == sizeof(std::uint16_t));
+  constexpr std::uint16_t sign_bit = 0x8000;
+  VALUE_TYPE value(b);
+  while (!(static_cast<float>(value) < b)) {
+    // Step to the adjacent value towards negative infinity.
+    std::uint16_t bits = sycl::bit_cast<std::uint16_t>(value);
+    if (bits == 0) {
+      bits = sign_bit | 1;
+    } else if (bits & sign_bit) {
+      bits++;
+    } else {
+      bits--;
+    }
+    value = sycl::bit_cast<VALUE_TYPE>(bits);
+  }
+  return value;
+}
+
+/**
+ * Maps a field of random bits to a uniform sample of a reduced precision
+ * type. Each 32-bit word of random bits is split into 32 / num_field_bits
+ * fields and each field produces one sample. The fields are only as wide as
+ * the precision of the output type requires. The conversion is callable from
+ * device code.
+ */
+template <typename VALUE_TYPE> struct ReducedPrecisionUniform;
+
+template <> struct ReducedPrecisionUniform<sycl::half> {
+  // The 11 bit significand of half requires 11 bits per sample, hence two
+  // samples are taken from each word.
+  static constexpr int num_field_bits = 16;
+  float a;
+  float width;
+  // a + width * u is rounded to half and may round up to b.
+  float max_value;
+
+  ReducedPrecisionUniform(Distribution::Uniform<sycl::half> distribution)
+      : a(static_cast<float>(distribution.a)),
+        width(static_cast<float>(distribution.b) -
+              static_cast<float>(distribution.a)),
+        max_value(static_cast<float>(get_largest_value_below<sycl::half>(
+            static_cast<float>(distribution.b)))) {}
+
+  inline sycl::half operator()(const std::uint32_t field) const {
+    const float u = static_cast<float>(field >> 5) * 0x1.0p-11f;
+    return static_cast<sycl::half>(
+        sycl::fmin(this->a + this->width * u, this->max_value));
+  }
+};
+
+#ifdef SYCL_EXT_ONEAPI_BFLOAT16_MATH_FUNCTIONS
+template <> struct ReducedPrecisionUniform<sycl::ext::oneapi::bfloat16> {
+  // The 8 bit significand of bfloat16 requires 8 bits per sample, hence four
+  // samples are taken from each word.
+  static constexpr int num_field_bits = 8;
+  float a;
+  float width;
+  // a + width * u is rounded to bfloat16 and may round up to b.
+  float max_value;
+
+  ReducedPrecisionUniform(
+      Distribution::Uniform<sycl::ext::oneapi::bfloat16> distribution)
+      : a(static_cast<float>(distribution.a)),
+        width(static_cast<float>(distribution.b) -
+              static_cast<float>(distribution.a)),
+        max_value(static_cast<float>(
+            get_largest_value_below<sycl::ext::oneapi::bfloat16>(
+                static_cast<float>(distribution.b)))) {}
+
+  inline sycl::ext::oneapi::bfloat16
+  operator()(const std::uint32_t field) const {
+    const float u = static_cast<float>(field) * 0x1.0p-8f;
+    return sycl::ext::oneapi::bfloat16(
+        sycl::fmin(this->a + this->width * u, this->max_value));
+  }
+};
+#endif
+
+template <> struct ReducedPrecisionUniform<std::uint16_t> {
+  static constexpr int num_field_bits = 16;
+
+  ReducedPrecisionUniform(
+      [[maybe_unused]] Distribution::UniformFixedPoint<std::uint16_t>
+          distribution) {}
+
+  inline std::uint16_t operator()(const std::uint32_t field) const {
+    return static_cast<std::uint16_t>(field);
+  }
+};
+
+template <> struct ReducedPrecisionUniform<std::uint8_t> {
+  static constexpr int num_field_bits = 8;
+
+  ReducedPrecisionUniform(
+      [[maybe_unused]] Distribution::UniformFixedPoint<std::uint8_t>
+          distribution) {}
+
+  inline std::uint8_t operator()(const std::uint32_t field) const {
+    return static_cast<std::uint8_t>(field);
+  }
+};
+
+} // namespace Private
+
+/**
+ * An RNG which produces uniform samples of a reduced precision type by
+ * packing several samples into each 32-bit word of random bits. The words
+ * are generated by a single kernel, which also unpacks them into the
+ * samples, with a Philox stream per block of four words. The key of the
+ * Philox streams is two words drawn from another RNG, hence the samples are
+ * reproducible for a given seed and advance the stream of that RNG.
+ */
+template <typename VALUE_TYPE>
+struct ReducedPrecisionRNG : public RNG<VALUE_TYPE> {
+  virtual ~ReducedPrecisionRNG() {
+    for (auto &key : this->key_allocations) {
+      sycl::free(key, this->queue);
+    }
+  }
+
+  /// The RNG which produces the keys of the Philox streams.
+  RNGSharedPtr<std::uint32_t> rng;
+  sycl::queue queue;
+  Private::ReducedPrecisionUniform<VALUE_TYPE> convert;
+
+  /// The key and kernel event for the pointers with samples in flight.
+  std::map<VALUE_TYPE *, std::pair<std::uint32_t *, sycl::event>> map_ptr_key;
+
+  virtual int wait_get_samples(VALUE_TYPE *d_ptr) override {
+    auto it = this->map_ptr_key.find(d_ptr);
+    if (it == this->map_ptr_key.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    std::uint32_t *d_key = it->second.first;
+    sycl::event event = it->second.second;
+    this->map_ptr_key.erase(it);
+    event.wait_and_throw();
+    this->release_key(d_key);
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    std::uint32_t *d_key = nullptr;
+    int err = SUCCESS;
+    if ((err = this->get_key(num_samples, &d_key)) != SUCCESS) {
+      return err;
+    }
+    sycl::event event{};
+    if (num_samples > 0) {
+      const auto k_convert = this->convert;
+      event = this->queue.parallel_for(
+          sycl::range<1>(get_num_blocks(num_samples)), [=](auto idx) {
+            generate_block(k_convert, d_key, num_samples, idx, d_ptr);
+          });
+    }
+    this->map_ptr_key[d_ptr] = {d_key, event};
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+    std::uint32_t *d_key = nullptr;
+    int err = SUCCESS;
+    if ((err = this->get_key(num_samples, &d_key)) != SUCCESS) {
+      return err;
+    }
+    const auto k_convert = this->convert;
+    this->queue
+        .submit([&](sycl::handler &cgh) {
+          sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                                  sycl::id<1>(offset), sycl::write_only);
+          cgh.parallel_for(
+              sycl::range<1>(get_num_blocks(num_samples)), [=](auto idx) {
+                generate_block(k_convert, d_key, num_samples, idx, accessor);
+              });
+        })
+        .wait_and_throw();
+    this->release_key(d_key);
+    return SUCCESS;
+  }
+
+  /**
+   * The state is the state of the RNG of the keys.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    return this->rng->save_state(state);
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    return this->rng->load_state(state);
+  }
+
+  /**
+   * Create an RNG which packs reduced precision samples into the words of
+   * Philox streams keyed by another RNG.
+   *
+   * @param rng RNG to draw the words of the Philox keys from.
+   * @param device SYCL device on which to generate the samples.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param convert Map from fields of random bits to samples.
+   */
+  ReducedPrecisionRNG(RNGSharedPtr<std::uint32_t> rng, sycl::device device,
+                      std::size_t device_index,
+                      Private::ReducedPrecisionUniform<VALUE_TYPE> convert)
+      : rng(rng), queue(device), convert(convert) {
+    this->device = device;
+    this->device_index = device_index;
+    this->platform_name = rng->platform_name;
+  }
+
+protected:
+  static constexpr int num_field_bits =
+      Private::ReducedPrecisionUniform<VALUE_TYPE>::num_field_bits;
+  static constexpr int values_per_word = 32 / num_field_bits;
+  /// Each Philox evaluation produces a block of four words.
+  static constexpr int values_per_block = 4 * values_per_word;
+
+  /// Device allocations for keys owned by this RNG.
+  std::vector<std::uint32_t *> key_allocations;
+  /// Device allocations for keys which are not in use.
+  std::vector<std::uint32_t *> key_free;
+
+  /**
+   * @param num_samples Number of samples.
+   * @returns Number of Philox blocks which hold num_samples samples.
+   */
+  static inline std::size_t get_num_blocks(const std::size_t num_samples) {
+    return (num_samples + values_per_block - 1) / values_per_block;
+  }
+
+  /**
+   * Generate a block of four words and write the samples held in the words.
+   * Callable from device code.
+   *
+   * @param convert Map from fields of random bits to samples.
+   * @param d_key Device pointer to the two words of the Philox key.
+   * @param num_samples Total number of samples.
+   * @param block_index Index of the block, i.e. of the Philox stream.
+   * @param output Device pointer or accessor to write the samples to.
+   */
+  template <typename OUTPUT_TYPE>
+  static inline void
+  generate_block(const Private::ReducedPrecisionUniform<VALUE_TYPE> &convert,
+                 const std::uint32_t *d_key, const std::size_t num_samples,
+                 const std::size_t block_index, OUTPUT_TYPE output) {
+    constexpr std::uint32_t mask = (std::uint32_t{1} << num_field_bits) - 1;
+    Private::PhiloxStream stream(d_key[0], d_key[1], block_index);
+    for (int wx = 0; wx < 4; wx++) {
+      const std::uint32_t word = stream.next_uint32();
+      for (int fx = 0; fx < values_per_word; fx++) {
+        const std::size_t index =
+            block_index * values_per_block + wx * values_per_word + fx;
+        if (index < num_samples) {
+          output[index] = convert((word >> (fx * num_field_bits)) & mask);
+        }
+      }
+    }
+  }
+
+  /**
+   * Draw the Philox key for a number of samples. The stream of the RNG of
+   * the keys is not advanced if there are no samples.
+   *
+   * @param[in] num_samples Number of samples.
+   * @param[out] d_key Device pointer to the two words of the key, nullptr if
+   * there are no samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int get_key(const std::size_t num_samples, std::uint32_t **d_key) {
+    *d_key = nullptr;
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (this->key_free.empty()) {
+      std::uint32_t *d_new_key =
+          sycl::malloc_device<std::uint32_t>(2, this->queue);
+      if (d_new_key == nullptr) {
+        std::cout << "Failed to allocate a key." << std::endl;
+        return -2;
+      }
+      this->key_allocations.push_back(d_new_key);
+      this->key_free.push_back(d_new_key);
+    }
+    *d_key = this->key_free.back();
+    this->key_free.pop_back();
+    int err = SUCCESS;
+    if ((err = this->rng->get_samples(*d_key, 2)) != SUCCESS) {
+      this->release_key(*d_key);
+      *d_key = nullptr;
+    }
+    return err;
+  }
+
+  /**
+   * Return a key from get_key such that it may be reused.
+   *
+   * @param d_key Device pointer from get_key or nullptr.
+   */
+  inline void release_key(std::uint32_t *d_key) {
+    if (d_key != nullptr) {
+      this->key_free.push_back(d_key);
+    }
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef _NESO_RNG_TOOLKIT_REJECTION_HPP_
+#define _NESO_RNG_TOOLKIT_REJECTION_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "scan.hpp"
+#include "typedefs.hpp"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Trait for the distributions which can propose candidates for rejection
+ * sampling of REAL_TYPE samples.
+ */
+template <typename PROPOSAL_TYPE, typename REAL_TYPE>
+inline constexpr bool is_rejection_proposal_v =
+    std::is_same_v<PROPOSAL_TYPE, Distribution::Uniform<REAL_TYPE>> ||
+    std::is_same_v<PROPOSAL_TYPE, Distribution::Normal<REAL_TYPE>> ||
+    std::is_same_v<PROPOSAL_TYPE, Distribution::Exponential<REAL_TYPE>>;
+
+/**
+ * Sample a candidate from a Uniform proposal. Callable from device code.
+ *
+ * @param distribution Proposal distribution.
+ * @param stream Source of random bits.
+ * @returns Candidate in (a, b).
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE
+sample_proposal(const Distribution::Uniform<REAL_TYPE> &distribution,
+                PhiloxStream &stream) {
+  return distribution.a +
+         (distribution.b - distribution.a) * stream.next_uniform<REAL_TYPE>();
+}
+
+/**
+ * Sample a candidate from a Normal proposal with the Box-Muller transform.
+ * Callable from device code.
+ *
+ * @param distribution Proposal distribution.
+ * @param stream Source of random bits.
+ * @returns Candidate.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE
+sample_proposal(const Distribution::Normal<REAL_TYPE> &distribution,
+                PhiloxStream &stream) {
+  using R = REAL_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  const R r = sycl::sqrt(R(-2.0) * sycl::log(stream.next_uniform<R>()));
+  const R z = r * sycl::cos(two_pi * stream.next_uniform<R>());
+  return distribution.mean + distribution.stddev * z;
+}
+
+/**
+ * Sample a candidate from an Exponential proposal. Callable from device code.
+ *
+ * @param distribution Proposal distribution.
+ * @param stream Source of random bits.
+ * @returns Candidate.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE
+sample_proposal(const Distribution::Exponential<REAL_TYPE> &distribution,
+                PhiloxStream &stream) {
+  return -sycl::log(stream.next_uniform<REAL_TYPE>()) / distribution.lambda;
+}
+
+/**
+ * Draw a candidate and test whether the candidate is accepted. Callable from
+ * device code.
+ *
+ * @param[in] distribution Rejection distribution to sample.
+ * @param[in, out] stream Source of random bits.
+ * @param[out] value Candidate.
+ * @returns True if the candidate is accepted.
+ */
+template <typename REAL_TYPE, typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+inline bool sample_candidate(
+    const Distribution::Rejection<PROPOSAL_TYPE, ACCEPT_TYPE> &distribution,
+    PhiloxStream &stream, REAL_TYPE &value) {
+  value = sample_proposal(distribution.proposal, stream);
+  const auto acceptance = distribution.accept(value);
+  // A predicate does not require a uniform sample for the test.
+  if constexpr (std::is_same_v<std::decay_t<decltype(acceptance)>, bool>) {
+    return acceptance;
+  } else {
+    return stream.next_uniform<REAL_TYPE>() <
+           static_cast<REAL_TYPE>(acceptance);
+  }
+}
+
+/// Number of candidates tested and compacted by each work item.
+inline constexpr std::size_t rejection_chunk_size = 256;
+/// Maximum ratio of the number of candidates in the first batch to the
+/// number of samples.
+inline constexpr std::size_t rejection_max_factor = 64;
+
+/**
+ * @param num_candidates Number of candidates.
+ * @returns The number of chunks the candidates are tested in.
+ */
+inline std::size_t get_num_rejection_chunks(const std::size_t num_candidates) {
+  return (num_candidates + rejection_chunk_size - 1) / rejection_chunk_size;
+}
+
+/**
+ * @param num_candidates Number of candidates.
+ * @returns The number of counts submit_rejection requires, i.e. the count of
+ * each chunk, the two totals and the workspace of the scan of the counts.
+ */
+inline std::size_t get_num_rejection_counts(const std::size_t num_candidates) {
+  const std::size_t num_chunks = get_num_rejection_chunks(num_candidates);
+  return num_chunks + 2 + get_scan_workspace_size(num_chunks + 1);
+}
+
+/**
+ * @param num_samples Number of samples.
+ * @param acceptance_rate Expected fraction of candidates which are accepted.
+ * @returns The number of candidates to draw in the first batch such that the
+ * expected number of accepted candidates is num_samples.
+ */
+inline std::size_t get_num_rejection_candidates(const std::size_t num_samples,
+                                                const double acceptance_rate) {
+  const double rate =
+      std::min(std::max(acceptance_rate, 1.0 / rejection_max_factor), 1.0);
+  return static_cast<std::size_t>(
+      std::ceil(static_cast<double>(num_samples) / rate));
+}
+
+/**
+ * Submit the kernels which draw num_samples samples by rejection without
+ * synchronising with the host. A first batch of num_candidates candidates is
+ * drawn and tested, candidate j uses Philox stream j, and the accepted
+ * candidates are compacted, in order, into d_ptr. Each sample which is not
+ * filled from the first batch then draws candidates from its own stream,
+ * num_candidates + i for sample i, until a candidate is accepted or
+ * max_trials candidates are rejected. On completion d_counts[num_chunks]
+ * holds the number of accepted candidates in the first batch and
+ * d_counts[num_chunks + 1] the number of samples which exceeded max_trials,
+ * these samples are NaN.
+ *
+ * @param queue SYCL queue to submit the kernels to.
+ * @param distribution Rejection distribution to sample.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_candidates Device pointer to space for num_candidates values.
+ * @param d_counts Device pointer to space for
+ * get_num_rejection_counts(num_candidates) counts.
+ * @param d_ptr Device pointer to fill with num_samples samples.
+ * @param num_samples Number of samples.
+ * @param num_candidates Number of candidates in the first batch.
+ * @param event Event the first kernel depends on, e.g. the event for the key.
+ * @returns Event for the last kernel.
+ */
+template <typename REAL_TYPE, typename PROPOSAL_TYPE, typename ACCEPT_TYPE>
+inline sycl::event submit_rejection(
+    sycl::queue &queue,
+    const Distribution::Rejection<PROPOSAL_TYPE, ACCEPT_TYPE> distribution,
+    const REAL_TYPE *d_key, REAL_TYPE *d_candidates, std::uint64_t *d_counts,
+    REAL_TYPE *d_ptr, const std::size_t num_samples,
+    const std::size_t num_candidates, sycl::event event = sycl::event{}) {
+  const std::size_t num_chunks = get_num_rejection_chunks(num_candidates);
+  const std::size_t k_max_trials = distribution.max_trials;
+  constexpr REAL_TYPE rejected = std::numeric_limits<REAL_TYPE>::quiet_NaN();
+
+  // Draw and test the first batch, rejected candidates are stored as NaN.
+  auto event_test =
+      queue.parallel_for(sycl::range<1>(num_chunks), event, [=](auto idx) {
+        const std::size_t cx = idx;
+        const std::uint32_t key_0 = get_key_word(d_key[0], d_key[1]);
+        const std::uint32_t key_1 = get_key_word(d_key[2], d_key[3]);
+        const std::size_t start = cx * rejection_chunk_size;
+        const std::size_t end =
+            std::min(start + rejection_chunk_size, num_candidates);
+        std::uint64_t count = 0;
+        for (std::size_t jx = start; jx < end; jx++) {
+          PhiloxStream stream(key_0, key_1, jx);
+          REAL_TYPE value;
+          const bool accepted = sample_candidate(distribution, stream, value);
+          d_candidates[jx] = accepted ? value : rejected;
+          count += accepted ? 1 : 0;
+        }
+        d_counts[cx] = count;
+        if (cx == 0) {
+          d_counts[num_chunks] = 0;
+          d_counts[num_chunks + 1] = 0;
+        }
+      });
+
+  // Convert the counts per chunk into the offset of each chunk, the trailing
+  // zero becomes the number of accepted candidates.
+  auto event_scan = submit_exclusive_scan(
+      queue, d_counts, num_chunks + 1, d_counts + num_chunks + 2, event_test);
+
+  auto event_compact =
+      queue.parallel_for(sycl::range<1>(num_chunks), event_scan, [=](auto idx) {
+        const std::size_t cx = idx;
+        const std::size_t start = cx * rejection_chunk_size;
+        const std::size_t end =
+            std::min(start + rejection_chunk_size, num_candidates);
+        std::uint64_t offset = d_counts[cx];
+        for (std::size_t jx = start; (jx < end) && (offset < num_samples);
+             jx++) {
+          const REAL_TYPE value = d_candidates[jx];
+          if (!sycl::isnan(value)) {
+            d_ptr[offset++] = value;
+          }
+        }
+      });
+
+  // Fill the samples which the first batch did not fill.
+  return queue.parallel_for(
+      sycl::range<1>(num_samples), event_compact, [=](auto idx) {
+        const std::size_t ix = idx;
+        if (ix < d_counts[num_chunks]) {
+          return;
+        }
+        PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                            get_key_word(d_key[2], d_key[3]),
+                            num_candidates + ix);
+        for (std::size_t tx = 0; tx < k_max_trials; tx++) {
+          REAL_TYPE value;
+          if (sample_candidate(distribution, stream, value)) {
+            d_ptr[ix] = value;
+            return;
+          }
+        }
+        d_ptr[ix] = rejected;
+        sycl::atomic_ref<std::uint64_t, sycl::memory_order::relaxed,
+                         sycl::memory_scope::device,
+                         sycl::access::address_space::global_space>
+            num_failed(d_counts[num_chunks + 1]);
+        num_failed.fetch_add(1);
+      });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
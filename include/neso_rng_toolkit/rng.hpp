@@ -2,6 +2,8 @@
 #define _NESO_RNG_TOOLKIT_RNG_HPP_
 
 #include "typedefs.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace NESO::RNGToolkit {
 
@@ -36,6 +38,22 @@ template <typename VALUE_TYPE> struct RNG {
    */
   virtual int wait_get_samples(VALUE_TYPE *d_ptr) = 0;
 
+  /**
+   * Start to draw random samples from the RNG into a SYCL buffer. The samples
+   * are written into the buffer elements [offset, offset + num_samples). The
+   * SYCL runtime tracks the dependencies on the buffer, hence there is no
+   * corresponding wait call, subsequent accessors to the buffer will wait for
+   * the samples to be written.
+   *
+   * @param[in, out] buffer SYCL buffer to fill with num_samples samples.
+   * @param[in] offset Index of the first element in the buffer to populate.
+   * @param[in] num_samples Number of samples to place in the buffer.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) = 0;
+
   /**
    * Draw random samples from the RNG. Internally this function calls
    * submit_get_samples and wait_get_samples.
@@ -51,6 +69,137 @@ template <typename VALUE_TYPE> struct RNG {
     }
     return this->wait_get_samples(d_ptr);
   }
+
+  /**
+   * Draw a number of samples which is potentially far larger than can be
+   * stored on the device by generating the samples in chunks. Two device
+   * chunks are allocated and used alternately: whilst the consumer processes
+   * one chunk the next chunk of samples is drawn into the other. The consumer
+   * is called as
+   *
+   *    sycl::event consumer(VALUE_TYPE *d_chunk, std::size_t offset,
+   *                         std::size_t chunk_num_samples);
+   *
+   * where d_chunk is a device pointer holding chunk_num_samples samples and
+   * offset is the index of the first sample of the chunk in the overall
+   * stream. The consumer should submit its work to the device and return
+   * the event which completes when it has finished reading d_chunk. The
+   * consumer must not retain d_chunk beyond this event.
+   *
+   * @param[in] queue SYCL queue on which to allocate the device chunks.
+   * @param[in] num_samples Total number of samples to draw.
+   * @param[in] chunk_size Maximum number of samples in each chunk.
+   * @param[in] consumer Callable to process each chunk of samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename CONSUMER_TYPE>
+  int stream_samples(sycl::queue &queue, const std::size_t num_samples,
+                     const std::size_t chunk_size, CONSUMER_TYPE consumer) {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (chunk_size == 0) {
+      std::cout << "Cannot stream samples with a chunk size of zero."
+                << std::endl;
+      return -1;
+    }
+
+    const std::size_t num_chunk_samples = std::min(chunk_size, num_samples);
+    VALUE_TYPE *d_chunks[2] = {
+        sycl::malloc_device<VALUE_TYPE>(num_chunk_samples, queue),
+        sycl::malloc_device<VALUE_TYPE>(num_chunk_samples, queue)};
+    sycl::event events[2];
+
+    int err = SUCCESS;
+    if ((d_chunks[0] == nullptr) || (d_chunks[1] == nullptr)) {
+      std::cout << "Failed to allocate device chunks of size " +
+                       std::to_string(num_chunk_samples) + "."
+                << std::endl;
+      err = -2;
+    }
+
+    std::size_t offset = 0;
+    std::size_t chunk_index = 0;
+    while ((err == SUCCESS) && (offset < num_samples)) {
+      const std::size_t chunk_num_samples =
+          std::min(num_chunk_samples, num_samples - offset);
+      VALUE_TYPE *d_chunk = d_chunks[chunk_index];
+
+      // Wait for the consumer of the previous samples in this chunk to
+      // complete before overwriting them. The consumer of the other chunk
+      // continues to execute whilst the new samples are drawn.
+      events[chunk_index].wait_and_throw();
+      if ((err = this->get_samples(d_chunk, chunk_num_samples)) != SUCCESS) {
+        break;
+      }
+      events[chunk_index] = consumer(d_chunk, offset, chunk_num_samples);
+
+      offset += chunk_num_samples;
+      chunk_index = (chunk_index + 1) % 2;
+    }
+
+    for (int cx = 0; cx < 2; cx++) {
+      events[cx].wait_and_throw();
+      if (d_chunks[cx] != nullptr) {
+        sycl::free(d_chunks[cx], queue);
+      }
+    }
+    return err;
+  }
+
+  /**
+   * Save the state of the RNG to a compact binary blob. An RNG created with
+   * the same arguments which loads the blob continues the stream of this RNG
+   * exactly. Samples which are being drawn should be waited for before the
+   * state is saved.
+   *
+   * @param[out] state Blob the state is written to.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int save_state([[maybe_unused]] std::vector<std::uint8_t> &state) {
+    std::cout << "The " + this->platform_name +
+                     " RNG does not support saving its state."
+              << std::endl;
+    return -6;
+  }
+
+  /**
+   * Load a state saved by save_state of an RNG created with the same
+   * arguments.
+   *
+   * @param[in] state Blob the state is read from.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  virtual int
+  load_state([[maybe_unused]] const std::vector<std::uint8_t> &state) {
+    std::cout << "The " + this->platform_name +
+                     " RNG does not support loading its state."
+              << std::endl;
+    return -6;
+  }
+
+protected:
+  /**
+   * Helper function to check that a range of elements is contained in a
+   * buffer.
+   *
+   * @param buffer SYCL buffer to check the range against.
+   * @param offset Index of the first element in the range.
+   * @param num_samples Number of elements in the range.
+   * @returns True if the range is contained in the buffer.
+   */
+  static inline bool check_buffer_range(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                        const std::size_t offset,
+                                        const std::size_t num_samples) {
+    if ((offset > buffer.size()) || (num_samples > buffer.size() - offset)) {
+      std::cout << "Buffer of size " + std::to_string(buffer.size()) +
+                       " cannot hold " + std::to_string(num_samples) +
+                       " samples at offset " + std::to_string(offset) + "."
+                << std::endl;
+      return false;
+    }
+    return true;
+  }
 };
 
 template <typename VALUE_TYPE>
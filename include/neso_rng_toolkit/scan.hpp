@@ -0,0 +1,82 @@
+#ifndef _NESO_RNG_TOOLKIT_SCAN_HPP_
+#define _NESO_RNG_TOOLKIT_SCAN_HPP_
+
+#include "typedefs.hpp"
+#include <algorithm>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/// Number of values each work item of a scan processes sequentially.
+inline constexpr std::size_t scan_block_size = 1024;
+
+/**
+ * @param num_values Number of values to scan.
+ * @returns Number of workspace values submit_exclusive_scan requires.
+ */
+inline std::size_t get_scan_workspace_size(std::size_t num_values) {
+  std::size_t size = 0;
+  while (num_values > scan_block_size) {
+    num_values = (num_values + scan_block_size - 1) / scan_block_size;
+    size += num_values;
+  }
+  return size;
+}
+
+/**
+ * Submit kernels which replace values with their exclusive prefix sum, i.e.
+ * value ix is replaced with the sum of the values before ix. The scan is
+ * computed in two levels: each work item scans a block of values and the
+ * sums of the blocks are scanned recursively, hence no kernel processes more
+ * than scan_block_size values per work item. To also compute the total, scan
+ * one additional value which is zero.
+ *
+ * @param queue SYCL queue to submit the kernels to.
+ * @param d_values Device pointer to num_values values to scan in place.
+ * @param num_values Number of values.
+ * @param d_workspace Device pointer to get_scan_workspace_size(num_values)
+ * values.
+ * @param event Event the first kernel depends on.
+ * @returns Event for the last kernel.
+ */
+template <typename T>
+inline sycl::event submit_exclusive_scan(sycl::queue &queue, T *d_values,
+                                         const std::size_t num_values,
+                                         T *d_workspace,
+                                         sycl::event event = sycl::event{}) {
+  auto scan_block = [=](const std::size_t start, const std::size_t end) {
+    T sum = T(0);
+    for (std::size_t ix = start; ix < end; ix++) {
+      const T value = d_values[ix];
+      d_values[ix] = sum;
+      sum += value;
+    }
+    return sum;
+  };
+  if (num_values <= scan_block_size) {
+    return queue.single_task(event, [=]() { scan_block(0, num_values); });
+  }
+
+  const std::size_t num_blocks =
+      (num_values + scan_block_size - 1) / scan_block_size;
+  T *d_sums = d_workspace;
+  event = queue.parallel_for(sycl::range<1>(num_blocks), event, [=](auto idx) {
+    const std::size_t bx = idx;
+    const std::size_t start = bx * scan_block_size;
+    d_sums[bx] =
+        scan_block(start, std::min(start + scan_block_size, num_values));
+  });
+  event = submit_exclusive_scan(queue, d_sums, num_blocks,
+                                d_workspace + num_blocks, event);
+  return queue.parallel_for(sycl::range<1>(num_values), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    d_values[ix] += d_sums[ix / scan_block_size];
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef _NESO_RNG_TOOLKIT_SOBOL_HPP_
+#define _NESO_RNG_TOOLKIT_SOBOL_HPP_
+
+#include "distribution.hpp"
+#include "rng.hpp"
+#include "state.hpp"
+#include "typedefs.hpp"
+#include <map>
+#include <vector>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/// The maximum dimension of the Sobol sequence.
+constexpr std::size_t sobol_max_ndim = 1024;
+/// The number of bits of each value, i.e. the sequence has 2^32 points.
+constexpr std::size_t sobol_num_bits = 32;
+/// The number of initial direction numbers of dimensions 2 to sobol_max_ndim.
+constexpr std::size_t sobol_num_initial_numbers = 12092;
+
+extern const std::uint16_t sobol_polynomials[sobol_max_ndim - 1];
+extern const std::uint16_t sobol_initial_numbers[sobol_num_initial_numbers];
+
+/**
+ * Compute the direction numbers of the first ndim dimensions of the Sobol
+ * sequence.
+ *
+ * @param ndim Number of dimensions, at most sobol_max_ndim.
+ * @returns ndim * sobol_num_bits direction numbers where direction number b
+ * of dimension d is entry d * sobol_num_bits + b.
+ */
+std::vector<std::uint32_t> get_sobol_directions(const std::size_t ndim);
+
+/**
+ * The finaliser of SplitMix64 which maps a 64-bit value to a well mixed
+ * 64-bit value. Callable from device code.
+ */
+inline std::uint64_t sobol_hash(std::uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ull;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBull;
+  value ^= value >> 31;
+  return value;
+}
+
+/**
+ * Apply an Owen (nested uniform) scramble to a value of the sequence. Bit b,
+ * counted from the most significant bit, is flipped by a random bit which is
+ * a function of the seed and the b more significant bits of the value, i.e.
+ * of the node of the binary tree of elementary intervals which contains the
+ * value. Callable from device code.
+ *
+ * @param value Value of the sequence as a 32-bit fraction.
+ * @param seed Seed of the scramble of the dimension.
+ * @returns Scrambled value.
+ */
+inline std::uint32_t sobol_scramble(const std::uint32_t value,
+                                    const std::uint64_t seed) {
+  std::uint32_t scrambled = value;
+  for (std::size_t bx = 0; bx < sobol_num_bits; bx++) {
+    const std::uint64_t prefix =
+        (bx == 0) ? 0 : value >> (sobol_num_bits - bx);
+    const std::uint64_t node = (std::uint64_t{1} << bx) | prefix;
+    const std::uint64_t flip =
+        sobol_hash(seed + node * 0x9E3779B97F4A7C15ull) >> 63;
+    scrambled ^= static_cast<std::uint32_t>(flip)
+                 << (sobol_num_bits - 1 - bx);
+  }
+  return scrambled;
+}
+
+/**
+ * Map a 32-bit fraction to the open interval (0, 1) with the resolution of
+ * REAL_TYPE. The value is offset by one half of the resolution such that each
+ * value remains in the elementary interval of the fraction. Callable from
+ * device code.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE sobol_to_uniform(const std::uint32_t value);
+
+template <> inline double sobol_to_uniform<double>(const std::uint32_t value) {
+  return (static_cast<double>(value) + 0.5) * 0x1.0p-32;
+}
+
+template <> inline float sobol_to_uniform<float>(const std::uint32_t value) {
+  return (static_cast<float>(value >> 8) + 0.5f) * 0x1.0p-24f;
+}
+
+} // namespace Private
+
+/**
+ * An RNG which draws the points of the Sobol quasi-random sequence, see
+ * Distribution::Sobol. The sequence is computed by a SYCL kernel, hence it is
+ * identical on every platform and device. Each value is computed
+ * independently from the Gray code of the index of its point, such that the
+ * RNG skips ahead in the sequence at no cost.
+ */
+template <typename VALUE_TYPE> struct SobolRNG : public RNG<VALUE_TYPE> {
+  virtual ~SobolRNG() {
+    if (this->d_directions != nullptr) {
+      sycl::free(this->d_directions, this->queue);
+    }
+    if (this->d_seeds != nullptr) {
+      sycl::free(this->d_seeds, this->queue);
+    }
+  }
+
+  sycl::queue queue;
+  Distribution::Sobol<VALUE_TYPE> distribution;
+  /// The index of the next point of the sequence.
+  std::uint64_t index{0};
+  /// Device pointer to the direction numbers of each dimension.
+  std::uint32_t *d_directions{nullptr};
+  /// Device pointer to the scramble seed of each dimension, nullptr if the
+  /// sequence is not scrambled.
+  std::uint64_t *d_seeds{nullptr};
+
+  /// The events of the kernels which write to the pointers.
+  std::map<VALUE_TYPE *, sycl::event> map_ptr_event;
+
+  virtual int wait_get_samples(VALUE_TYPE *d_ptr) override {
+    auto it = this->map_ptr_event.find(d_ptr);
+    if (it == this->map_ptr_event.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    it->second.wait_and_throw();
+    this->map_ptr_event.erase(it);
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    std::uint64_t first = 0;
+    int err = SUCCESS;
+    if ((err = this->get_first_point(num_samples, &first)) != SUCCESS) {
+      return err;
+    }
+    sycl::event event{};
+    if (num_samples > 0) {
+      const auto k_writer = this->get_writer(first, num_samples);
+      event = this->queue.parallel_for(
+          sycl::range<1>(num_samples),
+          [=](auto idx) { k_writer(idx, d_ptr); });
+    }
+    this->map_ptr_event[d_ptr] = event;
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+    std::uint64_t first = 0;
+    int err = SUCCESS;
+    if ((err = this->get_first_point(num_samples, &first)) != SUCCESS) {
+      return err;
+    }
+    const auto k_writer = this->get_writer(first, num_samples);
+    this->queue.submit([&](sycl::handler &cgh) {
+      sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                              sycl::id<1>(offset), sycl::write_only);
+      cgh.parallel_for(sycl::range<1>(num_samples),
+                       [=](auto idx) { k_writer(idx, accessor); });
+    });
+    return SUCCESS;
+  }
+
+  /**
+   * The state is the index of the next point of the sequence.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    state.clear();
+    Private::write_state(state, this->platform_name);
+    Private::write_state(state, this->index);
+    return SUCCESS;
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    std::size_t offset = 0;
+    std::uint64_t index = 0;
+    if (!Private::read_state_platform(state, offset, this->platform_name) ||
+        !Private::read_state(state, offset, index) ||
+        (offset != state.size()) ||
+        (index > (std::uint64_t{1} << Private::sobol_num_bits))) {
+      return Private::invalid_state(this->platform_name);
+    }
+    this->index = index;
+    return SUCCESS;
+  }
+
+  /**
+   * Create an RNG which draws the points of the Sobol sequence. The device
+   * pointers are nullptr if the device allocations failed.
+   *
+   * @param device SYCL device on which to compute the sequence.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param distribution Dimension, scramble and offset of the sequence.
+   * @param seed Value to seed the scramble with.
+   */
+  SobolRNG(sycl::device device, std::size_t device_index,
+           Distribution::Sobol<VALUE_TYPE> distribution, std::uint64_t seed)
+      : queue(device), distribution(distribution),
+        index(distribution.offset) {
+    this->device = device;
+    this->device_index = device_index;
+    this->platform_name = "sycl";
+
+    const std::size_t ndim = distribution.ndim;
+    const auto directions = Private::get_sobol_directions(ndim);
+    this->d_directions =
+        sycl::malloc_device<std::uint32_t>(directions.size(), this->queue);
+    if (this->d_directions == nullptr) {
+      return;
+    }
+    this->queue
+        .memcpy(this->d_directions, directions.data(),
+                directions.size() * sizeof(std::uint32_t))
+        .wait_and_throw();
+
+    if (distribution.scrambled) {
+      std::vector<std::uint64_t> seeds(ndim);
+      for (std::size_t dx = 0; dx < ndim; dx++) {
+        seeds.at(dx) = Private::sobol_hash(seed + Private::sobol_hash(dx));
+      }
+      this->d_seeds = sycl::malloc_device<std::uint64_t>(ndim, this->queue);
+      if (this->d_seeds == nullptr) {
+        sycl::free(this->d_directions, this->queue);
+        this->d_directions = nullptr;
+        return;
+      }
+      this->queue
+          .memcpy(this->d_seeds, seeds.data(), ndim * sizeof(std::uint64_t))
+          .wait_and_throw();
+    }
+  }
+
+protected:
+  /**
+   * Device copyable callable which writes value ix of the points
+   * first, first + 1, ... of the sequence.
+   */
+  struct Writer {
+    const std::uint32_t *d_directions;
+    const std::uint64_t *d_seeds;
+    std::size_t ndim;
+    bool soa;
+    std::uint64_t first;
+    std::size_t num_points;
+
+    template <typename OUTPUT_TYPE>
+    inline void operator()(const std::size_t ix, OUTPUT_TYPE output) const {
+      const std::size_t px = soa ? ix % num_points : ix / ndim;
+      const std::size_t dx = soa ? ix / num_points : ix % ndim;
+      const std::uint64_t point = first + px;
+      std::uint64_t gray = point ^ (point >> 1);
+      const std::uint32_t *directions =
+          d_directions + dx * Private::sobol_num_bits;
+      std::uint32_t value = 0;
+      for (std::size_t bx = 0; gray != 0; bx++, gray >>= 1) {
+        if (gray & 1) {
+          value ^= directions[bx];
+        }
+      }
+      if (d_seeds != nullptr) {
+        value = Private::sobol_scramble(value, d_seeds[dx]);
+      }
+      output[ix] = Private::sobol_to_uniform<VALUE_TYPE>(value);
+    }
+  };
+
+  /**
+   * @param first Index of the first point to write.
+   * @param num_samples Number of values to write.
+   * @returns Callable which writes the values of the points.
+   */
+  inline Writer get_writer(const std::uint64_t first,
+                           const std::size_t num_samples) const {
+    return Writer{this->d_directions,
+                  this->d_seeds,
+                  this->distribution.ndim,
+                  this->distribution.layout == Distribution::Layout::SoA,
+                  first,
+                  num_samples / this->distribution.ndim};
+  }
+
+  /**
+   * Advance the sequence by the points which hold a number of values.
+   *
+   * @param[in] num_samples Number of values to draw.
+   * @param[out] first Index of the first point to draw.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int get_first_point(const std::size_t num_samples,
+                             std::uint64_t *first) {
+    const std::size_t ndim = this->distribution.ndim;
+    if (num_samples % ndim != 0) {
+      std::cout << "The number of samples, " + std::to_string(num_samples) +
+                       ", is not a multiple of the dimension " +
+                       std::to_string(ndim) + "."
+                << std::endl;
+      return -4;
+    }
+    const std::uint64_t num_points = num_samples / ndim;
+    constexpr std::uint64_t max_points = std::uint64_t{1}
+                                         << Private::sobol_num_bits;
+    if ((this->index > max_points) ||
+        (num_points > max_points - this->index)) {
+      std::cout << "The Sobol sequence has no more than 2^32 points."
+                << std::endl;
+      return -5;
+    }
+    *first = this->index;
+    this->index += num_points;
+    return SUCCESS;
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
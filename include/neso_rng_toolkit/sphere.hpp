@@ -0,0 +1,115 @@
+#ifndef _NESO_RNG_TOOLKIT_SPHERE_HPP_
+#define _NESO_RNG_TOOLKIT_SPHERE_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+#include <type_traits>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Sample a direction uniformly on the unit sphere without rejection. In 3D
+ * the z component of a uniform direction is uniform on (-1, 1) (Archimedes),
+ * hence each direction uses exactly two uniform samples. Callable from device
+ * code.
+ *
+ * @param[in] ndim Dimension of the direction, 1, 2 or 3.
+ * @param[in, out] stream Source of random bits.
+ * @param[out] direction Components of the direction.
+ */
+template <typename REAL_TYPE>
+inline void sample_unit_sphere(const std::size_t ndim, PhiloxStream &stream,
+                               REAL_TYPE direction[3]) {
+  using R = REAL_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  if (ndim == 1) {
+    direction[0] = R(1.0) - R(2.0) * static_cast<R>(stream.next_uint32() & 1);
+  } else if (ndim == 2) {
+    const R phi = two_pi * stream.next_uniform<R>();
+    direction[0] = sycl::cos(phi);
+    direction[1] = sycl::sin(phi);
+  } else {
+    const R z = R(2.0) * stream.next_uniform<R>() - R(1.0);
+    const R phi = two_pi * stream.next_uniform<R>();
+    const R r = sycl::sqrt(sycl::fmax(R(1.0) - z * z, R(0.0)));
+    direction[0] = r * sycl::cos(phi);
+    direction[1] = r * sycl::sin(phi);
+    direction[2] = z;
+  }
+}
+
+/**
+ * Sample a vector uniformly in the unit ball without rejection. The vector is
+ * a uniform direction scaled by a radius u^(1/ndim) where u is uniform on
+ * (0, 1). Callable from device code.
+ *
+ * @param[in] ndim Dimension of the vector, 1, 2 or 3.
+ * @param[in, out] stream Source of random bits.
+ * @param[out] vector Components of the vector.
+ */
+template <typename REAL_TYPE>
+inline void sample_unit_ball(const std::size_t ndim, PhiloxStream &stream,
+                             REAL_TYPE vector[3]) {
+  using R = REAL_TYPE;
+  sample_unit_sphere(ndim, stream, vector);
+  const R u = stream.next_uniform<R>();
+  const R radius =
+      (ndim == 1) ? u : ((ndim == 2) ? sycl::sqrt(u) : sycl::cbrt(u));
+  for (std::size_t dx = 0; dx < ndim; dx++) {
+    vector[dx] *= radius;
+  }
+}
+
+/**
+ * Submit a kernel which samples vectors on the unit sphere or in the unit
+ * ball. Each vector uses its own Philox stream.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution UnitSphere or UnitBall distribution to sample.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to write ndim * num_samples values to.
+ * @param num_samples Number of vectors.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename REAL_TYPE, typename DISTRIBUTION_TYPE>
+inline sycl::event submit_sphere(sycl::queue &queue,
+                                 const DISTRIBUTION_TYPE distribution,
+                                 const REAL_TYPE *d_key, REAL_TYPE *d_ptr,
+                                 const std::size_t num_samples,
+                                 sycl::event event = sycl::event{},
+                                 const Distribution::Strided layout =
+                                     Distribution::Strided{}) {
+  constexpr bool k_ball =
+      std::is_same_v<DISTRIBUTION_TYPE, Distribution::UnitBall<REAL_TYPE>>;
+  const std::size_t k_ndim = distribution.ndim;
+  const bool k_soa = distribution.layout == Distribution::Layout::SoA;
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    REAL_TYPE vector[3];
+    if constexpr (k_ball) {
+      sample_unit_ball(k_ndim, stream, vector);
+    } else {
+      sample_unit_sphere(k_ndim, stream, vector);
+    }
+    for (std::size_t dx = 0; dx < k_ndim; dx++) {
+      const std::size_t index =
+          k_soa ? dx * num_samples + ix : ix * k_ndim + dx;
+      d_ptr[Distribution::get_strided_index(layout, index)] = vector[dx];
+    }
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef _NESO_RNG_TOOLKIT_STATE_HPP_
+#define _NESO_RNG_TOOLKIT_STATE_HPP_
+
+#include "typedefs.hpp"
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Append a trivially copyable value to a state blob.
+ *
+ * @param[in, out] state Blob to append the value to.
+ * @param[in] value Value to append.
+ */
+template <typename T>
+inline void write_state(std::vector<std::uint8_t> &state, const T &value) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable values are written as bytes.");
+  const std::size_t offset = state.size();
+  state.resize(offset + sizeof(T));
+  std::memcpy(state.data() + offset, &value, sizeof(T));
+}
+
+/**
+ * Append a string to a state blob as its length followed by its characters.
+ */
+inline void write_state(std::vector<std::uint8_t> &state,
+                        const std::string &value) {
+  write_state(state, static_cast<std::uint64_t>(value.size()));
+  state.insert(state.end(), value.begin(), value.end());
+}
+
+/**
+ * Read a trivially copyable value from a state blob.
+ *
+ * @param[in] state Blob to read the value from.
+ * @param[in, out] offset Offset of the value in the blob, advanced past the
+ * value.
+ * @param[out] value Value read from the blob.
+ * @returns False if the blob is too short to hold the value.
+ */
+template <typename T>
+inline bool read_state(const std::vector<std::uint8_t> &state,
+                       std::size_t &offset, T &value) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable values are read as bytes.");
+  if ((offset > state.size()) || (state.size() - offset < sizeof(T))) {
+    return false;
+  }
+  std::memcpy(&value, state.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+/**
+ * Read a string written by write_state from a state blob.
+ */
+inline bool read_state(const std::vector<std::uint8_t> &state,
+                       std::size_t &offset, std::string &value) {
+  std::uint64_t size = 0;
+  if (!read_state(state, offset, size) || (state.size() - offset < size)) {
+    return false;
+  }
+  value.assign(state.begin() + offset, state.begin() + offset + size);
+  offset += size;
+  return true;
+}
+
+/**
+ * Append the state of a stdlib random number engine, e.g. std::mt19937_64, to
+ * a state blob. The state_size words of the engine are followed by the index
+ * of the next word, which is state_size if the representation of the engine
+ * does not hold the index.
+ *
+ * @param[in, out] state Blob to append the engine to.
+ * @param[in] engine Engine to append.
+ */
+template <typename ENGINE_TYPE>
+inline void write_engine_state(std::vector<std::uint8_t> &state,
+                               const ENGINE_TYPE &engine) {
+  constexpr std::size_t num_words = ENGINE_TYPE::state_size;
+  // The words are only accessible through the representation of the engine.
+  std::stringstream text;
+  text << engine;
+  for (std::size_t wx = 0; wx < num_words; wx++) {
+    std::uint64_t word = 0;
+    text >> word;
+    write_state(state, word);
+  }
+  std::uint64_t index = num_words;
+  text >> index;
+  write_state(state, text.fail() ? std::uint64_t{num_words} : index);
+}
+
+/**
+ * Read the state of a stdlib random number engine written by
+ * write_engine_state.
+ *
+ * @param[in] state Blob to read the engine from.
+ * @param[in, out] offset Offset of the engine in the blob, advanced past the
+ * engine.
+ * @param[out] engine Engine to read.
+ * @returns False if the blob does not hold the state of the engine.
+ */
+template <typename ENGINE_TYPE>
+inline bool read_engine_state(const std::vector<std::uint8_t> &state,
+                              std::size_t &offset, ENGINE_TYPE &engine) {
+  constexpr std::size_t num_words = ENGINE_TYPE::state_size;
+  if ((offset > state.size()) ||
+      ((state.size() - offset) / sizeof(std::uint64_t) < num_words + 1)) {
+    return false;
+  }
+  std::stringstream text;
+  for (std::size_t wx = 0; wx < num_words + 1; wx++) {
+    std::uint64_t word = 0;
+    read_state(state, offset, word);
+    text << word << " ";
+  }
+  // A representation without the index leaves the index unread.
+  ENGINE_TYPE value = engine;
+  text >> value;
+  if (text.fail()) {
+    return false;
+  }
+  engine = value;
+  return true;
+}
+
+/**
+ * Append the state of a stdlib distribution to a state blob. The
+ * representation of a distribution is its parameters followed by any values
+ * it has cached, e.g. the second value of a Normal pair, which are appended
+ * as binary values of the result type.
+ *
+ * @param[in, out] state Blob to append the distribution to.
+ * @param[in] dist Distribution to append.
+ */
+template <typename DIST_TYPE>
+inline void write_distribution_state(std::vector<std::uint8_t> &state,
+                                     const DIST_TYPE &dist) {
+  using R = typename DIST_TYPE::result_type;
+  std::stringstream text;
+  text << dist;
+  std::vector<R> values;
+  R value;
+  while (text >> value) {
+    values.push_back(value);
+  }
+  write_state(state, static_cast<std::uint64_t>(values.size()));
+  for (const R value : values) {
+    write_state(state, value);
+  }
+}
+
+/**
+ * Read the state of a stdlib distribution written by
+ * write_distribution_state.
+ *
+ * @param[in] state Blob to read the distribution from.
+ * @param[in, out] offset Offset of the distribution in the blob, advanced past
+ * the distribution.
+ * @param[out] dist Distribution to read.
+ * @returns False if the blob does not hold the state of the distribution.
+ */
+template <typename DIST_TYPE>
+inline bool read_distribution_state(const std::vector<std::uint8_t> &state,
+                                    std::size_t &offset, DIST_TYPE &dist) {
+  using R = typename DIST_TYPE::result_type;
+  std::uint64_t num_values = 0;
+  if (!read_state(state, offset, num_values) ||
+      ((state.size() - offset) / sizeof(R) < num_values)) {
+    return false;
+  }
+  // Values written with max_digits10 digits are read back exactly.
+  std::stringstream text;
+  text.precision(std::numeric_limits<R>::max_digits10);
+  for (std::uint64_t vx = 0; vx < num_values; vx++) {
+    R value;
+    read_state(state, offset, value);
+    text << value << " ";
+  }
+  DIST_TYPE value = dist;
+  text >> value;
+  if (text.fail()) {
+    return false;
+  }
+  dist = value;
+  return true;
+}
+
+/**
+ * Check the platform name at the start of a state blob.
+ *
+ * @param[in] state Blob to read the platform name from.
+ * @param[in, out] offset Offset of the name, advanced past the name.
+ * @param[in] platform_name Name of the platform loading the blob.
+ * @returns False if the blob was not saved by the platform.
+ */
+inline bool read_state_platform(const std::vector<std::uint8_t> &state,
+                                std::size_t &offset,
+                                const std::string &platform_name) {
+  std::string name;
+  return read_state(state, offset, name) && (name == platform_name);
+}
+
+/**
+ * Print the error for a state blob which cannot be loaded.
+ *
+ * @returns The error code for an invalid state blob.
+ */
+inline int invalid_state(const std::string &platform_name) {
+  std::cout << "The state is not a saved state of this " + platform_name +
+                   " RNG."
+            << std::endl;
+  return -7;
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
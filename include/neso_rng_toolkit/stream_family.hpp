@@ -0,0 +1,265 @@
+#ifndef _NESO_RNG_TOOLKIT_STREAM_FAMILY_HPP_
+#define _NESO_RNG_TOOLKIT_STREAM_FAMILY_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "rejection.hpp"
+#include "typedefs.hpp"
+#include <map>
+
+namespace NESO::RNGToolkit {
+
+/**
+ * A family of many persistent random streams, e.g. one stream per particle
+ * or per cell, such that the samples of an item do not depend on the order in
+ * which items are processed. Stream s of the family is the Philox4x32-10
+ * stream s of a key which is formed from the seed, hence the only device
+ * state of a stream is the 64-bit count of the blocks the stream has
+ * consumed. Samples are drawn for a subset of the streams in a single kernel,
+ * e.g.
+ *
+ *    family.get_samples(Distribution::Normal<double>{0.0, 1.0}, d_ids,
+ *                       num_ids, num_per_stream, d_ptr);
+ *
+ * Each call starts each stream at a new block of four values, hence the
+ * samples of a stream are identical whichever other streams are sampled by
+ * the same call. Families with the same seed share their streams. The kernels
+ * of a family are ordered, and an id which is repeated within a call samples
+ * only one of its positions and is reported as an error.
+ */
+template <typename VALUE_TYPE> struct StreamFamily {
+  /// Queue on which the state is allocated and sampled.
+  sycl::queue queue;
+  /// Number of streams of the family.
+  std::size_t num_streams{0};
+  /// The Philox key shared by the streams.
+  std::uint32_t key[2]{0, 0};
+
+  ~StreamFamily() { this->free(); }
+
+  /**
+   * Create an empty family.
+   *
+   * @param queue SYCL queue on which the state is allocated and sampled.
+   */
+  StreamFamily(sycl::queue queue) : queue(queue) {}
+
+  StreamFamily(const StreamFamily &) = delete;
+  StreamFamily &operator=(const StreamFamily &) = delete;
+
+  /**
+   * Replace the streams of the family with new streams which start at the
+   * beginning of their sequences.
+   *
+   * @param seed Value to seed the streams with.
+   * @param num_streams Number of streams.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int create(const std::uint64_t seed, const std::size_t num_streams) {
+    if (num_streams == 0) {
+      std::cout << "Cannot create a stream family with no streams."
+                << std::endl;
+      return -1;
+    }
+    this->free();
+    this->d_counters =
+        sycl::malloc_device<std::uint64_t>(2 * num_streams + 2, this->queue);
+    if (this->d_counters == nullptr) {
+      std::cout << "Failed to allocate a stream family with " +
+                       std::to_string(num_streams) + " streams."
+                << std::endl;
+      return -2;
+    }
+    // The counters are followed by the counts of the invalid and duplicated
+    // stream ids and the call which last claimed each stream.
+    this->queue.fill(this->d_counters, std::uint64_t{0}, 2 * num_streams + 2)
+        .wait_and_throw();
+    this->num_streams = num_streams;
+    this->num_calls = 0;
+    this->last_event = sycl::event{};
+    this->key[0] = static_cast<std::uint32_t>(seed);
+    this->key[1] = static_cast<std::uint32_t>(seed >> 32);
+    return SUCCESS;
+  }
+
+  /**
+   * Submit a kernel which draws samples from a number of the streams. The
+   * samples of the selected stream i are written to d_ptr[i * num_per_stream
+   * + j] for the AoS layout and to d_ptr[j * num_ids + i] for the SoA layout.
+   *
+   * @param distribution Uniform, Normal or Exponential distribution to sample.
+   * @param d_stream_ids Device pointer to the ids of the num_ids streams to
+   * sample. The ids must be distinct and less than num_streams, repeated ids
+   * are detected, sampled once and reported by wait_get_samples. If nullptr
+   * the streams 0, 1, ..., num_ids - 1 are sampled.
+   * @param num_ids Number of streams to sample.
+   * @param num_per_stream Number of samples to draw from each stream.
+   * @param d_ptr Device pointer to num_ids * num_per_stream values.
+   * @param layout Order of the samples in d_ptr.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  int submit_get_samples(
+      const DISTRIBUTION_TYPE distribution, const std::size_t *d_stream_ids,
+      const std::size_t num_ids, const std::size_t num_per_stream,
+      VALUE_TYPE *d_ptr,
+      const Distribution::Layout layout = Distribution::Layout::AoS) {
+    static_assert(
+        Private::is_rejection_proposal_v<DISTRIBUTION_TYPE, VALUE_TYPE>,
+        "Stream families sample Uniform, Normal or Exponential "
+        "distributions of VALUE_TYPE.");
+    if (this->d_counters == nullptr) {
+      std::cout << "The stream family has not been created." << std::endl;
+      return -1;
+    }
+    if ((d_stream_ids == nullptr) && (num_ids > this->num_streams)) {
+      std::cout << "Cannot sample " + std::to_string(num_ids) +
+                       " streams of a family of " +
+                       std::to_string(this->num_streams) + " streams."
+                << std::endl;
+      return -1;
+    }
+
+    sycl::event event{};
+    if ((num_ids > 0) && (num_per_stream > 0)) {
+      const std::size_t k_num_streams = this->num_streams;
+      const std::uint32_t k_key_0 = this->key[0];
+      const std::uint32_t k_key_1 = this->key[1];
+      const bool soa = layout == Distribution::Layout::SoA;
+      std::uint64_t *k_counters = this->d_counters;
+      std::uint64_t *k_claims = this->d_counters + k_num_streams + 2;
+      const std::uint64_t k_call = ++this->num_calls;
+      // Ordering the kernels of the family prevents calls in flight from
+      // updating the same counters concurrently.
+      event = this->queue.parallel_for(
+          sycl::range<1>(num_ids), this->last_event, [=](auto idx) {
+            const std::size_t ix = idx;
+            const std::size_t id =
+                (d_stream_ids == nullptr) ? ix : d_stream_ids[ix];
+            if (id >= k_num_streams) {
+              sycl::atomic_ref<std::uint64_t, sycl::memory_order::relaxed,
+                               sycl::memory_scope::device,
+                               sycl::access::address_space::global_space>
+                  num_invalid(k_counters[k_num_streams]);
+              num_invalid.fetch_add(1);
+              return;
+            }
+            if (d_stream_ids != nullptr) {
+              // Only one position of a repeated id claims the stream.
+              sycl::atomic_ref<std::uint64_t, sycl::memory_order::relaxed,
+                               sycl::memory_scope::device,
+                               sycl::access::address_space::global_space>
+                  claim(k_claims[id]);
+              if (claim.exchange(k_call) == k_call) {
+                sycl::atomic_ref<std::uint64_t, sycl::memory_order::relaxed,
+                                 sycl::memory_scope::device,
+                                 sycl::access::address_space::global_space>
+                    num_duplicated(k_counters[k_num_streams + 1]);
+                num_duplicated.fetch_add(1);
+                return;
+              }
+            }
+            Private::PhiloxStream stream(k_key_0, k_key_1, id);
+            stream.set_block(k_counters[id]);
+            for (std::size_t jx = 0; jx < num_per_stream; jx++) {
+              const std::size_t index =
+                  soa ? jx * num_ids + ix : ix * num_per_stream + jx;
+              d_ptr[index] = Private::sample_proposal(distribution, stream);
+            }
+            k_counters[id] = stream.get_block();
+          });
+      this->last_event = event;
+    }
+    this->map_ptr_event[d_ptr] = event;
+    return SUCCESS;
+  }
+
+  /**
+   * Wait for the samples drawn into a pointer.
+   *
+   * @param d_ptr Device pointer passed to submit_get_samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int wait_get_samples(VALUE_TYPE *d_ptr) {
+    auto it = this->map_ptr_event.find(d_ptr);
+    if (it == this->map_ptr_event.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    it->second.wait_and_throw();
+    this->map_ptr_event.erase(it);
+
+    std::uint64_t num_errors[2] = {0, 0};
+    std::uint64_t *d_num_errors = this->d_counters + this->num_streams;
+    this->queue.memcpy(num_errors, d_num_errors, 2 * sizeof(std::uint64_t))
+        .wait_and_throw();
+    if ((num_errors[0] > 0) || (num_errors[1] > 0)) {
+      this->queue.fill(d_num_errors, std::uint64_t{0}, 2).wait_and_throw();
+    }
+    if (num_errors[0] > 0) {
+      std::cout << std::to_string(num_errors[0]) +
+                       " stream ids are not streams of the family."
+                << std::endl;
+      return -3;
+    }
+    if (num_errors[1] > 0) {
+      std::cout << std::to_string(num_errors[1]) +
+                       " stream ids are repeated within a call."
+                << std::endl;
+      return -4;
+    }
+    return SUCCESS;
+  }
+
+  /**
+   * Draw samples from a number of the streams and wait for the samples, see
+   * submit_get_samples.
+   *
+   * @returns Error code to be tested against SUCCESS.
+   */
+  template <typename DISTRIBUTION_TYPE>
+  int get_samples(const DISTRIBUTION_TYPE distribution,
+                  const std::size_t *d_stream_ids, const std::size_t num_ids,
+                  const std::size_t num_per_stream, VALUE_TYPE *d_ptr,
+                  const Distribution::Layout layout =
+                      Distribution::Layout::AoS) {
+    int err = SUCCESS;
+    if ((err = this->submit_get_samples(distribution, d_stream_ids, num_ids,
+                                        num_per_stream, d_ptr, layout)) !=
+        SUCCESS) {
+      return err;
+    }
+    return this->wait_get_samples(d_ptr);
+  }
+
+protected:
+  /// Device pointer to the number of blocks each stream has consumed, the
+  /// numbers of invalid and repeated stream ids and the last call which
+  /// sampled each stream.
+  std::uint64_t *d_counters{nullptr};
+  /// Number of calls which submitted a kernel, identifies the claims of a call.
+  std::uint64_t num_calls{0};
+  /// Event for the last kernel of the family.
+  sycl::event last_event{};
+
+  /// The events of the kernels which write to the pointers.
+  std::map<VALUE_TYPE *, sycl::event> map_ptr_event;
+
+  inline void free() {
+    for (auto &ptr_event : this->map_ptr_event) {
+      ptr_event.second.wait();
+    }
+    this->map_ptr_event.clear();
+    this->last_event = sycl::event{};
+    if (this->d_counters != nullptr) {
+      sycl::free(this->d_counters, this->queue);
+      this->d_counters = nullptr;
+    }
+    this->num_streams = 0;
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,526 @@
+#ifndef _NESO_RNG_TOOLKIT_TABULATED_HPP_
+#define _NESO_RNG_TOOLKIT_TABULATED_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "rng.hpp"
+#include "typedefs.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Map a sample of the standard Uniform distribution through the inverse of a
+ * tabulated cumulative distribution. The interval is found with the guide
+ * table, which is a constant number of steps for smooth tables, and the
+ * cumulative distribution within the interval, a quadratic for a linear
+ * density, is inverted exactly. Callable from device code.
+ *
+ * @param distribution Tabulated distribution.
+ * @param u Sample from the standard Uniform distribution.
+ * @returns Sample from the tabulated distribution.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE
+sample_tabulated(const Distribution::Tabulated<VALUE_TYPE> &distribution,
+                 const VALUE_TYPE u) {
+  using R = VALUE_TYPE;
+  const std::size_t num_guide = distribution.num_guide;
+  const std::size_t g = std::min(
+      static_cast<std::size_t>(u * static_cast<R>(num_guide)), num_guide - 1);
+  // Find the last interval i in the range given by the guide table such that
+  // cdf[i] <= u.
+  std::size_t low = distribution.d_guide[g];
+  std::size_t high = distribution.d_guide[g + 1];
+  while (low < high) {
+    const std::size_t mid = low + (high - low + 1) / 2;
+    if (distribution.d_cdf[mid] <= u) {
+      low = mid;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  const std::size_t i = low;
+  const R r = u - distribution.d_cdf[i];
+  const R a = distribution.d_left[i];
+  const R b = distribution.d_right[i];
+  const R h = distribution.d_x[i + 1] - distribution.d_x[i];
+  // Solve a t + (b - a) t^2 / (2 h) = r in the form which is stable for
+  // b == a.
+  const R discriminant = sycl::fmax(a * a + R(2.0) * (b - a) * r / h, R(0.0));
+  const R denominator = a + sycl::sqrt(discriminant);
+  const R t = (denominator > R(0.0)) ? R(2.0) * r / denominator : R(0.0);
+  return distribution.d_x[i] + sycl::fmin(sycl::fmax(t, R(0.0)), h);
+}
+
+/**
+ * Sample a tabulated distribution with the Philox stream of a sample.
+ * Callable from device code.
+ *
+ * @param distribution Tabulated distribution.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param index Index of the sample, i.e. of the Philox stream.
+ * @returns Sample from the tabulated distribution.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE
+sample_tabulated(const Distribution::Tabulated<VALUE_TYPE> &distribution,
+                 const VALUE_TYPE *d_key, const std::size_t index) {
+  PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                      get_key_word(d_key[2], d_key[3]), index);
+  return sample_tabulated(distribution, stream.next_uniform<VALUE_TYPE>());
+}
+
+/**
+ * Submit a kernel which samples a tabulated distribution with a Philox
+ * stream per sample, i.e. the uniform samples are generated and inverted by
+ * the same kernel.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Tabulated distribution.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to fill with num_samples samples.
+ * @param num_samples Number of samples.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename VALUE_TYPE>
+inline sycl::event
+submit_tabulated(sycl::queue &queue,
+                 const Distribution::Tabulated<VALUE_TYPE> distribution,
+                 const VALUE_TYPE *d_key, VALUE_TYPE *d_ptr,
+                 const std::size_t num_samples,
+                 sycl::event event = sycl::event{},
+                 const Distribution::Strided layout = Distribution::Strided{}) {
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    d_ptr[Distribution::get_strided_index(layout, ix)] =
+        sample_tabulated(distribution, d_key, ix);
+  });
+}
+
+} // namespace Private
+
+/**
+ * Device table for sampling a distribution which is given as a table of
+ * values, e.g. a measured energy spectrum, by inversion of the cumulative
+ * distribution. The table is built on the host and copied to the device once,
+ * sampling then only reads the device table. Sample the table with create_rng,
+ * e.g.
+ *
+ *    auto rng = create_rng<double>(table.get_distribution(), seed, device,
+ *                                  device_index);
+ */
+template <typename VALUE_TYPE> struct InverseCDFTable {
+  /// Queue on which the table is allocated.
+  sycl::queue queue;
+  /// Number of intervals of the last successful build.
+  std::size_t num_intervals{0};
+
+  ~InverseCDFTable() { this->free(); }
+
+  /**
+   * Create an empty table.
+   *
+   * @param queue SYCL queue on which the table is allocated.
+   */
+  InverseCDFTable(sycl::queue queue) : queue(queue) {}
+
+  InverseCDFTable(const InverseCDFTable &) = delete;
+  InverseCDFTable &operator=(const InverseCDFTable &) = delete;
+
+  /**
+   * Build the table from a tabulated density. The density is linearly
+   * interpolated between the points, hence refining the table refines the
+   * piecewise-linear approximation, and the density need not be normalised.
+   *
+   * @param x Strictly increasing points, at least two.
+   * @param pdf Non-negative values of the density at the points.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int build_from_pdf(const std::vector<double> &x,
+                     const std::vector<double> &pdf) {
+    int err = SUCCESS;
+    if ((err = check_table(x, pdf)) != SUCCESS) {
+      return err;
+    }
+    const std::size_t m = x.size() - 1;
+    std::vector<double> cdf(m + 1, 0.0);
+    for (std::size_t ix = 0; ix < m; ix++) {
+      cdf.at(ix + 1) =
+          cdf.at(ix) + 0.5 * (pdf.at(ix) + pdf.at(ix + 1)) *
+                           (x.at(ix + 1) - x.at(ix));
+    }
+    const double total = cdf.at(m);
+    if (!(total > 0.0) || !std::isfinite(total)) {
+      std::cout << "Tabulated density must have a positive finite integral."
+                << std::endl;
+      return -3;
+    }
+    std::vector<double> left(m);
+    std::vector<double> right(m);
+    for (std::size_t ix = 0; ix < m; ix++) {
+      left.at(ix) = pdf.at(ix) / total;
+      right.at(ix) = pdf.at(ix + 1) / total;
+    }
+    return this->copy_to_device(x, cdf, left, right);
+  }
+
+  /**
+   * Build the table from a tabulated cumulative distribution. The cumulative
+   * distribution is linearly interpolated between the points, i.e. the
+   * density is constant on each interval, and need not be normalised.
+   *
+   * @param x Strictly increasing points, at least two.
+   * @param cdf Non-decreasing values of the cumulative distribution at the
+   * points.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  int build_from_cdf(const std::vector<double> &x,
+                     const std::vector<double> &cdf) {
+    int err = SUCCESS;
+    if ((err = check_table(x, cdf)) != SUCCESS) {
+      return err;
+    }
+    const std::size_t m = x.size() - 1;
+    std::vector<double> shifted(m + 1);
+    std::vector<double> density(m);
+    for (std::size_t ix = 0; ix <= m; ix++) {
+      shifted.at(ix) = cdf.at(ix) - cdf.at(0);
+    }
+    for (std::size_t ix = 0; ix < m; ix++) {
+      density.at(ix) = (shifted.at(ix + 1) - shifted.at(ix)) /
+                       (x.at(ix + 1) - x.at(ix));
+      if (density.at(ix) < 0.0) {
+        std::cout << "Tabulated cumulative distribution must be "
+                     "non-decreasing."
+                  << std::endl;
+        return -3;
+      }
+    }
+    const double total = shifted.at(m);
+    if (!(total > 0.0) || !std::isfinite(total)) {
+      std::cout << "Tabulated cumulative distribution must increase."
+                << std::endl;
+      return -3;
+    }
+    for (std::size_t ix = 0; ix < m; ix++) {
+      density.at(ix) /= total;
+    }
+    return this->copy_to_device(x, shifted, density, density);
+  }
+
+  /**
+   * @returns The distribution which samples the last table which was built.
+   */
+  Distribution::Tabulated<VALUE_TYPE> get_distribution() const {
+    // The points, cumulative distribution, left densities and right densities
+    // are stored consecutively in one allocation.
+    const std::size_t m = this->num_intervals;
+    const VALUE_TYPE *d_x = this->d_values;
+    const VALUE_TYPE *d_cdf = d_x + m + 1;
+    const VALUE_TYPE *d_left = d_cdf + m + 1;
+    const VALUE_TYPE *d_right = d_left + m;
+    return Distribution::Tabulated<VALUE_TYPE>{
+        d_x, d_cdf, d_left, d_right, this->d_guide, m, m};
+  }
+
+protected:
+  VALUE_TYPE *d_values{nullptr};
+  std::uint32_t *d_guide{nullptr};
+
+  inline void free() {
+    if (this->d_values != nullptr) {
+      sycl::free(this->d_values, this->queue);
+      this->d_values = nullptr;
+    }
+    if (this->d_guide != nullptr) {
+      sycl::free(this->d_guide, this->queue);
+      this->d_guide = nullptr;
+    }
+  }
+
+  /**
+   * Check that the points of a table are valid and that the values are
+   * non-negative and finite.
+   *
+   * @param x Points of the table.
+   * @param values Values at the points.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  static inline int check_table(const std::vector<double> &x,
+                                const std::vector<double> &values) {
+    if ((x.size() < 2) || (x.size() != values.size()) ||
+        (x.size() - 1 > std::numeric_limits<std::uint32_t>::max())) {
+      std::cout << "A table requires at least two points and one value per "
+                   "point."
+                << std::endl;
+      return -1;
+    }
+    for (std::size_t ix = 0; ix < x.size(); ix++) {
+      if (!std::isfinite(x.at(ix)) || !std::isfinite(values.at(ix)) ||
+          (values.at(ix) < 0.0) || ((ix > 0) && !(x.at(ix - 1) < x.at(ix)))) {
+        std::cout << "Table points must be strictly increasing and values "
+                     "must be non-negative and finite."
+                  << std::endl;
+        return -3;
+      }
+    }
+    return SUCCESS;
+  }
+
+  /**
+   * Build the guide table and copy the table to the device.
+   *
+   * @param x Points of the table.
+   * @param cdf Cumulative distribution at the points, starting at zero.
+   * @param left Normalised density at the start of each interval.
+   * @param right Normalised density at the end of each interval.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int copy_to_device(const std::vector<double> &x,
+                            const std::vector<double> &cdf,
+                            const std::vector<double> &left,
+                            const std::vector<double> &right) {
+    const std::size_t m = left.size();
+    const double total = cdf.at(m);
+    std::vector<VALUE_TYPE> values;
+    values.reserve(4 * m + 2);
+    for (std::size_t ix = 0; ix <= m; ix++) {
+      values.push_back(static_cast<VALUE_TYPE>(x.at(ix)));
+    }
+    for (std::size_t ix = 0; ix < m; ix++) {
+      values.push_back(static_cast<VALUE_TYPE>(cdf.at(ix) / total));
+    }
+    // The last value is exactly one such that every uniform sample in [0, 1)
+    // is below it.
+    values.push_back(static_cast<VALUE_TYPE>(1.0));
+    for (std::size_t ix = 0; ix < m; ix++) {
+      values.push_back(static_cast<VALUE_TYPE>(left.at(ix)));
+    }
+    for (std::size_t ix = 0; ix < m; ix++) {
+      values.push_back(static_cast<VALUE_TYPE>(right.at(ix)));
+    }
+
+    // Entry g of the guide table is the last interval i such that
+    // cdf[i] <= g / m.
+    const VALUE_TYPE *cdf_values = values.data() + m + 1;
+    std::vector<std::uint32_t> guide(m + 1);
+    std::size_t interval = 0;
+    for (std::size_t gx = 0; gx <= m; gx++) {
+      const VALUE_TYPE u =
+          static_cast<VALUE_TYPE>(gx) / static_cast<VALUE_TYPE>(m);
+      while ((interval + 1 < m) && (cdf_values[interval + 1] <= u)) {
+        interval++;
+      }
+      guide.at(gx) = static_cast<std::uint32_t>(interval);
+    }
+
+    if (m != this->num_intervals) {
+      this->free();
+      this->num_intervals = 0;
+      this->d_values =
+          sycl::malloc_device<VALUE_TYPE>(values.size(), this->queue);
+      this->d_guide = sycl::malloc_device<std::uint32_t>(m + 1, this->queue);
+      if ((this->d_values == nullptr) || (this->d_guide == nullptr)) {
+        std::cout << "Failed to allocate a table with " + std::to_string(m) +
+                         " intervals."
+                  << std::endl;
+        this->free();
+        return -2;
+      }
+    }
+    this->queue
+        .memcpy(this->d_values, values.data(),
+                values.size() * sizeof(VALUE_TYPE))
+        .wait_and_throw();
+    this->queue
+        .memcpy(this->d_guide, guide.data(),
+                guide.size() * sizeof(std::uint32_t))
+        .wait_and_throw();
+    this->num_intervals = m;
+    return SUCCESS;
+  }
+};
+
+/**
+ * An RNG which samples a tabulated distribution. The uniform samples are
+ * generated and inverted by a single kernel with a Philox stream per sample,
+ * hence the samples are written once on every platform. The key of the
+ * Philox streams is four standard Uniform samples drawn from another RNG,
+ * hence the samples are reproducible for a given seed and advance the stream
+ * of that RNG.
+ */
+template <typename VALUE_TYPE> struct TabulatedRNG : public RNG<VALUE_TYPE> {
+  virtual ~TabulatedRNG() {
+    for (auto &key : this->key_allocations) {
+      sycl::free(key, this->queue);
+    }
+  }
+
+  /// The RNG which produces the keys of the Philox streams.
+  RNGSharedPtr<VALUE_TYPE> rng;
+  sycl::queue queue;
+  Distribution::Tabulated<VALUE_TYPE> distribution;
+
+  /// The key and kernel event for the pointers with samples in flight.
+  std::map<VALUE_TYPE *, std::pair<VALUE_TYPE *, sycl::event>> map_ptr_key;
+
+  virtual int wait_get_samples(VALUE_TYPE *d_ptr) override {
+    auto it = this->map_ptr_key.find(d_ptr);
+    if (it == this->map_ptr_key.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    VALUE_TYPE *d_key = it->second.first;
+    sycl::event event = it->second.second;
+    this->map_ptr_key.erase(it);
+    event.wait_and_throw();
+    this->release_key(d_key);
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    VALUE_TYPE *d_key = nullptr;
+    int err = SUCCESS;
+    if ((err = this->get_key(num_samples, &d_key)) != SUCCESS) {
+      return err;
+    }
+    sycl::event event{};
+    if (num_samples > 0) {
+      event = Private::submit_tabulated(this->queue, this->distribution, d_key,
+                                        d_ptr, num_samples);
+    }
+    this->map_ptr_key[d_ptr] = {d_key, event};
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+    VALUE_TYPE *d_key = nullptr;
+    int err = SUCCESS;
+    if ((err = this->get_key(num_samples, &d_key)) != SUCCESS) {
+      return err;
+    }
+    const auto k_distribution = this->distribution;
+    this->queue
+        .submit([&](sycl::handler &cgh) {
+          sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                                  sycl::id<1>(offset), sycl::write_only);
+          cgh.parallel_for(sycl::range<1>(num_samples), [=](auto idx) {
+            const std::size_t ix = idx;
+            accessor[ix] = Private::sample_tabulated(k_distribution, d_key, ix);
+          });
+        })
+        .wait_and_throw();
+    this->release_key(d_key);
+    return SUCCESS;
+  }
+
+  /**
+   * The state is the state of the RNG of the keys.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    return this->rng->save_state(state);
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    return this->rng->load_state(state);
+  }
+
+  /**
+   * Create an RNG which samples a tabulated distribution with Philox streams
+   * keyed by another RNG.
+   *
+   * @param rng RNG of standard Uniform samples to draw the Philox keys from.
+   * @param device SYCL device on which to generate the samples.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param distribution Tabulated distribution from InverseCDFTable.
+   */
+  TabulatedRNG(RNGSharedPtr<VALUE_TYPE> rng, sycl::device device,
+               std::size_t device_index,
+               Distribution::Tabulated<VALUE_TYPE> distribution)
+      : rng(rng), queue(device), distribution(distribution) {
+    this->device = device;
+    this->device_index = device_index;
+    this->platform_name = rng->platform_name;
+  }
+
+protected:
+  /// Number of standard Uniform samples the Philox key is formed from.
+  static constexpr std::size_t num_key_values = 4;
+
+  /// Device allocations for keys owned by this RNG.
+  std::vector<VALUE_TYPE *> key_allocations;
+  /// Device allocations for keys which are not in use.
+  std::vector<VALUE_TYPE *> key_free;
+
+  /**
+   * Draw the Philox key for a number of samples. The stream of the RNG of
+   * the keys is not advanced if there are no samples.
+   *
+   * @param[in] num_samples Number of samples.
+   * @param[out] d_key Device pointer to the values of the key, nullptr if
+   * there are no samples.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int get_key(const std::size_t num_samples, VALUE_TYPE **d_key) {
+    *d_key = nullptr;
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (this->key_free.empty()) {
+      VALUE_TYPE *d_new_key =
+          sycl::malloc_device<VALUE_TYPE>(num_key_values, this->queue);
+      if (d_new_key == nullptr) {
+        std::cout << "Failed to allocate a key." << std::endl;
+        return -2;
+      }
+      this->key_allocations.push_back(d_new_key);
+      this->key_free.push_back(d_new_key);
+    }
+    *d_key = this->key_free.back();
+    this->key_free.pop_back();
+    int err = SUCCESS;
+    if ((err = this->rng->get_samples(*d_key, num_key_values)) != SUCCESS) {
+      this->release_key(*d_key);
+      *d_key = nullptr;
+    }
+    return err;
+  }
+
+  /**
+   * Return a key from get_key such that it may be reused.
+   *
+   * @param d_key Device pointer from get_key or nullptr.
+   */
+  inline void release_key(VALUE_TYPE *d_key) {
+    if (d_key != nullptr) {
+      this->key_free.push_back(d_key);
+    }
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef _NESO_RNG_TOOLKIT_TRANSFORM_HPP_
+#define _NESO_RNG_TOOLKIT_TRANSFORM_HPP_
+
+#include "rng.hpp"
+#include "typedefs.hpp"
+#include <map>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * The transform which is applied to samples when no transform is specified.
+ */
+struct IdentityTransform {
+  template <typename VALUE_TYPE>
+  inline VALUE_TYPE operator()(const VALUE_TYPE value) const {
+    return value;
+  }
+};
+
+} // namespace Private
+
+/**
+ * An RNG which applies a user transform to each sample produced by another
+ * RNG. This is used for the platforms which sample through vendor provided
+ * kernels that we cannot modify. The transform is not fused with the
+ * generation, it is applied by a second kernel on the samples in place once
+ * the wrapped RNG has produced them, hence this RNG costs the same memory
+ * traffic as a user kernel launched after the samples are drawn.
+ */
+template <typename VALUE_TYPE, typename TRANSFORM_TYPE>
+struct TransformRNG : public RNG<VALUE_TYPE> {
+  virtual ~TransformRNG() = default;
+
+  /// The RNG which produces the samples prior to the transform.
+  RNGSharedPtr<VALUE_TYPE> rng;
+  sycl::queue queue;
+  TRANSFORM_TYPE transform;
+
+  std::map<VALUE_TYPE *, std::size_t> map_ptr_num_samples;
+
+  virtual int wait_get_samples(VALUE_TYPE *d_ptr) override {
+    auto it = this->map_ptr_num_samples.find(d_ptr);
+    if (it == this->map_ptr_num_samples.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    const std::size_t num_samples = it->second;
+    this->map_ptr_num_samples.erase(it);
+    int err = SUCCESS;
+    if ((err = this->rng->wait_get_samples(d_ptr)) != SUCCESS) {
+      return err;
+    }
+    if (num_samples > 0) {
+      const auto k_transform = this->transform;
+      this->queue
+          .parallel_for(sycl::range<1>(num_samples),
+                        [=](auto idx) { d_ptr[idx] = k_transform(d_ptr[idx]); })
+          .wait_and_throw();
+    }
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    int err = SUCCESS;
+    if ((err = this->rng->submit_get_samples(d_ptr, num_samples)) !=
+        SUCCESS) {
+      return err;
+    }
+    this->map_ptr_num_samples[d_ptr] = num_samples;
+    return SUCCESS;
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    int err = SUCCESS;
+    if ((err = this->rng->submit_get_samples(buffer, offset, num_samples)) !=
+        SUCCESS) {
+      return err;
+    }
+    if (num_samples > 0) {
+      const auto k_transform = this->transform;
+      this->queue.submit([&](sycl::handler &cgh) {
+        sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                                sycl::id<1>(offset), sycl::read_write);
+        cgh.parallel_for(sycl::range<1>(num_samples), [=](auto idx) {
+          accessor[idx] = k_transform(accessor[idx]);
+        });
+      });
+    }
+    return SUCCESS;
+  }
+
+  /**
+   * The state is the state of the wrapped RNG.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    return this->rng->save_state(state);
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    return this->rng->load_state(state);
+  }
+
+  /**
+   * Create an RNG which transforms the samples of another RNG.
+   *
+   * @param rng RNG to draw the samples from prior to the transform.
+   * @param device SYCL device on which to apply the transform.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param transform Device copyable callable which maps a VALUE_TYPE sample
+   * to a VALUE_TYPE.
+   */
+  TransformRNG(RNGSharedPtr<VALUE_TYPE> rng, sycl::device device,
+               std::size_t device_index, TRANSFORM_TYPE transform)
+      : rng(rng), queue(device), transform(transform) {
+    this->device = device;
+    this->device_index = device_index;
+    this->platform_name = rng->platform_name;
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -0,0 +1,610 @@
+#ifndef _NESO_RNG_TOOLKIT_VARIANCE_REDUCTION_HPP_
+#define _NESO_RNG_TOOLKIT_VARIANCE_REDUCTION_HPP_
+
+#include "distribution.hpp"
+#include "permutation.hpp"
+#include "rng.hpp"
+#include "state.hpp"
+#include "typedefs.hpp"
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Evaluate a polynomial of degree 7 with Horner's method. Callable from device
+ * code.
+ *
+ * @param c Coefficients from the highest to the lowest degree.
+ * @param x Point to evaluate the polynomial at.
+ * @returns Value of the polynomial.
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE evaluate_polynomial(const REAL_TYPE (&c)[8],
+                                     const REAL_TYPE x) {
+  REAL_TYPE value = c[0];
+  for (int ix = 1; ix < 8; ix++) {
+    value = value * x + c[ix];
+  }
+  return value;
+}
+
+/**
+ * The quantile function of the standard Normal distribution, algorithm AS241
+ * (PPND16) of Wichura, "The percentage points of the normal distribution",
+ * Applied Statistics 37, 477-484 (1988), which is accurate to about 1e-16 in
+ * double precision. Callable from device code.
+ *
+ * @param p Probability in the open interval (0, 1).
+ * @returns z such that P(Z < z) = p for Z ~ Normal(0, 1).
+ */
+template <typename REAL_TYPE>
+inline REAL_TYPE normal_quantile(const REAL_TYPE p) {
+  using R = REAL_TYPE;
+  const R q = p - R(0.5);
+  if (sycl::fabs(q) <= R(0.425)) {
+    const R a[8] = {R(2509.0809287301226727), R(33430.575583588128105),
+                    R(67265.770927008700853), R(45921.953931549871457),
+                    R(13731.693765509461125), R(1971.5909503065514427),
+                    R(133.14166789178437745), R(3.387132872796366608)};
+    const R b[8] = {R(5226.495278852545925),  R(28729.085735721942674),
+                    R(39307.89580009271061),  R(21213.794301586595867),
+                    R(5394.1960214247511077), R(687.1870074920579083),
+                    R(42.313330701600911252), R(1.0)};
+    const R r = R(0.180625) - q * q;
+    return q * evaluate_polynomial(a, r) / evaluate_polynomial(b, r);
+  }
+  R r = sycl::sqrt(-sycl::log((q < R(0.0)) ? p : R(1.0) - p));
+  R value;
+  if (r <= R(5.0)) {
+    const R c[8] = {R(7.7454501427834140764e-4), R(0.0227238449892691845833),
+                    R(0.24178072517745061177),   R(1.27045825245236838258),
+                    R(3.64784832476320460504),   R(5.7694972214606914055),
+                    R(4.6303378461565452959),    R(1.42343711074968357734)};
+    const R d[8] = {R(1.05075007164441684324e-9), R(5.475938084995344946e-4),
+                    R(0.0151986665636164571966),  R(0.14810397642748007459),
+                    R(0.68976733498510000455),    R(1.6763848301838038494),
+                    R(2.05319162663775882187),    R(1.0)};
+    r -= R(1.6);
+    value = evaluate_polynomial(c, r) / evaluate_polynomial(d, r);
+  } else {
+    const R e[8] = {R(2.01033439929228813265e-7), R(2.71155556874348757815e-5),
+                    R(0.0012426609473880784386),  R(0.026532189526576123093),
+                    R(0.29656057182850489123),    R(1.7848265399172913358),
+                    R(5.4637849111641143699),     R(6.6579046435011037772)};
+    const R f[8] = {R(2.04426310338993978564e-15), R(1.4215117583164458887e-7),
+                    R(1.8463183175100546818e-5),   R(7.868691311456132591e-4),
+                    R(0.0148753612908506148525),   R(0.13692988092273580531),
+                    R(0.59983220655588793769),     R(1.0)};
+    r -= R(5.0);
+    value = evaluate_polynomial(e, r) / evaluate_polynomial(f, r);
+  }
+  return (q < R(0.0)) ? -value : value;
+}
+
+/**
+ * @returns The quantile of a Uniform distribution at probability p. Callable
+ * from device code.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE get_quantile(const Distribution::Uniform<VALUE_TYPE> &d,
+                               const VALUE_TYPE p) {
+  return d.a + (d.b - d.a) * p;
+}
+
+/**
+ * @returns The quantile of a Normal distribution at probability p. Callable
+ * from device code.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE get_quantile(const Distribution::Normal<VALUE_TYPE> &d,
+                               const VALUE_TYPE p) {
+  return d.mean + d.stddev * normal_quantile(p);
+}
+
+/**
+ * @returns The reflection of a sample of a Uniform distribution about the
+ * mean. Callable from device code.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE get_antithetic(const Distribution::Uniform<VALUE_TYPE> &d,
+                                 const VALUE_TYPE x) {
+  return d.a + d.b - x;
+}
+
+/**
+ * @returns The reflection of a sample of a Normal distribution about the
+ * mean. Callable from device code.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE get_antithetic(const Distribution::Normal<VALUE_TYPE> &d,
+                                 const VALUE_TYPE x) {
+  return d.mean + d.mean - x;
+}
+
+/**
+ * Map a sample u of Uniform[0, 1) in stratum s of num_strata to the
+ * probability (s + u) / num_strata, which is clamped to the open interval
+ * (0, 1). Callable from device code.
+ */
+template <typename VALUE_TYPE>
+inline VALUE_TYPE get_stratum_probability(const std::size_t s,
+                                          const std::size_t num_strata,
+                                          const VALUE_TYPE u) {
+  const VALUE_TYPE p = (static_cast<VALUE_TYPE>(s) + u) /
+                       static_cast<VALUE_TYPE>(num_strata);
+  return sycl::fmin(
+      sycl::fmax(p, std::numeric_limits<VALUE_TYPE>::min()),
+      VALUE_TYPE(1.0) - std::numeric_limits<VALUE_TYPE>::epsilon() / 2);
+}
+
+/**
+ * @returns The number of samples the wrapped RNG draws for n samples.
+ */
+template <typename DISTRIBUTION_TYPE>
+inline std::size_t
+get_num_drawn([[maybe_unused]] const DISTRIBUTION_TYPE &mode,
+              const std::size_t num_samples) {
+  return num_samples;
+}
+
+template <typename DISTRIBUTION_TYPE>
+inline std::size_t get_num_drawn(
+    [[maybe_unused]] const Distribution::Antithetic<DISTRIBUTION_TYPE> &mode,
+    const std::size_t num_samples) {
+  return (num_samples + 1) / 2;
+}
+
+/**
+ * Check that a number of samples forms a valid set.
+ *
+ * @param mode The variance reduced distribution.
+ * @param num_samples Number of samples to draw.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename DISTRIBUTION_TYPE>
+inline int check_num_samples([[maybe_unused]] const DISTRIBUTION_TYPE &mode,
+                             [[maybe_unused]] const std::size_t num_samples) {
+  return SUCCESS;
+}
+
+template <typename DISTRIBUTION_TYPE>
+inline int
+check_num_samples(const Distribution::LatinHypercube<DISTRIBUTION_TYPE> &mode,
+                  const std::size_t num_samples) {
+  if (num_samples % mode.ndim != 0) {
+    std::cout << "The number of samples, " + std::to_string(num_samples) +
+                     ", is not a multiple of the dimension " +
+                     std::to_string(mode.ndim) + "."
+              << std::endl;
+    return -4;
+  }
+  return SUCCESS;
+}
+
+/**
+ * Device workspace of a variance reduction RNG which is reused by each set of
+ * samples. Latin hypercube designs use the permutation allocations, the Philox
+ * keys of the permutations are formed from words drawn from a dedicated RNG
+ * for Bits such that the stream of the independent samples is not advanced.
+ * Sets drawn into SYCL buffers are formed in the scratch allocation.
+ */
+struct VarianceReductionWorkspace {
+  sycl::queue queue;
+  /// The RNG which produces the words of the Philox keys, may be nullptr.
+  RNGSharedPtr<std::uint32_t> key_rng;
+  /// Device pointer to the four words of the Philox key.
+  std::uint32_t *d_key{nullptr};
+  /// Device pointer to the offsets of the segments of the permutation.
+  std::size_t *d_offsets{nullptr};
+  std::uint64_t *d_keys{nullptr};
+  std::size_t *d_segments{nullptr};
+  std::size_t *d_permutation{nullptr};
+  /// Number of segments the offsets are allocated for.
+  std::size_t num_segments{0};
+  /// Number of samples the allocations hold.
+  std::size_t num_samples{0};
+  /// Size of the segments the offsets were computed for, zero if the offsets
+  /// are not computed.
+  std::size_t segment_size{0};
+  /// Device scratch space the sets drawn into buffers are formed in.
+  void *d_scratch{nullptr};
+  /// Number of bytes the scratch space holds.
+  std::size_t num_scratch_bytes{0};
+
+  ~VarianceReductionWorkspace() {
+    this->free();
+    if (this->d_scratch != nullptr) {
+      sycl::free(this->d_scratch, this->queue);
+    }
+  }
+
+  /**
+   * Create an empty workspace.
+   *
+   * @param queue SYCL queue on which the workspace is allocated.
+   * @param key_rng RNG to draw the words of the Philox keys from.
+   */
+  VarianceReductionWorkspace(sycl::queue queue,
+                             RNGSharedPtr<std::uint32_t> key_rng)
+      : queue(queue), key_rng(key_rng) {}
+
+  VarianceReductionWorkspace(const VarianceReductionWorkspace &) = delete;
+  VarianceReductionWorkspace &
+  operator=(const VarianceReductionWorkspace &) = delete;
+
+  /**
+   * Ensure the workspace holds a permutation of num_samples elements in
+   * num_segments segments, the allocations are only replaced if they are too
+   * small.
+   *
+   * @param num_segments Number of segments.
+   * @param num_samples Number of elements.
+   * @returns Error code to be tested against SUCCESS.
+   */
+  inline int reserve(const std::size_t num_segments,
+                     const std::size_t num_samples) {
+    if ((this->d_key != nullptr) && (num_segments <= this->num_segments) &&
+        (num_samples <= this->num_samples)) {
+      return SUCCESS;
+    }
+    this->free();
+    this->d_key = sycl::malloc_device<std::uint32_t>(4, this->queue);
+    this->d_offsets =
+        sycl::malloc_device<std::size_t>(num_segments + 1, this->queue);
+    this->d_keys = sycl::malloc_device<std::uint64_t>(num_samples, this->queue);
+    this->d_segments =
+        sycl::malloc_device<std::size_t>(num_samples, this->queue);
+    this->d_permutation =
+        sycl::malloc_device<std::size_t>(num_samples, this->queue);
+    if ((this->d_key == nullptr) || (this->d_offsets == nullptr) ||
+        (this->d_keys == nullptr) || (this->d_segments == nullptr) ||
+        (this->d_permutation == nullptr)) {
+      std::cout << "Failed to allocate device memory." << std::endl;
+      this->free();
+      return -2;
+    }
+    this->num_segments = num_segments;
+    this->num_samples = num_samples;
+    return SUCCESS;
+  }
+
+  /**
+   * Get device scratch space for num_values values, the allocation is only
+   * replaced if it is too small. The scratch space is independent of the
+   * permutation allocations, hence it remains valid when reserve is called.
+   *
+   * @param num_values Number of values the scratch space should hold.
+   * @returns Device pointer to the scratch space, nullptr on failure.
+   */
+  template <typename VALUE_TYPE>
+  inline VALUE_TYPE *get_scratch(const std::size_t num_values) {
+    const std::size_t num_bytes = num_values * sizeof(VALUE_TYPE);
+    if (num_bytes > this->num_scratch_bytes) {
+      if (this->d_scratch != nullptr) {
+        sycl::free(this->d_scratch, this->queue);
+      }
+      this->d_scratch = sycl::malloc_device(num_bytes, this->queue);
+      this->num_scratch_bytes = (this->d_scratch == nullptr) ? 0 : num_bytes;
+    }
+    return static_cast<VALUE_TYPE *>(this->d_scratch);
+  }
+
+protected:
+  inline void free() {
+    auto free_allocation = [&](auto *&d_ptr) {
+      if (d_ptr != nullptr) {
+        sycl::free(d_ptr, this->queue);
+        d_ptr = nullptr;
+      }
+    };
+    free_allocation(this->d_key);
+    free_allocation(this->d_offsets);
+    free_allocation(this->d_keys);
+    free_allocation(this->d_segments);
+    free_allocation(this->d_permutation);
+    this->num_segments = 0;
+    this->num_samples = 0;
+    this->segment_size = 0;
+  }
+};
+
+/**
+ * Map n samples of Uniform[0, 1) in place to a stratified set of samples.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param workspace Workspace of the RNG, unused.
+ * @param mode The stratified distribution.
+ * @param d_ptr Device pointer holding num_samples uniform samples.
+ * @param num_samples Number of samples.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline int apply_variance_reduction(
+    sycl::queue &queue,
+    [[maybe_unused]] VarianceReductionWorkspace &workspace,
+    const Distribution::Stratified<DISTRIBUTION_TYPE> mode, VALUE_TYPE *d_ptr,
+    const std::size_t num_samples) {
+  const auto k_distribution = mode.distribution;
+  queue
+      .parallel_for(sycl::range<1>(num_samples),
+                    [=](auto idx) {
+                      const std::size_t ix = idx;
+                      d_ptr[ix] = get_quantile(
+                          k_distribution,
+                          get_stratum_probability(ix, num_samples, d_ptr[ix]));
+                    })
+      .wait_and_throw();
+  return SUCCESS;
+}
+
+/**
+ * Write the antithetic samples of the first (n + 1) / 2 samples.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param workspace Workspace of the RNG, unused.
+ * @param mode The antithetic distribution.
+ * @param d_ptr Device pointer holding (num_samples + 1) / 2 samples.
+ * @param num_samples Number of samples.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline int apply_variance_reduction(
+    sycl::queue &queue,
+    [[maybe_unused]] VarianceReductionWorkspace &workspace,
+    const Distribution::Antithetic<DISTRIBUTION_TYPE> mode, VALUE_TYPE *d_ptr,
+    const std::size_t num_samples) {
+  const std::size_t num_independent = (num_samples + 1) / 2;
+  const std::size_t num_reflected = num_samples - num_independent;
+  if (num_reflected == 0) {
+    return SUCCESS;
+  }
+  const auto k_distribution = mode.distribution;
+  queue
+      .parallel_for(sycl::range<1>(num_reflected),
+                    [=](auto idx) {
+                      const std::size_t ix = idx;
+                      d_ptr[num_independent + ix] =
+                          get_antithetic(k_distribution, d_ptr[ix]);
+                    })
+      .wait_and_throw();
+  return SUCCESS;
+}
+
+/**
+ * Map n samples of Uniform[0, 1) in place to a Latin hypercube design. The
+ * strata of each dimension are assigned to the points by a random
+ * permutation, the permutations of all dimensions are drawn together as the
+ * segments of a segmented permutation whose Philox key is drawn from the key
+ * RNG of the workspace. The kernels are ordered by events and the host waits
+ * for the key and for the last kernel.
+ *
+ * @param queue SYCL queue to submit the kernels to.
+ * @param workspace Workspace of the RNG.
+ * @param mode The Latin hypercube distribution.
+ * @param d_ptr Device pointer holding num_samples uniform samples.
+ * @param num_samples Number of values, a multiple of the dimension.
+ * @returns Error code to be tested against SUCCESS.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline int apply_variance_reduction(
+    sycl::queue &queue, VarianceReductionWorkspace &workspace,
+    const Distribution::LatinHypercube<DISTRIBUTION_TYPE> mode,
+    VALUE_TYPE *d_ptr, const std::size_t num_samples) {
+  const std::size_t ndim = mode.ndim;
+  const std::size_t num_points = num_samples / ndim;
+  if (num_points == 0) {
+    return SUCCESS;
+  }
+
+  int err = SUCCESS;
+  if (((err = workspace.reserve(ndim, num_samples)) != SUCCESS) ||
+      ((err = workspace.key_rng->get_samples(workspace.d_key, 4)) !=
+       SUCCESS)) {
+    return err;
+  }
+  std::size_t *d_offsets = workspace.d_offsets;
+  std::size_t *d_permutation = workspace.d_permutation;
+  sycl::event event{};
+  if (workspace.segment_size != num_points) {
+    event = queue.parallel_for(sycl::range<1>(ndim + 1), [=](auto idx) {
+      const std::size_t ix = idx;
+      d_offsets[ix] = ix * num_points;
+    });
+    workspace.segment_size = num_points;
+  }
+  event = Private::submit_segmented_permutation(
+      queue,
+      Distribution::SegmentedPermutation<std::size_t>{d_offsets, ndim,
+                                                      num_points},
+      workspace.d_key, workspace.d_keys, workspace.d_segments, d_permutation,
+      num_samples, event);
+
+  // Element j of segment d holds the point which is assigned stratum j in
+  // dimension d.
+  const auto k_distribution = mode.distribution;
+  const bool k_soa = mode.layout == Distribution::Layout::SoA;
+  queue
+      .parallel_for(
+          sycl::range<1>(num_samples), event,
+          [=](auto idx) {
+            const std::size_t ix = idx;
+            const std::size_t dx = ix / num_points;
+            const std::size_t stratum = ix % num_points;
+            const std::size_t px = d_permutation[ix] - dx * num_points;
+            const std::size_t index =
+                k_soa ? dx * num_points + px : px * ndim + dx;
+            d_ptr[index] = get_quantile(
+                k_distribution,
+                get_stratum_probability(stratum, num_points, d_ptr[index]));
+          })
+      .wait_and_throw();
+  return SUCCESS;
+}
+
+} // namespace Private
+
+/**
+ * An RNG which draws stratified, Latin hypercube or antithetic sets of
+ * samples of a Uniform or Normal distribution, see Distribution::Stratified,
+ * Distribution::LatinHypercube and Distribution::Antithetic. The wrapped RNG
+ * draws the independent samples, Uniform[0, 1) samples for the stratified
+ * modes and samples of the distribution for the antithetic mode, and the set
+ * is formed in place by kernels once the wrapped RNG has produced them.
+ */
+template <typename VALUE_TYPE, typename MODE_TYPE>
+struct VarianceReductionRNG : public RNG<VALUE_TYPE> {
+  virtual ~VarianceReductionRNG() = default;
+
+  /// The RNG which produces the independent samples.
+  RNGSharedPtr<VALUE_TYPE> rng;
+  sycl::queue queue;
+  MODE_TYPE mode;
+  /// Device workspace which is reused by each set of samples.
+  Private::VarianceReductionWorkspace workspace;
+
+  std::map<VALUE_TYPE *, std::size_t> map_ptr_num_samples;
+
+  virtual int wait_get_samples(VALUE_TYPE *d_ptr) override {
+    auto it = this->map_ptr_num_samples.find(d_ptr);
+    if (it == this->map_ptr_num_samples.end()) {
+      std::cout << "No samples are being drawn into this pointer."
+                << std::endl;
+      return -1;
+    }
+    const std::size_t num_samples = it->second;
+    this->map_ptr_num_samples.erase(it);
+    int err = SUCCESS;
+    if ((err = this->rng->wait_get_samples(d_ptr)) != SUCCESS) {
+      return err;
+    }
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    return Private::apply_variance_reduction(
+        this->queue, this->workspace, this->mode, d_ptr, num_samples);
+  }
+
+  virtual int submit_get_samples(VALUE_TYPE *d_ptr,
+                                 const std::size_t num_samples) override {
+    int err = SUCCESS;
+    if ((err = Private::check_num_samples(this->mode, num_samples)) !=
+        SUCCESS) {
+      return err;
+    }
+    this->map_ptr_num_samples[d_ptr] = num_samples;
+    return this->rng->submit_get_samples(
+        d_ptr, Private::get_num_drawn(this->mode, num_samples));
+  }
+
+  virtual int submit_get_samples(sycl::buffer<VALUE_TYPE, 1> &buffer,
+                                 const std::size_t offset,
+                                 const std::size_t num_samples) override {
+    if (num_samples == 0) {
+      return SUCCESS;
+    }
+    if (!this->check_buffer_range(buffer, offset, num_samples)) {
+      return -3;
+    }
+    // The set is formed through device pointers, hence the samples are drawn
+    // into the scratch space of the workspace, which is reused by each call,
+    // and copied into the buffer.
+    VALUE_TYPE *d_ptr =
+        this->workspace.template get_scratch<VALUE_TYPE>(num_samples);
+    if (d_ptr == nullptr) {
+      std::cout << "Failed to allocate device memory." << std::endl;
+      return -2;
+    }
+    int err = SUCCESS;
+    if ((err = this->get_samples(d_ptr, num_samples)) == SUCCESS) {
+      this->queue
+          .submit([&](sycl::handler &cgh) {
+            sycl::accessor accessor(buffer, cgh, sycl::range<1>(num_samples),
+                                    sycl::id<1>(offset), sycl::write_only);
+            cgh.parallel_for(sycl::range<1>(num_samples),
+                             [=](auto idx) { accessor[idx] = d_ptr[idx]; });
+          })
+          .wait_and_throw();
+    }
+    return err;
+  }
+
+  /**
+   * The state is the state of the wrapped RNG followed by the state of the
+   * key RNG, if there is a key RNG.
+   */
+  virtual int save_state(std::vector<std::uint8_t> &state) override {
+    int err = SUCCESS;
+    if ((err = this->rng->save_state(state)) != SUCCESS) {
+      return err;
+    }
+    if (this->workspace.key_rng == nullptr) {
+      return SUCCESS;
+    }
+    std::vector<std::uint8_t> key_state;
+    if ((err = this->workspace.key_rng->save_state(key_state)) != SUCCESS) {
+      return err;
+    }
+    std::vector<std::uint8_t> rng_state;
+    rng_state.swap(state);
+    Private::write_state(state, static_cast<std::uint64_t>(rng_state.size()));
+    state.insert(state.end(), rng_state.begin(), rng_state.end());
+    state.insert(state.end(), key_state.begin(), key_state.end());
+    return SUCCESS;
+  }
+
+  virtual int load_state(const std::vector<std::uint8_t> &state) override {
+    if (this->workspace.key_rng == nullptr) {
+      return this->rng->load_state(state);
+    }
+    std::size_t offset = 0;
+    std::uint64_t size = 0;
+    if (!Private::read_state(state, offset, size) ||
+        (state.size() - offset < size)) {
+      return Private::invalid_state(this->platform_name);
+    }
+    const std::vector<std::uint8_t> rng_state(
+        state.begin() + offset, state.begin() + offset + size);
+    const std::vector<std::uint8_t> key_state(state.begin() + offset + size,
+                                              state.end());
+    // The wrapped RNG is restored if the key state cannot be loaded such that
+    // the RNG is unchanged.
+    std::vector<std::uint8_t> previous_state;
+    int err = SUCCESS;
+    if (((err = this->rng->save_state(previous_state)) != SUCCESS) ||
+        ((err = this->rng->load_state(rng_state)) != SUCCESS)) {
+      return err;
+    }
+    if ((err = this->workspace.key_rng->load_state(key_state)) != SUCCESS) {
+      this->rng->load_state(previous_state);
+    }
+    return err;
+  }
+
+  /**
+   * Create an RNG which forms variance reduced sets from the samples of
+   * another RNG.
+   *
+   * @param rng RNG to draw the independent samples from.
+   * @param device SYCL device on which to form the sets.
+   * @param device_index Index of SYCL device on the SYCL platform.
+   * @param mode Stratified, LatinHypercube or Antithetic distribution.
+   * @param key_rng RNG to draw the words of the Philox keys of the
+   * permutations from, required for LatinHypercube.
+   */
+  VarianceReductionRNG(RNGSharedPtr<VALUE_TYPE> rng, sycl::device device,
+                       std::size_t device_index, MODE_TYPE mode,
+                       RNGSharedPtr<std::uint32_t> key_rng = nullptr)
+      : rng(rng), queue(device), mode(mode), workspace(this->queue, key_rng) {
+    this->device = device;
+    this->device_index = device_index;
+    this->platform_name = rng->platform_name;
+  }
+};
+
+} // namespace NESO::RNGToolkit
+
+#endif
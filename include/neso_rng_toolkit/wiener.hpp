@@ -0,0 +1,69 @@
+#ifndef _NESO_RNG_TOOLKIT_WIENER_HPP_
+#define _NESO_RNG_TOOLKIT_WIENER_HPP_
+
+#include "distribution.hpp"
+#include "philox.hpp"
+#include "typedefs.hpp"
+
+namespace NESO::RNGToolkit {
+
+namespace Private {
+
+/**
+ * Submit a kernel which samples Wiener process paths. Each path uses its own
+ * Philox stream, the Normal samples are drawn in pairs with the Box-Muller
+ * transform, scaled by sqrt(dt) and, for cumulative paths, summed as they are
+ * drawn. Only the requested values are written.
+ *
+ * @param queue SYCL queue to submit the kernel to.
+ * @param distribution Wiener distribution to sample.
+ * @param d_key Device pointer to the four values the Philox key is formed
+ * from.
+ * @param d_ptr Device pointer to write num_steps * num_samples values to.
+ * @param num_samples Number of paths.
+ * @param event Event the kernel depends on, e.g. the event for the key.
+ * @param layout Strided layout the values are written in, contiguous by
+ * default.
+ * @returns Event for the kernel.
+ */
+template <typename REAL_TYPE>
+inline sycl::event
+submit_wiener(sycl::queue &queue,
+              const Distribution::Wiener<REAL_TYPE> distribution,
+              const REAL_TYPE *d_key, REAL_TYPE *d_ptr,
+              const std::size_t num_samples,
+              sycl::event event = sycl::event{},
+              const Distribution::Strided layout = Distribution::Strided{}) {
+  using R = REAL_TYPE;
+  constexpr R two_pi = R(6.283185307179586);
+  const std::size_t k_num_steps = distribution.num_steps;
+  const bool k_cumulative = distribution.cumulative;
+  const bool k_soa = distribution.layout == Distribution::Layout::SoA;
+  const R k_scale = sycl::sqrt(distribution.dt);
+  return queue.parallel_for(sycl::range<1>(num_samples), event, [=](auto idx) {
+    const std::size_t ix = idx;
+    PhiloxStream stream(get_key_word(d_key[0], d_key[1]),
+                        get_key_word(d_key[2], d_key[3]), ix);
+    R value = R(0.0);
+    R z[2];
+    for (std::size_t kx = 0; kx < k_num_steps; kx++) {
+      if (kx % 2 == 0) {
+        const R r = k_scale *
+                    sycl::sqrt(R(-2.0) * sycl::log(stream.next_uniform<R>()));
+        const R theta = two_pi * stream.next_uniform<R>();
+        z[0] = r * sycl::cos(theta);
+        z[1] = r * sycl::sin(theta);
+      }
+      value = k_cumulative ? value + z[kx % 2] : z[kx % 2];
+      const std::size_t index =
+          k_soa ? kx * num_samples + ix : ix * k_num_steps + kx;
+      d_ptr[Distribution::get_strided_index(layout, index)] = value;
+    }
+  });
+}
+
+} // namespace Private
+
+} // namespace NESO::RNGToolkit
+
+#endif
@@ -48,4 +48,19 @@ create_rng(Distribution::Normal<double> distribution, std::uint64_t seed,
            sycl::device device, std::size_t device_index,
            std::string platform_name, std::string generator_name);
 
+template RNGSharedPtr<std::uint32_t>
+create_rng(Distribution::Bits<std::uint32_t> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name, std::string generator_name);
+
+template RNGSharedPtr<std::uint64_t>
+create_rng(Distribution::Bits<std::uint64_t> distribution, std::uint64_t seed,
+           sycl::device device, std::size_t device_index,
+           std::string platform_name, std::string generator_name);
+
+template EngineSharedPtr<double>
+create_engine(std::uint64_t seed, sycl::device device,
+              std::size_t device_index, std::string platform_name,
+              std::string generator_name);
+
 } // namespace NESO::RNGToolkit
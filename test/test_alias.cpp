@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE>
+inline void check_frequencies(std::string platform_name,
+                              AliasTable<VALUE_TYPE> &table,
+                              const std::vector<VALUE_TYPE> &weights,
+                              const std::size_t N) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t num_categories = weights.size();
+
+  VALUE_TYPE *d_weights =
+      sycl::malloc_device<VALUE_TYPE>(num_categories, queue);
+  queue.memcpy(d_weights, weights.data(), num_categories * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  ASSERT_TRUE(table.build(d_weights, num_categories) == SUCCESS);
+  sycl::free(d_weights, queue);
+
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0, platform_name);
+  int *d_ptr = sycl::malloc_device<int>(N, queue);
+  ASSERT_TRUE(engine->get_samples(table.template get_distribution<int>(),
+                                  d_ptr, N) == SUCCESS);
+  std::vector<int> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(int)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+
+  double total = 0.0;
+  for (auto weight : weights) {
+    total += weight;
+  }
+  std::vector<std::size_t> counts(num_categories, 0);
+  for (auto sample : samples) {
+    ASSERT_TRUE((0 <= sample) && (sample < static_cast<int>(num_categories)));
+    counts.at(sample)++;
+  }
+  for (std::size_t cx = 0; cx < num_categories; cx++) {
+    const double p = weights.at(cx) / total;
+    const double expected = p * N;
+    if (p == 0.0) {
+      ASSERT_EQ(counts.at(cx), 0);
+    } else {
+      // Allow five standard deviations.
+      ASSERT_NEAR(counts.at(cx), expected,
+                  5.0 * std::sqrt(expected * (1.0 - p)) + 1.0);
+    }
+  }
+}
+
+template <typename VALUE_TYPE> inline void wrapper_alias(std::string name) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  AliasTable<VALUE_TYPE> table(queue);
+
+  check_frequencies<VALUE_TYPE>(name, table, {1.0, 0.0, 3.0, 6.0, 10.0},
+                                200001);
+
+  // Many categories spanning several chunks with widely varying weights.
+  std::vector<VALUE_TYPE> weights(5000);
+  for (std::size_t ix = 0; ix < weights.size(); ix++) {
+    weights.at(ix) = (ix % 7 == 0) ? 0.0 : std::pow(1.001, ix);
+  }
+  check_frequencies<VALUE_TYPE>(name, table, weights, 1000001);
+
+  // Rebuilding with fewer categories reuses the allocations.
+  check_frequencies<VALUE_TYPE>(name, table, {2.0, 1.0}, 100001);
+  ASSERT_EQ(table.num_categories, 2);
+
+  // A single category with all of the weight.
+  check_frequencies<VALUE_TYPE>(name, table, {0.0, 0.0, 5.0, 0.0}, 1001);
+}
+
+/**
+ * Check that the probabilities the table represents match the weights
+ * exactly, up to rounding, without sampling.
+ */
+template <typename VALUE_TYPE>
+inline void check_table(AliasTable<VALUE_TYPE> &table,
+                        const std::vector<VALUE_TYPE> &weights,
+                        const double tolerance) {
+  sycl::queue &queue = table.queue;
+  const std::size_t n = weights.size();
+  VALUE_TYPE *d_weights = sycl::malloc_device<VALUE_TYPE>(n, queue);
+  queue.memcpy(d_weights, weights.data(), n * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  ASSERT_TRUE(table.build(d_weights, n) == SUCCESS);
+  sycl::free(d_weights, queue);
+
+  auto distribution = table.template get_distribution<int>();
+  std::vector<std::uint32_t> threshold(n);
+  std::vector<std::uint32_t> alias(n);
+  queue.memcpy(threshold.data(), distribution.d_threshold,
+               n * sizeof(std::uint32_t))
+      .wait_and_throw();
+  queue.memcpy(alias.data(), distribution.d_alias, n * sizeof(std::uint32_t))
+      .wait_and_throw();
+
+  double total = 0.0;
+  for (auto weight : weights) {
+    total += weight;
+  }
+  std::vector<double> p(n, 0.0);
+  for (std::size_t bx = 0; bx < n; bx++) {
+    ASSERT_TRUE(alias.at(bx) < n);
+    const double keep =
+        (alias.at(bx) == bx) ? 1.0 : threshold.at(bx) * 0x1.0p-32;
+    p.at(bx) += keep;
+    p.at(alias.at(bx)) += 1.0 - keep;
+  }
+  // The thresholds are rounded to 32 bits, hence categories which fill many
+  // buckets accumulate more rounding.
+  for (std::size_t cx = 0; cx < n; cx++) {
+    const double expected = n * weights.at(cx) / total;
+    ASSERT_NEAR(p.at(cx), expected, tolerance * (1.0 + expected));
+  }
+}
+
+} // namespace
+
+TEST(Alias, scan) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  // One, two and three levels of blocks.
+  for (const std::size_t N : {1000, 5000, 3000000}) {
+    std::vector<std::uint64_t> values(N);
+    for (std::size_t ix = 0; ix < N; ix++) {
+      values.at(ix) = (ix * 7919) % 13;
+    }
+    const std::size_t num_workspace = Private::get_scan_workspace_size(N);
+    std::uint64_t *d_values =
+        sycl::malloc_device<std::uint64_t>(N + num_workspace, queue);
+    queue.memcpy(d_values, values.data(), N * sizeof(std::uint64_t))
+        .wait_and_throw();
+    Private::submit_exclusive_scan(queue, d_values, N, d_values + N)
+        .wait_and_throw();
+    std::vector<std::uint64_t> scanned(N);
+    queue.memcpy(scanned.data(), d_values, N * sizeof(std::uint64_t))
+        .wait_and_throw();
+    sycl::free(d_values, queue);
+
+    std::uint64_t sum = 0;
+    for (std::size_t ix = 0; ix < N; ix++) {
+      ASSERT_EQ(scanned.at(ix), sum);
+      sum += values.at(ix);
+    }
+  }
+}
+
+TEST(Alias, table) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  AliasTable<double> table(queue);
+
+  // Many parts of the sweep, including heavy categories which span parts.
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (const std::size_t n : {7, 1024, 4097, 2000001}) {
+    std::vector<double> weights(n);
+    for (std::size_t ix = 0; ix < n; ix++) {
+      const double u = uniform(rng);
+      weights.at(ix) = (ix % 5 == 0) ? 0.0 : ((u < 0.01) ? 1000.0 * u : u);
+    }
+    check_table(table, weights, 1.0e-6);
+  }
+  // A single heavy category.
+  std::vector<double> weights(10000, 1.0);
+  weights.at(1234) = 1.0e6;
+  check_table(table, weights, 1.0e-6);
+}
+
+TEST(Alias, double) { wrapper_alias<double>("default"); }
+TEST(Alias, float) { wrapper_alias<float>("stdlib"); }
+
+TEST(Alias, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  AliasTable<double> table(queue);
+  double *d_weights = sycl::malloc_device<double>(3, queue);
+
+  ASSERT_TRUE(table.build(d_weights, 0) != SUCCESS);
+  std::vector<double> zero = {0.0, 0.0, 0.0};
+  queue.memcpy(d_weights, zero.data(), 3 * sizeof(double)).wait_and_throw();
+  ASSERT_TRUE(table.build(d_weights, 3) != SUCCESS);
+  std::vector<double> negative = {1.0, -1.0, 2.0};
+  queue.memcpy(d_weights, negative.data(), 3 * sizeof(double))
+      .wait_and_throw();
+  ASSERT_TRUE(table.build(d_weights, 3) != SUCCESS);
+
+  // An empty table cannot be sampled.
+  auto engine = create_engine<double>(1234, device, 0);
+  int *d_ptr = sycl::malloc_device<int>(1, queue);
+  ASSERT_TRUE(engine->get_samples(table.get_distribution<int>(), d_ptr, 1) !=
+              SUCCESS);
+  sycl::free(d_ptr, queue);
+  sycl::free(d_weights, queue);
+}
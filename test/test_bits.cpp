@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename BITS_TYPE>
+inline std::vector<BITS_TYPE> get_bits_samples(std::string platform_name,
+                                               const std::uint64_t seed,
+                                               const std::size_t N) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  auto rng = create_rng<BITS_TYPE>(Distribution::Bits<BITS_TYPE>{}, seed,
+                                   device, 0, platform_name);
+  EXPECT_TRUE(rng != nullptr);
+  BITS_TYPE *d_ptr = sycl::malloc_device<BITS_TYPE>(N, queue);
+  EXPECT_TRUE(rng->get_samples(d_ptr, N) == SUCCESS);
+  std::vector<BITS_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(BITS_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+template <typename BITS_TYPE>
+inline void check_bit_frequencies(const std::vector<BITS_TYPE> &samples) {
+  const int num_bits = 8 * sizeof(BITS_TYPE);
+  const std::size_t N = samples.size();
+  std::vector<std::size_t> counts(num_bits, 0);
+  for (auto value : samples) {
+    for (int bx = 0; bx < num_bits; bx++) {
+      counts.at(bx) += (value >> bx) & 1;
+    }
+  }
+  for (auto count : counts) {
+    ASSERT_NEAR(count, N / 2, 0.02 * N / 2);
+  }
+}
+
+template <typename BITS_TYPE> inline void wrapper_bits(std::string name) {
+  const std::size_t N = 100001;
+  auto samples = get_bits_samples<BITS_TYPE>(name, 1234, N);
+  check_bit_frequencies(samples);
+
+  // Identically seeded RNGs should produce identical samples.
+  ASSERT_EQ(samples, get_bits_samples<BITS_TYPE>(name, 1234, N));
+  ASSERT_NE(samples, get_bits_samples<BITS_TYPE>(name, 4321, N));
+}
+
+template <typename BITS_TYPE> inline void wrapper_engine_bits() {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t N = 100001;
+
+  auto engine = create_engine<double>(1234, device, 0);
+  BITS_TYPE *d_ptr = sycl::malloc_device<BITS_TYPE>(N, queue);
+  ASSERT_TRUE(engine->get_samples(Distribution::Bits<BITS_TYPE>{}, d_ptr, N) ==
+              SUCCESS);
+  std::vector<BITS_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(BITS_TYPE)).wait_and_throw();
+  check_bit_frequencies(samples);
+  sycl::free(d_ptr, queue);
+}
+
+} // namespace
+
+TEST(Bits, uint32) { wrapper_bits<std::uint32_t>("default"); }
+TEST(Bits, uint64) { wrapper_bits<std::uint64_t>("default"); }
+
+TEST(Bits, stdlib) {
+  // The stdlib words are the words of the underlying generator.
+  const std::size_t N = 1001;
+  auto samples_64 = get_bits_samples<std::uint64_t>("stdlib", 1234, N);
+  auto samples_32 = get_bits_samples<std::uint32_t>("stdlib", 1234, 2 * N);
+  std::mt19937_64 correct_rng(1234);
+  for (std::size_t ix = 0; ix < N; ix++) {
+    const std::uint64_t correct = correct_rng();
+    ASSERT_EQ(samples_64.at(ix), correct);
+    ASSERT_EQ(samples_32.at(2 * ix), static_cast<std::uint32_t>(correct));
+    ASSERT_EQ(samples_32.at(2 * ix + 1),
+              static_cast<std::uint32_t>(correct >> 32));
+  }
+}
+
+TEST(Bits, engine_uint32) { wrapper_engine_bits<std::uint32_t>(); }
+TEST(Bits, engine_uint64) { wrapper_engine_bits<std::uint64_t>(); }
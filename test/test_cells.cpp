@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+/**
+ * Sample positions in cells with num_per_cell positions in each cell.
+ * Returns the positions in the AoS layout and checks the cell indices.
+ */
+template <typename VALUE_TYPE>
+inline std::vector<VALUE_TYPE>
+get_positions(const Distribution::CellShape shape, const std::size_t ndim,
+              const std::vector<VALUE_TYPE> &cells,
+              const std::vector<std::size_t> &num_per_cell,
+              const Distribution::Layout layout = Distribution::Layout::AoS) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t num_cells = num_per_cell.size();
+  std::vector<std::size_t> offsets(num_cells + 1, 0);
+  for (std::size_t cx = 0; cx < num_cells; cx++) {
+    offsets.at(cx + 1) = offsets.at(cx) + num_per_cell.at(cx);
+  }
+  const std::size_t N = offsets.back();
+
+  VALUE_TYPE *d_cells = sycl::malloc_device<VALUE_TYPE>(cells.size(), queue);
+  std::size_t *d_offsets =
+      sycl::malloc_device<std::size_t>(num_cells + 1, queue);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(ndim * N, queue);
+  int *d_cell_ids = sycl::malloc_device<int>(N, queue);
+  queue.memcpy(d_cells, cells.data(), cells.size() * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  queue.memcpy(d_offsets, offsets.data(), offsets.size() * sizeof(std::size_t))
+      .wait_and_throw();
+
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0);
+  Distribution::CellPositions<VALUE_TYPE> distribution{
+      shape, ndim, d_cells, d_offsets, num_cells, layout};
+  EXPECT_TRUE(engine->get_samples(distribution, d_ptr, d_cell_ids, N) ==
+              SUCCESS);
+  std::vector<VALUE_TYPE> samples(ndim * N);
+  std::vector<int> cell_ids(N);
+  queue.memcpy(samples.data(), d_ptr, ndim * N * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  queue.memcpy(cell_ids.data(), d_cell_ids, N * sizeof(int)).wait_and_throw();
+
+  for (std::size_t cx = 0; cx < num_cells; cx++) {
+    for (std::size_t ix = offsets.at(cx); ix < offsets.at(cx + 1); ix++) {
+      EXPECT_EQ(cell_ids.at(ix), static_cast<int>(cx));
+    }
+  }
+
+  sycl::free(d_cells, queue);
+  sycl::free(d_offsets, queue);
+  sycl::free(d_ptr, queue);
+  sycl::free(d_cell_ids, queue);
+
+  if (layout == Distribution::Layout::SoA) {
+    std::vector<VALUE_TYPE> aos(ndim * N);
+    for (std::size_t ix = 0; ix < N; ix++) {
+      for (std::size_t dx = 0; dx < ndim; dx++) {
+        aos.at(ix * ndim + dx) = samples.at(dx * N + ix);
+      }
+    }
+    return aos;
+  }
+  return samples;
+}
+
+/**
+ * Check the mean position of the samples in [start, end).
+ */
+template <typename VALUE_TYPE>
+inline void check_mean(const std::vector<VALUE_TYPE> &samples,
+                       const std::size_t ndim, const std::size_t start,
+                       const std::size_t end,
+                       const std::vector<double> &correct,
+                       const double tol) {
+  for (std::size_t dx = 0; dx < ndim; dx++) {
+    double mean = 0.0;
+    for (std::size_t ix = start; ix < end; ix++) {
+      mean += samples.at(ix * ndim + dx);
+    }
+    mean /= (end - start);
+    ASSERT_NEAR(mean, correct.at(dx), tol);
+  }
+}
+
+template <typename VALUE_TYPE> inline void wrapper_cells() {
+  using Distribution::CellShape;
+  const double tol = 1.0e-5;
+
+  // Boxes with a cell with no samples.
+  {
+    std::vector<VALUE_TYPE> cells = {0.0, 0.0, 0.0, 1.0, 2.0, 3.0,
+                                     5.0, 5.0, 5.0, 6.0, 6.0, 6.0,
+                                     -4.0, 1.0, 2.0, -2.0, 1.5, 2.5};
+    const std::vector<std::size_t> num_per_cell = {20000, 0, 30001};
+    auto samples = get_positions(CellShape::Box, 3, cells, num_per_cell);
+    for (std::size_t ix = 0; ix < 50001; ix++) {
+      const VALUE_TYPE *box = cells.data() + ((ix < 20000) ? 0 : 12);
+      for (std::size_t dx = 0; dx < 3; dx++) {
+        const VALUE_TYPE value = samples.at(ix * 3 + dx);
+        ASSERT_TRUE((box[dx] <= value) && (value <= box[3 + dx]));
+      }
+    }
+    check_mean(samples, 3, 0, 20000, {0.5, 1.0, 1.5}, 0.02);
+    check_mean(samples, 3, 20000, 50001, {-3.0, 1.25, 2.25}, 0.02);
+
+    // The layout only changes where the components are stored.
+    ASSERT_EQ(samples, get_positions(CellShape::Box, 3, cells, num_per_cell,
+                                     Distribution::Layout::SoA));
+  }
+
+  // Triangles, a sample is in the central triangle formed by the edge
+  // midpoints with probability 1/4.
+  {
+    std::vector<VALUE_TYPE> cells = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0,
+                                     2.0, 2.0, 4.0, 2.0, 3.0, 5.0};
+    auto samples = get_positions(CellShape::Triangle, 2, cells, {50000, 10});
+    std::size_t num_central = 0;
+    for (std::size_t ix = 0; ix < 50000; ix++) {
+      const double x = samples.at(ix * 2);
+      const double y = samples.at(ix * 2 + 1);
+      ASSERT_TRUE((x >= -tol) && (y >= -tol) && (x + y <= 1.0 + tol));
+      num_central += ((x <= 0.5) && (y <= 0.5) && (x + y >= 0.5)) ? 1 : 0;
+    }
+    ASSERT_NEAR(num_central, 12500, 0.04 * 12500);
+    check_mean(samples, 2, 0, 50000, {1.0 / 3.0, 1.0 / 3.0}, 0.01);
+  }
+
+  // A triangle embedded in 3D lies in the plane of the vertices.
+  {
+    std::vector<VALUE_TYPE> cells = {0.0, 0.0, 0.0, 1.0, 0.0, 1.0,
+                                     0.0, 2.0, 2.0};
+    auto samples = get_positions(CellShape::Triangle, 3, cells, {10000});
+    for (std::size_t ix = 0; ix < 10000; ix++) {
+      ASSERT_NEAR(samples.at(ix * 3 + 2),
+                  samples.at(ix * 3) + samples.at(ix * 3 + 1), 1.0e-4);
+    }
+    check_mean(samples, 3, 0, 10000, {1.0 / 3.0, 2.0 / 3.0, 1.0}, 0.02);
+  }
+
+  // A trapezoid, the area of the two triangles differs.
+  {
+    std::vector<VALUE_TYPE> cells = {0.0, 0.0, 4.0, 0.0, 3.0, 2.0, 1.0, 2.0};
+    auto samples = get_positions(CellShape::Quadrilateral, 2, cells, {100000});
+    std::size_t num_lower = 0;
+    for (std::size_t ix = 0; ix < 100000; ix++) {
+      const double x = samples.at(ix * 2);
+      const double y = samples.at(ix * 2 + 1);
+      ASSERT_TRUE((y >= -tol) && (y <= 2.0 + tol));
+      ASSERT_TRUE((x >= 0.5 * y - tol) && (x <= 4.0 - 0.5 * y + tol));
+      num_lower += (y < 1.0) ? 1 : 0;
+    }
+    // The area below y = 1 is 3.5 of the total area 6.
+    ASSERT_NEAR(num_lower, 100000 * 3.5 / 6.0, 0.02 * 100000 * 3.5 / 6.0);
+    check_mean(samples, 2, 0, 100000, {2.0, 8.0 / 9.0}, 0.02);
+  }
+
+  // Tetrahedra, a sample is in the corner tetrahedron of half the edge length
+  // with probability 1/8.
+  {
+    std::vector<VALUE_TYPE> cells = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0,
+                                     0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    auto samples = get_positions(CellShape::Tetrahedron, 3, cells, {100000});
+    std::size_t num_corner = 0;
+    for (std::size_t ix = 0; ix < 100000; ix++) {
+      const double x = samples.at(ix * 3);
+      const double y = samples.at(ix * 3 + 1);
+      const double z = samples.at(ix * 3 + 2);
+      ASSERT_TRUE((x >= -tol) && (y >= -tol) && (z >= -tol) &&
+                  (x + y + z <= 1.0 + tol));
+      num_corner += (x + y + z < 0.5) ? 1 : 0;
+    }
+    ASSERT_NEAR(num_corner, 12500, 0.03 * 12500);
+    check_mean(samples, 3, 0, 100000, {0.25, 0.25, 0.25}, 0.01);
+  }
+}
+
+} // namespace
+
+TEST(Cells, double) { wrapper_cells<double>(); }
+TEST(Cells, float) { wrapper_cells<float>(); }
+
+TEST(Cells, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  auto engine = create_engine<double>(1234, device, 0);
+  double *d_ptr = sycl::malloc_device<double>(3, queue);
+  ASSERT_TRUE(engine->get_samples(
+                  Distribution::CellPositions<double>{
+                      Distribution::CellShape::Tetrahedron, 2, d_ptr, nullptr,
+                      1},
+                  d_ptr, 1) != SUCCESS);
+  ASSERT_TRUE(engine->get_samples(
+                  Distribution::CellPositions<double>{
+                      Distribution::CellShape::Triangle, 1, d_ptr, nullptr, 1},
+                  d_ptr, 1) != SUCCESS);
+  sycl::free(d_ptr, queue);
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE, typename INT_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<INT_TYPE>
+get_discrete_samples(std::string platform_name, DISTRIBUTION_TYPE distribution,
+                     const std::size_t N) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::uint64_t seed = 1234;
+
+  auto engine = create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+  INT_TYPE *d_ptr = sycl::malloc_device<INT_TYPE>(N, queue);
+  std::vector<INT_TYPE> samples(N);
+  EXPECT_TRUE(engine->get_samples(distribution, d_ptr, N) == SUCCESS);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(INT_TYPE)).wait_and_throw();
+
+  // An identically seeded engine should produce identical samples.
+  auto correct_engine =
+      create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+  std::vector<INT_TYPE> correct(N);
+  EXPECT_TRUE(correct_engine->get_samples(distribution, d_ptr, N) == SUCCESS);
+  queue.memcpy(correct.data(), d_ptr, N * sizeof(INT_TYPE)).wait_and_throw();
+  EXPECT_EQ(samples, correct);
+
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+template <typename INT_TYPE>
+inline void check_moments(const std::vector<INT_TYPE> &samples,
+                          const double correct_mean,
+                          const double correct_variance) {
+  const std::size_t N = samples.size();
+  double mean = 0.0;
+  for (auto value : samples) {
+    mean += value;
+  }
+  mean /= N;
+  double variance = 0.0;
+  for (auto value : samples) {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= (N - 1);
+  ASSERT_NEAR(mean, correct_mean, 0.02 * correct_mean);
+  ASSERT_NEAR(variance, correct_variance, 0.05 * correct_variance);
+}
+
+template <typename VALUE_TYPE> inline void wrapper_discrete(std::string name) {
+  const std::size_t N = 100001;
+
+  // Every value of a small interval should be equally likely.
+  {
+    auto samples = get_discrete_samples<VALUE_TYPE, int>(
+        name, Distribution::UniformInt<int>{-3, 4}, N);
+    std::vector<std::size_t> counts(8, 0);
+    for (auto value : samples) {
+      ASSERT_TRUE((-3 <= value) && (value <= 4));
+      counts.at(value + 3)++;
+    }
+    for (auto count : counts) {
+      ASSERT_NEAR(count, N / 8, 0.05 * N / 8);
+    }
+  }
+  // Intervals which require the 64-bit method, including every value.
+  {
+    const std::int64_t a = -5;
+    const std::int64_t b = 1ll << 40;
+    auto samples = get_discrete_samples<VALUE_TYPE, std::int64_t>(
+        name, Distribution::UniformInt<std::int64_t>{a, b}, N);
+    for (auto value : samples) {
+      ASSERT_TRUE((a <= value) && (value <= b));
+    }
+    check_moments(samples, 0.5 * (a + b), 0.0833333333 * b * b);
+
+    std::size_t num_top_bit_set = 0;
+    auto samples_full = get_discrete_samples<VALUE_TYPE, std::uint64_t>(
+        name,
+        Distribution::UniformInt<std::uint64_t>{
+            0, std::numeric_limits<std::uint64_t>::max()},
+        N);
+    for (auto value : samples_full) {
+      num_top_bit_set += (value >> 63);
+    }
+    ASSERT_NEAR(num_top_bit_set, N / 2, 0.02 * N / 2);
+  }
+
+  {
+    auto samples = get_discrete_samples<VALUE_TYPE, int>(
+        name, Distribution::Bernoulli<int>{0.3}, N);
+    for (auto value : samples) {
+      ASSERT_TRUE((value == 0) || (value == 1));
+    }
+    check_moments(samples, 0.3, 0.3 * 0.7);
+  }
+
+  // Both the small mean and large mean methods.
+  for (const double lambda : {0.5, 3.5, 10.0, 150.0, 1.0e5}) {
+    auto samples = get_discrete_samples<VALUE_TYPE, std::int64_t>(
+        name, Distribution::Poisson<std::int64_t>{lambda}, N);
+    for (auto value : samples) {
+      ASSERT_TRUE(value >= 0);
+    }
+    check_moments(samples, lambda, lambda);
+  }
+
+  // The inversion method, the rejection method and p > 0.5.
+  for (const auto distribution :
+       {Distribution::Binomial<int>{20, 0.3},
+        Distribution::Binomial<int>{1000, 0.4},
+        Distribution::Binomial<int>{1000, 0.9},
+        Distribution::Binomial<int>{100000, 0.05}}) {
+    auto samples = get_discrete_samples<VALUE_TYPE, int>(name, distribution, N);
+    for (auto value : samples) {
+      ASSERT_TRUE((0 <= value) && (value <= distribution.n));
+    }
+    const double n = distribution.n;
+    const double p = distribution.p;
+    check_moments(samples, n * p, n * p * (1.0 - p));
+  }
+
+  // Degenerate parameters.
+  {
+    auto samples = get_discrete_samples<VALUE_TYPE, int>(
+        name, Distribution::Binomial<int>{7, 1.0}, 11);
+    ASSERT_EQ(samples, std::vector<int>(11, 7));
+    samples = get_discrete_samples<VALUE_TYPE, int>(
+        name, Distribution::Poisson<int>{0.0}, 11);
+    ASSERT_EQ(samples, std::vector<int>(11, 0));
+    samples = get_discrete_samples<VALUE_TYPE, int>(
+        name, Distribution::UniformInt<int>{3, 3}, 11);
+    ASSERT_EQ(samples, std::vector<int>(11, 3));
+  }
+}
+
+} // namespace
+
+TEST(Discrete, philox) {
+  // Known answer tests from the Random123 distribution.
+  const std::uint32_t counters[3][4] = {
+      {0, 0, 0, 0},
+      {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+      {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+  const std::uint32_t keys[3][2] = {
+      {0, 0}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+  const std::uint32_t correct[3][4] = {
+      {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+      {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+      {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+  for (int tx = 0; tx < 3; tx++) {
+    std::uint32_t output[4];
+    Private::Philox4x32x10::generate(counters[tx], keys[tx], output);
+    for (int ix = 0; ix < 4; ix++) {
+      ASSERT_EQ(output[ix], correct[tx][ix]);
+    }
+  }
+}
+
+TEST(Discrete, philox_uniform_bounds) {
+  // Fill the buffer of a stream with a single word such that the next samples
+  // are formed from that word.
+  auto get_stream = [](const std::uint32_t word) {
+    Private::PhiloxStream stream(0, 0, 0);
+    for (int ix = 0; ix < 4; ix++) {
+      stream.buffer[ix] = word;
+    }
+    stream.buffer_index = 0;
+    return stream;
+  };
+
+  for (const std::uint32_t word : {0xffffffffu, 0u}) {
+    auto stream = get_stream(word);
+    const double sample_double = stream.next_uniform<double>();
+    const float sample_float = stream.next_uniform<float>();
+    ASSERT_GT(sample_double, 0.0);
+    ASSERT_LT(sample_double, 1.0);
+    ASSERT_GT(sample_float, 0.0f);
+    ASSERT_LT(sample_float, 1.0f);
+  }
+
+  // Bernoulli samples with p = 1 and p = 0 are certain for every word.
+  const Distribution::Bernoulli<int> certain{1.0};
+  const Distribution::Bernoulli<int> impossible{0.0};
+  for (const std::uint32_t word : {0xffffffffu, 0u}) {
+    auto stream = get_stream(word);
+    ASSERT_EQ(Private::sample_discrete<double>(certain, stream), 1);
+    ASSERT_EQ(Private::sample_discrete<float>(certain, stream), 1);
+    stream = get_stream(word);
+    ASSERT_EQ(Private::sample_discrete<double>(impossible, stream), 0);
+    ASSERT_EQ(Private::sample_discrete<float>(impossible, stream), 0);
+  }
+}
+
+TEST(Discrete, philox_key_word) {
+  // Uniform samples equal to one are clamped to the largest representable
+  // word below 2^32.
+  ASSERT_EQ(Private::get_key_word(1.0, 0.0), 0xffffffffu);
+  ASSERT_EQ(Private::get_key_word(1.0f, 0.0f), 0xffffff00u);
+  ASSERT_EQ(Private::get_key_word(0.0, 1.0), 0xffffffffu);
+  ASSERT_EQ(Private::get_key_word(0.5, 0.0), 0x80000000u);
+  ASSERT_EQ(Private::get_key_word(0.0f, 0.5f), 0x00008000u);
+}
+
+TEST(Discrete, double) { wrapper_discrete<double>("default"); }
+TEST(Discrete, float) { wrapper_discrete<float>("stdlib"); }
+
+TEST(Discrete, stream) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t N = 1001;
+
+  // Discrete samples advance the stream of the engine.
+  auto engine = create_engine<double>(1234, device, 0);
+  int *d_ptr = sycl::malloc_device<int>(N, queue);
+  std::vector<int> samples_0(N);
+  std::vector<int> samples_1(N);
+  ASSERT_TRUE(engine->get_samples(Distribution::UniformInt<int>{0, 1000},
+                                  d_ptr, N) == SUCCESS);
+  queue.memcpy(samples_0.data(), d_ptr, N * sizeof(int)).wait_and_throw();
+  ASSERT_TRUE(engine->get_samples(Distribution::UniformInt<int>{0, 1000},
+                                  d_ptr, N) == SUCCESS);
+  queue.memcpy(samples_1.data(), d_ptr, N * sizeof(int)).wait_and_throw();
+  ASSERT_NE(samples_0, samples_1);
+
+  // Waiting on a pointer without samples in flight is an error.
+  ASSERT_TRUE(engine->wait_get_samples(d_ptr) != SUCCESS);
+  sycl::free(d_ptr, queue);
+}
@@ -0,0 +1,564 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_engine(DISTRIBUTION_TYPE distribution,
+                           std::string platform_name) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  for (std::size_t N : {0, 1, 2, 3, 127, 301, 10238, 10239}) {
+    const std::uint64_t seed = 1234;
+    const std::size_t num_bytes = N * sizeof(VALUE_TYPE);
+
+    // An engine with fixed parameters should reproduce the samples of an RNG
+    // created with the same parameters.
+    auto to_test_engine =
+        create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+    ASSERT_NE(to_test_engine, nullptr);
+    auto correct_rng = create_rng<VALUE_TYPE>(distribution, seed, device, 0,
+                                              platform_name);
+    ASSERT_EQ(to_test_engine->platform_name, correct_rng->platform_name);
+
+    VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+    std::vector<VALUE_TYPE> correct(N);
+    std::vector<VALUE_TYPE> to_test(N);
+
+    for (int tx = 0; tx < 2; tx++) {
+      ASSERT_TRUE(to_test_engine->get_samples(distribution, d_ptr, N) ==
+                  SUCCESS);
+      queue.memcpy(to_test.data(), d_ptr, num_bytes).wait_and_throw();
+      ASSERT_TRUE(correct_rng->get_samples(d_ptr, N) == SUCCESS);
+      queue.memcpy(correct.data(), d_ptr, num_bytes).wait_and_throw();
+      ASSERT_EQ(to_test, correct);
+    }
+
+    sycl::free(d_ptr, queue);
+  }
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_engine_array(std::string platform_name) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 10239;
+  const std::uint64_t seed = 1234;
+  const std::size_t num_bytes = N * sizeof(VALUE_TYPE);
+
+  // Per sample parameters.
+  std::vector<VALUE_TYPE> h_p0(N);
+  std::vector<VALUE_TYPE> h_p1(N);
+  for (std::size_t ix = 0; ix < N; ix++) {
+    h_p0.at(ix) = static_cast<VALUE_TYPE>(ix % 7) - 3.0;
+    h_p1.at(ix) = h_p0.at(ix) + 1.0 + static_cast<VALUE_TYPE>(ix % 5);
+  }
+  // Per segment parameters where segment s has parameters s.
+  std::vector<std::size_t> h_offsets = {0, 0, 13, 1000, 1001, 8000, N};
+  const std::size_t num_segments = h_offsets.size() - 1;
+  std::vector<std::size_t> h_segment(N);
+  for (std::size_t sx = 0; sx < num_segments; sx++) {
+    for (std::size_t ix = h_offsets.at(sx); ix < h_offsets.at(sx + 1); ix++) {
+      h_segment.at(ix) = sx;
+    }
+  }
+
+  VALUE_TYPE *d_p0 = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  VALUE_TYPE *d_p1 = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  std::size_t *d_offsets = sycl::malloc_device<std::size_t>(N, queue);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  queue.memcpy(d_p0, h_p0.data(), num_bytes).wait_and_throw();
+  queue.memcpy(d_p1, h_p1.data(), num_bytes).wait_and_throw();
+  queue
+      .memcpy(d_offsets, h_offsets.data(),
+              h_offsets.size() * sizeof(std::size_t))
+      .wait_and_throw();
+
+  auto to_test_engine =
+      create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+  auto correct_engine =
+      create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+
+  std::vector<VALUE_TYPE> to_test(N);
+  std::vector<VALUE_TYPE> correct(N);
+  // The standard samples are drawn in pairs from a Philox stream per pair
+  // keyed by four Uniform samples of the Engine.
+  auto lambda_standard = [&](auto distribution) {
+    VALUE_TYPE key[4];
+    ASSERT_TRUE(correct_engine->get_samples(
+                    Distribution::Uniform<VALUE_TYPE>{0.0, 1.0}, d_ptr, 4) ==
+                SUCCESS);
+    queue.memcpy(key, d_ptr, 4 * sizeof(VALUE_TYPE)).wait_and_throw();
+    for (std::size_t ix = 0; ix < N; ix += 2) {
+      Private::PhiloxStream stream(Private::get_key_word(key[0], key[1]),
+                                   Private::get_key_word(key[2], key[3]),
+                                   ix / 2);
+      VALUE_TYPE samples[2];
+      Private::sample_standard_pair(distribution, stream, samples);
+      correct.at(ix) = samples[0];
+      if (ix + 1 < N) {
+        correct.at(ix + 1) = samples[1];
+      }
+    }
+  };
+  auto lambda_check = [&](auto lambda_index, auto lambda_map) {
+    queue.memcpy(to_test.data(), d_ptr, num_bytes).wait_and_throw();
+    for (std::size_t ix = 0; ix < N; ix++) {
+      const std::size_t px = lambda_index(ix);
+      const VALUE_TYPE c = lambda_map(correct.at(ix), px);
+      ASSERT_NEAR(to_test.at(ix), c, 1.0e-5 * std::abs(c) + 1.0e-5);
+    }
+  };
+
+  for (const bool segmented : {false, true}) {
+    const std::size_t *k_offsets = segmented ? d_offsets : nullptr;
+    auto lambda_index = [&](const std::size_t ix) {
+      return segmented ? h_segment.at(ix) : ix;
+    };
+
+    const Distribution::UniformArray<VALUE_TYPE> uniform_array{
+        d_p0, d_p1, k_offsets, num_segments};
+    lambda_standard(uniform_array);
+    ASSERT_TRUE(to_test_engine->get_samples(uniform_array, d_ptr, N) ==
+                SUCCESS);
+    lambda_check(lambda_index, [&](const VALUE_TYPE u, const std::size_t px) {
+      return u * (h_p1.at(px) - h_p0.at(px)) + h_p0.at(px);
+    });
+    for (std::size_t ix = 0; ix < N; ix++) {
+      const std::size_t px = lambda_index(ix);
+      ASSERT_TRUE(to_test.at(ix) >= h_p0.at(px));
+      ASSERT_TRUE(to_test.at(ix) < h_p1.at(px));
+    }
+
+    const Distribution::NormalArray<VALUE_TYPE> normal_array{
+        d_p0, d_p1, k_offsets, num_segments};
+    lambda_standard(normal_array);
+    ASSERT_TRUE(to_test_engine->get_samples(normal_array, d_ptr, N) ==
+                SUCCESS);
+    lambda_check(lambda_index, [&](const VALUE_TYPE z, const std::size_t px) {
+      return z * h_p1.at(px) + h_p0.at(px);
+    });
+  }
+
+  sycl::free(d_p0, queue);
+  sycl::free(d_p1, queue);
+  sycl::free(d_offsets, queue);
+  sycl::free(d_ptr, queue);
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_engine_maxwellian(std::string platform_name) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 3001;
+  const std::uint64_t seed = 1234;
+
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(3 * N, queue);
+  VALUE_TYPE *d_key = sycl::malloc_device<VALUE_TYPE>(4, queue);
+  std::vector<VALUE_TYPE> to_test(3 * N);
+
+  for (const std::size_t ndim : {1, 2, 3}) {
+    for (const auto layout :
+         {Distribution::Layout::AoS, Distribution::Layout::SoA}) {
+      // Including 2 * kappa + 2 - ndim which is not an integer.
+      for (const VALUE_TYPE kappa : {0.0, 1.5, 1.6, 3.0}) {
+        Distribution::Maxwellian<VALUE_TYPE> distribution{
+            ndim, {1.0, -2.0, 3.0}, {0.5, 2.0, 1.5}, kappa, layout};
+        const VALUE_TYPE dof = 2.0 * kappa + 2.0 - ndim;
+
+        auto to_test_engine =
+            create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+        auto correct_engine =
+            create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+
+        ASSERT_TRUE(to_test_engine->get_samples(distribution, d_ptr, N) ==
+                    SUCCESS);
+        queue.memcpy(to_test.data(), d_ptr, ndim * N * sizeof(VALUE_TYPE))
+            .wait_and_throw();
+
+        // Each vector is drawn from a Philox stream keyed by four Uniform
+        // samples of the Engine: the Normal components in Box-Muller pairs
+        // then the Chi-squared sample as a Gamma(dof / 2, 2) sample.
+        VALUE_TYPE key[4];
+        ASSERT_TRUE(correct_engine->get_samples(
+                        Distribution::Uniform<VALUE_TYPE>{0.0, 1.0}, d_key,
+                        4) == SUCCESS);
+        queue.memcpy(key, d_key, 4 * sizeof(VALUE_TYPE)).wait_and_throw();
+
+        for (std::size_t ix = 0; ix < N; ix++) {
+          Private::PhiloxStream stream(Private::get_key_word(key[0], key[1]),
+                                       Private::get_key_word(key[2], key[3]),
+                                       ix);
+          VALUE_TYPE z[3];
+          for (std::size_t dx = 0; dx < ndim; dx += 2) {
+            const VALUE_TYPE r =
+                std::sqrt(-2.0 * std::log(stream.next_uniform<VALUE_TYPE>()));
+            const VALUE_TYPE theta =
+                static_cast<VALUE_TYPE>(6.283185307179586) *
+                stream.next_uniform<VALUE_TYPE>();
+            z[dx] = r * std::cos(theta);
+            if (dx + 1 < ndim) {
+              z[dx + 1] = r * std::sin(theta);
+            }
+          }
+          VALUE_TYPE scaling = 1.0;
+          if (kappa != 0.0) {
+            const VALUE_TYPE chi = Private::sample_gamma(
+                Distribution::Gamma<VALUE_TYPE>{
+                    static_cast<VALUE_TYPE>(0.5) * dof, 2.0},
+                stream);
+            scaling = std::sqrt(2.0 * kappa / chi);
+          }
+          for (std::size_t dx = 0; dx < ndim; dx++) {
+            const std::size_t index = (layout == Distribution::Layout::SoA)
+                                          ? dx * N + ix
+                                          : ix * ndim + dx;
+            const VALUE_TYPE c = distribution.drift[dx] +
+                                 distribution.thermal_velocity[dx] * scaling *
+                                     z[dx];
+            ASSERT_NEAR(to_test.at(index), c, 1.0e-4 * std::abs(c) + 1.0e-4);
+          }
+        }
+      }
+    }
+  }
+
+  // 2 * kappa + 2 - ndim must be positive.
+  auto engine = create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+  ASSERT_EQ(
+      engine->get_samples(Distribution::Maxwellian<VALUE_TYPE>{3, {}, {}, 0.4},
+                          d_ptr, N),
+      -102);
+  ASSERT_TRUE(engine->get_samples(Distribution::Maxwellian<VALUE_TYPE>{4},
+                                  d_ptr, N) != SUCCESS);
+
+  sycl::free(d_ptr, queue);
+  sycl::free(d_key, queue);
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_engine_strided(DISTRIBUTION_TYPE distribution,
+                                   const std::size_t num_values_per_sample,
+                                   std::string platform_name) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  // More samples than one host block of the stdlib platforms.
+  const std::size_t N = 2501;
+  const std::size_t num_values = num_values_per_sample * N;
+  const std::uint64_t seed = 1234;
+  const VALUE_TYPE fill_value = -12345.0;
+
+  // Interleaved component 1 of 3, a pitched 2D layout and a contiguous layout.
+  const std::size_t offset = 1;
+  for (const auto layout : {Distribution::Strided{1, 3},
+                            Distribution::Strided{5, 8},
+                            Distribution::Strided{4, 4}}) {
+    const std::size_t num_blocks =
+        (num_values + layout.block_size - 1) / layout.block_size;
+    const std::size_t size = offset + num_blocks * layout.stride;
+    VALUE_TYPE *d_to_test = sycl::malloc_device<VALUE_TYPE>(size, queue);
+    VALUE_TYPE *d_correct = sycl::malloc_device<VALUE_TYPE>(num_values, queue);
+    std::vector<VALUE_TYPE> to_test(size);
+    std::vector<VALUE_TYPE> correct(num_values);
+
+    auto to_test_engine =
+        create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+    auto correct_engine =
+        create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+
+    // Repeat to check the scratch space of the engine is reused correctly.
+    for (int rx = 0; rx < 2; rx++) {
+      queue.fill(d_to_test, fill_value, size).wait_and_throw();
+      ASSERT_TRUE(to_test_engine->get_samples(distribution, layout,
+                                              d_to_test + offset,
+                                              N) == SUCCESS);
+      ASSERT_TRUE(correct_engine->get_samples(distribution, d_correct, N) ==
+                  SUCCESS);
+      queue.memcpy(to_test.data(), d_to_test, size * sizeof(VALUE_TYPE))
+          .wait_and_throw();
+      queue.memcpy(correct.data(), d_correct, num_values * sizeof(VALUE_TYPE))
+          .wait_and_throw();
+
+      std::vector<bool> written(size, false);
+      for (std::size_t ix = 0; ix < num_values; ix++) {
+        const std::size_t index = offset +
+                                  (ix / layout.block_size) * layout.stride +
+                                  ix % layout.block_size;
+        ASSERT_EQ(to_test.at(index), correct.at(ix));
+        written.at(index) = true;
+      }
+      for (std::size_t ix = 0; ix < size; ix++) {
+        if (!written.at(ix)) {
+          ASSERT_EQ(to_test.at(ix), fill_value);
+        }
+      }
+    }
+
+    sycl::free(d_to_test, queue);
+    sycl::free(d_correct, queue);
+  }
+
+  // The block size must be non-zero and no larger than the stride.
+  auto engine = create_engine<VALUE_TYPE>(seed, device, 0, platform_name);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(num_values, queue);
+  ASSERT_TRUE(engine->get_samples(distribution, Distribution::Strided{0, 1},
+                                  d_ptr, N) != SUCCESS);
+  ASSERT_TRUE(engine->get_samples(distribution, Distribution::Strided{2, 1},
+                                  d_ptr, N) != SUCCESS);
+  sycl::free(d_ptr, queue);
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_engine_moments(EngineSharedPtr<VALUE_TYPE> engine,
+                                   DISTRIBUTION_TYPE distribution,
+                                   const double correct_mean,
+                                   const double correct_variance) {
+  sycl::queue queue{engine->device};
+
+  const std::size_t N = 100001;
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  std::vector<VALUE_TYPE> to_test(N);
+  ASSERT_TRUE(engine->get_samples(distribution, d_ptr, N) == SUCCESS);
+  queue.memcpy(to_test.data(), d_ptr, N * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+
+  double mean = 0.0;
+  for (auto value : to_test) {
+    // All of these distributions have positive support.
+    ASSERT_TRUE(value >= 0.0);
+    ASSERT_TRUE(std::isfinite(value));
+    mean += value;
+  }
+  mean /= N;
+  double variance = 0.0;
+  for (auto value : to_test) {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= (N - 1);
+
+  ASSERT_NEAR(mean, correct_mean, 0.02 * correct_mean);
+  ASSERT_NEAR(variance, correct_variance, 0.05 * correct_variance);
+  sycl::free(d_ptr, queue);
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_engine_continuous(std::string platform_name) {
+  sycl::device device{sycl::default_selector_v};
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0, platform_name);
+
+  const double lambda = 2.0;
+  wrapper_engine_moments(engine, Distribution::Exponential<VALUE_TYPE>{2.0},
+                         1.0 / lambda, 1.0 / (lambda * lambda));
+
+  const double m = 0.5;
+  const double s = 0.25;
+  wrapper_engine_moments(engine, Distribution::LogNormal<VALUE_TYPE>{0.5, 0.25},
+                         std::exp(m + 0.5 * s * s),
+                         (std::exp(s * s) - 1.0) * std::exp(2.0 * m + s * s));
+
+  const double alpha = 2.5;
+  const double beta = 1.5;
+  wrapper_engine_moments(engine, Distribution::Gamma<VALUE_TYPE>{2.5, 1.5},
+                         alpha * beta, alpha * beta * beta);
+  // A shape less than one uses a different method in most implementations.
+  wrapper_engine_moments(engine, Distribution::Gamma<VALUE_TYPE>{0.5, 2.0},
+                         1.0, 2.0);
+}
+
+} // namespace
+
+TEST(Engine, uniform_double) {
+  wrapper_engine<double>(Distribution::Uniform<double>{-2.0, 2.0}, "default");
+}
+TEST(Engine, normal_double) {
+  wrapper_engine<double>(Distribution::Normal<double>{3.0, 2.0}, "default");
+}
+TEST(Engine, uniform_float) {
+  wrapper_engine<float>(Distribution::Uniform<float>{-2.0, 2.0}, "stdlib");
+}
+TEST(Engine, normal_float) {
+  wrapper_engine<float>(Distribution::Normal<float>{3.0, 2.0}, "stdlib");
+}
+
+TEST(Engine, stdlib_mixed) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 1031;
+  const std::uint64_t seed = 1234;
+  auto engine = create_engine<double>(seed, device, 0, "stdlib");
+  ASSERT_EQ(engine->platform_name, "stdlib");
+
+  // All distributions should advance the same stream.
+  auto rng = std::mt19937_64{seed};
+  std::uniform_real_distribution<double> uniform;
+  std::normal_distribution<double> normal;
+
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  std::vector<double> to_test(N);
+  std::vector<double> correct(N);
+  for (int tx = 0; tx < 4; tx++) {
+    const double p0 = tx + 1.0;
+    const double p1 = 2.0 * tx + 3.0;
+    if (tx % 2 == 0) {
+      ASSERT_TRUE(engine->get_samples(Distribution::Uniform<double>{p0, p1},
+                                      d_ptr, N) == SUCCESS);
+      std::generate(correct.begin(), correct.end(), [&]() {
+        return uniform(rng, decltype(uniform)::param_type(p0, p1));
+      });
+    } else {
+      ASSERT_TRUE(engine->get_samples(Distribution::Normal<double>{p0, p1},
+                                      d_ptr, N) == SUCCESS);
+      std::generate(correct.begin(), correct.end(), [&]() {
+        return normal(rng, decltype(normal)::param_type(p0, p1));
+      });
+    }
+    queue.memcpy(to_test.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+    ASSERT_EQ(to_test, correct);
+  }
+
+  sycl::free(d_ptr, queue);
+}
+
+TEST(Engine, default_mixed) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 10239;
+  auto engine = create_engine<double>(1234, device, 0);
+  ASSERT_NE(engine, nullptr);
+
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  std::vector<double> to_test(N);
+  for (int tx = 0; tx < 4; tx++) {
+    const double a = -1.0 * tx;
+    const double b = 3.0 * tx + 1.0;
+    ASSERT_TRUE(engine->get_samples(Distribution::Uniform<double>{a, b}, d_ptr,
+                                    N) == SUCCESS);
+    queue.memcpy(to_test.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+    for (auto vx : to_test) {
+      ASSERT_TRUE(vx >= a);
+      ASSERT_TRUE(vx < b);
+    }
+
+    const double mean = 2.0 * tx;
+    const double stddev = tx + 1.0;
+    ASSERT_TRUE(engine->get_samples(Distribution::Normal<double>{mean, stddev},
+                                    d_ptr, N) == SUCCESS);
+    queue.memcpy(to_test.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+    double sample_mean = 0.0;
+    for (auto vx : to_test) {
+      sample_mean += vx;
+    }
+    sample_mean /= N;
+    ASSERT_NEAR(sample_mean, mean, 5.0 * stddev / std::sqrt(N));
+  }
+
+  sycl::free(d_ptr, queue);
+}
+
+TEST(Engine, array_double) { wrapper_engine_array<double>("default"); }
+TEST(Engine, array_float) { wrapper_engine_array<float>("stdlib"); }
+TEST(Engine, maxwellian_double) {
+  wrapper_engine_maxwellian<double>("default");
+}
+TEST(Engine, maxwellian_float) { wrapper_engine_maxwellian<float>("stdlib"); }
+TEST(Engine, continuous_double) {
+  wrapper_engine_continuous<double>("default");
+}
+TEST(Engine, continuous_float) { wrapper_engine_continuous<float>("stdlib"); }
+TEST(Engine, strided_double) {
+  wrapper_engine_strided<double>(Distribution::Normal<double>{2.0, 3.0}, 1,
+                                 "default");
+  Distribution::Maxwellian<double> maxwellian{
+      3, {1.0, -2.0, 3.0}, {0.5, 2.0, 1.5}, 1.5};
+  wrapper_engine_strided<double>(maxwellian, 3, "default");
+  wrapper_engine_strided<double>(Distribution::UnitSphere<double>{3}, 3,
+                                 "default");
+  wrapper_engine_strided<double>(Distribution::Gamma<double>{2.0, 0.5}, 1,
+                                 "stdlib");
+}
+TEST(Engine, strided_float) {
+  wrapper_engine_strided<float>(Distribution::Uniform<float>{-1.0, 2.0}, 1,
+                                "stdlib");
+  Distribution::Maxwellian<float> maxwellian{2, {1.0, -2.0}, {0.5, 2.0}};
+  wrapper_engine_strided<float>(maxwellian, 2, "stdlib");
+}
+TEST(Engine, in_flight) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t N = 1001;
+  auto engine = create_engine<double>(1234, device, 0);
+  double *d_ptr = sycl::malloc_device<double>(3 * N, queue);
+  int *d_int_ptr = sycl::malloc_device<int>(N, queue);
+
+  // A second submit into a pointer which is not yet waited on is rejected
+  // and the first samples are still valid.
+  Distribution::Maxwellian<double> maxwellian{
+      3, {0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}};
+  ASSERT_EQ(engine->submit_get_samples(maxwellian, d_ptr, N), SUCCESS);
+  ASSERT_EQ(engine->submit_get_samples(maxwellian, d_ptr, N), -111);
+  ASSERT_EQ(engine->submit_get_samples(Distribution::UnitSphere<double>{3},
+                                       d_ptr, N),
+            -111);
+  ASSERT_EQ(engine->wait_get_samples(d_ptr), SUCCESS);
+  ASSERT_EQ(engine->get_samples(maxwellian, d_ptr, N), SUCCESS);
+
+  ASSERT_EQ(engine->submit_get_samples(Distribution::UniformInt<int>{0, 9},
+                                       d_int_ptr, N),
+            SUCCESS);
+  ASSERT_EQ(engine->submit_get_samples(Distribution::UniformInt<int>{0, 9},
+                                       d_int_ptr, N),
+            -111);
+  ASSERT_EQ(engine->wait_get_samples(d_int_ptr), SUCCESS);
+  ASSERT_EQ(engine->wait_get_samples(d_int_ptr), -105);
+
+  sycl::free(d_int_ptr, queue);
+  sycl::free(d_ptr, queue);
+}
+
+TEST(Engine, philox_gamma) {
+  // The Philox Gamma kernel used by the platforms without a Gamma
+  // distribution.
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t N = 100000;
+  const std::vector<double> key = {0.1, 0.7, 0.3, 1.0};
+  double *d_key = sycl::malloc_device<double>(4, queue);
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  queue.memcpy(d_key, key.data(), 4 * sizeof(double)).wait_and_throw();
+
+  std::vector<double> samples(N);
+  for (const auto distribution :
+       {Distribution::Gamma<double>{2.5, 1.5},
+        Distribution::Gamma<double>{0.5, 2.0},
+        Distribution::Gamma<double>{30.0, 0.1}}) {
+    Private::submit_gamma(queue, distribution, d_key, d_ptr, N)
+        .wait_and_throw();
+    queue.memcpy(samples.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+    double mean = 0.0;
+    for (auto value : samples) {
+      ASSERT_TRUE(value > 0.0);
+      mean += value;
+    }
+    mean /= N;
+    double variance = 0.0;
+    for (auto value : samples) {
+      variance += (value - mean) * (value - mean);
+    }
+    variance /= (N - 1);
+    const double correct_mean = distribution.alpha * distribution.beta;
+    const double correct_variance = correct_mean * distribution.beta;
+    ASSERT_NEAR(mean, correct_mean, 0.02 * correct_mean);
+    ASSERT_NEAR(variance, correct_variance, 0.05 * correct_variance);
+  }
+
+  sycl::free(d_ptr, queue);
+  sycl::free(d_key, queue);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+/**
+ * Draw samples for a number of keys.
+ *
+ * @returns The samples copied to the host.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<VALUE_TYPE> get_keyed_samples(
+    KeyedSampler<VALUE_TYPE> &sampler, const DISTRIBUTION_TYPE distribution,
+    const std::vector<std::uint64_t> &keys, const std::uint64_t step,
+    const std::size_t num_per_key,
+    const Distribution::Layout layout = Distribution::Layout::AoS) {
+  sycl::queue &queue = sampler.queue;
+  const std::size_t N = keys.size() * num_per_key;
+  std::uint64_t *d_keys =
+      sycl::malloc_device<std::uint64_t>(keys.size(), queue);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  queue.memcpy(d_keys, keys.data(), keys.size() * sizeof(std::uint64_t))
+      .wait_and_throw();
+  EXPECT_EQ(sampler.get_samples(distribution, d_keys, keys.size(), step,
+                                num_per_key, d_ptr, layout),
+            SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  sycl::free(d_keys, queue);
+  return samples;
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_keyed(const DISTRIBUTION_TYPE distribution,
+                          const double mean, const double variance) {
+  sycl::queue queue{sycl::default_selector_v};
+  const std::size_t num_keys = 10000;
+  const std::size_t k = 3;
+  const std::uint64_t step = 17;
+  std::vector<std::uint64_t> keys(num_keys);
+  for (std::size_t ix = 0; ix < num_keys; ix++) {
+    keys.at(ix) = 1000003 * ix + (std::uint64_t{1} << 40);
+  }
+
+  KeyedSampler<VALUE_TYPE> sampler(queue, 1234);
+  auto samples = get_keyed_samples(sampler, distribution, keys, step, k);
+  double sample_mean = 0.0;
+  double sample_variance = 0.0;
+  for (std::size_t ix = 0; ix < num_keys * k; ix++) {
+    sample_mean += samples.at(ix);
+    sample_variance += samples.at(ix) * samples.at(ix);
+  }
+  sample_mean /= num_keys * k;
+  sample_variance =
+      sample_variance / (num_keys * k) - sample_mean * sample_mean;
+  ASSERT_NEAR(sample_mean, mean, 0.05 * std::sqrt(variance) + 0.01);
+  ASSERT_NEAR(sample_variance / variance, 1.0, 0.05);
+
+  // Decomposing the keys over two "ranks" in a shuffled order gives the same
+  // samples for each key, in either layout.
+  std::vector<std::size_t> order(num_keys);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937_64 generator(52234231);
+  std::shuffle(order.begin(), order.end(), generator);
+  const std::size_t split = num_keys / 3;
+  for (const auto &range : {std::pair<std::size_t, std::size_t>{0, split},
+                            std::pair<std::size_t, std::size_t>{split,
+                                                                num_keys}}) {
+    std::vector<std::uint64_t> rank_keys;
+    for (std::size_t ox = range.first; ox < range.second; ox++) {
+      rank_keys.push_back(keys.at(order.at(ox)));
+    }
+    const std::size_t num_rank_keys = rank_keys.size();
+    KeyedSampler<VALUE_TYPE> rank_sampler(queue, 1234);
+    auto rank_samples =
+        get_keyed_samples(rank_sampler, distribution, rank_keys, step, k,
+                          Distribution::Layout::SoA);
+    for (std::size_t ix = 0; ix < num_rank_keys; ix++) {
+      const std::size_t kx = order.at(range.first + ix);
+      for (std::size_t jx = 0; jx < k; jx++) {
+        ASSERT_EQ(rank_samples.at(jx * num_rank_keys + ix),
+                  samples.at(kx * k + jx));
+      }
+    }
+  }
+
+  // The samples are repeated for the same step and differ for other steps,
+  // including steps which differ in the upper 32 bits only, and other seeds.
+  ASSERT_EQ(get_keyed_samples(sampler, distribution, keys, step, k), samples);
+  for (const std::uint64_t other_step :
+       {step + 1, step + (std::uint64_t{1} << 32)}) {
+    auto other = get_keyed_samples(sampler, distribution, keys, other_step, k);
+    for (std::size_t ix = 0; ix < num_keys * k; ix++) {
+      ASSERT_NE(other.at(ix), samples.at(ix));
+    }
+  }
+  KeyedSampler<VALUE_TYPE> sampler_seed(queue, 4321);
+  ASSERT_NE(get_keyed_samples(sampler_seed, distribution, keys, step, k),
+            samples);
+  // Neighbouring seeds do not share the streams of steps 2^32 apart.
+  KeyedSampler<VALUE_TYPE> sampler_next(queue, 1235);
+  ASSERT_NE(get_keyed_samples(sampler_next, distribution, keys, step, k),
+            get_keyed_samples(sampler, distribution, keys,
+                              step + (std::uint64_t{1} << 32), k));
+
+  // The device callable stream gives the same samples.
+  for (std::size_t ix = 0; ix < num_keys; ix += 101) {
+    auto stream = KeyedSampler<VALUE_TYPE>::get_stream(1234, keys.at(ix), step);
+    for (std::size_t jx = 0; jx < k; jx++) {
+      ASSERT_EQ(Private::sample_proposal(distribution, stream),
+                samples.at(ix * k + jx));
+    }
+  }
+}
+
+} // namespace
+
+TEST(Keyed, uniform) {
+  wrapper_keyed<double>(Distribution::Uniform<double>{-1.0, 3.0}, 1.0,
+                        16.0 / 12.0);
+  wrapper_keyed<float>(Distribution::Uniform<float>{-1.0f, 3.0f}, 1.0,
+                       16.0 / 12.0);
+}
+
+TEST(Keyed, normal) {
+  wrapper_keyed<double>(Distribution::Normal<double>{1.0, 2.0}, 1.0, 4.0);
+  wrapper_keyed<float>(Distribution::Normal<float>{1.0f, 2.0f}, 1.0, 4.0);
+}
+
+TEST(Keyed, exponential) {
+  wrapper_keyed<double>(Distribution::Exponential<double>{2.0}, 0.5, 0.25);
+}
+
+TEST(Keyed, sequential_keys) {
+  // Without keys the keys 0, 1, ..., num_keys - 1 are sampled.
+  sycl::queue queue{sycl::default_selector_v};
+  KeyedSampler<double> sampler(queue, 1234);
+  double *d_ptr = sycl::malloc_device<double>(10, queue);
+  ASSERT_EQ(sampler.get_samples(Distribution::Uniform<double>{0.0, 1.0},
+                                nullptr, 5, 3, 2, d_ptr),
+            SUCCESS);
+  std::vector<double> samples(10);
+  queue.memcpy(samples.data(), d_ptr, 10 * sizeof(double)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  ASSERT_EQ(samples,
+            get_keyed_samples(sampler, Distribution::Uniform<double>{0.0, 1.0},
+                              {0, 1, 2, 3, 4}, 3, 2));
+  ASSERT_EQ(sampler.wait_get_samples(d_ptr), -1);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE>
+inline VALUE_TYPE *copy_to_device(sycl::queue &queue,
+                                  const std::vector<VALUE_TYPE> &values) {
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(values.size(), queue);
+  queue.memcpy(d_ptr, values.data(), values.size() * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  return d_ptr;
+}
+
+/**
+ * Check the mean and covariance of the vectors [start, end).
+ */
+template <typename VALUE_TYPE>
+inline void check_moments(const std::vector<VALUE_TYPE> &samples,
+                          const std::size_t ndim, const std::size_t num_samples,
+                          const Distribution::Layout layout,
+                          const std::size_t start, const std::size_t end,
+                          const std::vector<double> &mean,
+                          const std::vector<double> &covariance,
+                          const double tol) {
+  auto get_value = [&](const std::size_t ix, const std::size_t dx) -> double {
+    return (layout == Distribution::Layout::SoA)
+               ? samples.at(dx * num_samples + ix)
+               : samples.at(ix * ndim + dx);
+  };
+  const double N = static_cast<double>(end - start);
+  std::vector<double> sample_mean(ndim, 0.0);
+  for (std::size_t ix = start; ix < end; ix++) {
+    for (std::size_t dx = 0; dx < ndim; dx++) {
+      sample_mean.at(dx) += get_value(ix, dx) / N;
+    }
+  }
+  for (std::size_t dx = 0; dx < ndim; dx++) {
+    ASSERT_NEAR(sample_mean.at(dx), mean.at(dx), tol);
+  }
+  for (std::size_t rx = 0; rx < ndim; rx++) {
+    for (std::size_t cx = 0; cx < ndim; cx++) {
+      double value = 0.0;
+      for (std::size_t ix = start; ix < end; ix++) {
+        value += (get_value(ix, rx) - sample_mean.at(rx)) *
+                 (get_value(ix, cx) - sample_mean.at(cx));
+      }
+      ASSERT_NEAR(value / N, covariance.at(rx * ndim + cx), tol);
+    }
+  }
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_multivariate(std::string name,
+                                 const Distribution::Layout layout,
+                                 const double tol) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t ndim = 3;
+  const std::size_t N = 200001;
+
+  // Two parameter sets, the second with a degenerate direction.
+  const std::vector<double> mean = {1.0, -2.0, 0.5, 0.0, 3.0, -1.0};
+  const std::vector<double> covariance = {
+      4.0, 1.0, -0.5, 1.0, 2.0, 0.3, -0.5, 0.3, 1.0,
+      1.0, 0.5, 1.0,  0.5, 1.0, 0.5, 1.0,  0.5, 1.0};
+  std::vector<VALUE_TYPE> h_mean(mean.begin(), mean.end());
+  std::vector<VALUE_TYPE> h_covariance(covariance.begin(), covariance.end());
+  VALUE_TYPE *d_mean = copy_to_device(queue, h_mean);
+  VALUE_TYPE *d_covariance = copy_to_device(queue, h_covariance);
+  VALUE_TYPE *d_factor =
+      sycl::malloc_device<VALUE_TYPE>(covariance.size(), queue);
+  ASSERT_EQ(cholesky_factor(queue, d_covariance, d_factor, ndim, 2), SUCCESS);
+
+  // The factors should reproduce the covariance matrices.
+  std::vector<VALUE_TYPE> factor(covariance.size());
+  queue
+      .memcpy(factor.data(), d_factor, factor.size() * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  for (std::size_t mx = 0; mx < 2; mx++) {
+    const VALUE_TYPE *L = factor.data() + mx * ndim * ndim;
+    for (std::size_t rx = 0; rx < ndim; rx++) {
+      for (std::size_t cx = 0; cx < ndim; cx++) {
+        double value = 0.0;
+        for (std::size_t kx = 0; kx < ndim; kx++) {
+          value += L[rx * ndim + kx] * L[cx * ndim + kx];
+        }
+        if (cx > rx) {
+          ASSERT_EQ(L[rx * ndim + cx], 0.0);
+        }
+        ASSERT_NEAR(value, covariance.at(mx * ndim * ndim + rx * ndim + cx),
+                    1.0e-5);
+      }
+    }
+  }
+
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0, name);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(ndim * N, queue);
+  std::vector<VALUE_TYPE> samples(ndim * N);
+
+  // All samples from the first parameter set.
+  Distribution::MultivariateNormal<VALUE_TYPE> distribution{
+      ndim, d_mean, d_factor, nullptr, 1, layout};
+  ASSERT_EQ(engine->get_samples(distribution, d_ptr, N), SUCCESS);
+  queue.memcpy(samples.data(), d_ptr, ndim * N * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  check_moments(samples, ndim, N, layout, 0, N,
+                {mean.begin(), mean.begin() + 3},
+                {covariance.begin(), covariance.begin() + 9}, tol);
+
+  // The samples are grouped into one segment per parameter set.
+  const std::size_t split = N / 3;
+  std::size_t *d_offsets = copy_to_device<std::size_t>(queue, {0, split, N});
+  distribution.d_offsets = d_offsets;
+  distribution.num_segments = 2;
+  ASSERT_EQ(engine->get_samples(distribution, d_ptr, N), SUCCESS);
+  queue.memcpy(samples.data(), d_ptr, ndim * N * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  check_moments(samples, ndim, N, layout, 0, split,
+                {mean.begin(), mean.begin() + 3},
+                {covariance.begin(), covariance.begin() + 9}, 2.0 * tol);
+  check_moments(samples, ndim, N, layout, split, N,
+                {mean.begin() + 3, mean.end()},
+                {covariance.begin() + 9, covariance.end()}, 2.0 * tol);
+
+  sycl::free(d_offsets, queue);
+  sycl::free(d_ptr, queue);
+  sycl::free(d_factor, queue);
+  sycl::free(d_covariance, queue);
+  sycl::free(d_mean, queue);
+}
+
+} // namespace
+
+TEST(MultivariateNormal, default_aos) {
+  wrapper_multivariate<double>("default", Distribution::Layout::AoS, 0.03);
+}
+TEST(MultivariateNormal, default_soa) {
+  wrapper_multivariate<double>("default", Distribution::Layout::SoA, 0.03);
+}
+TEST(MultivariateNormal, stdlib) {
+  wrapper_multivariate<float>("stdlib", Distribution::Layout::AoS, 0.03);
+}
+
+TEST(MultivariateNormal, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  std::vector<double> covariance = {1.0, 2.0, 2.0, 1.0};
+  double *d_covariance = copy_to_device(queue, covariance);
+  double *d_factor = sycl::malloc_device<double>(4, queue);
+  ASSERT_EQ(cholesky_factor(queue, d_covariance, d_factor, 2, 1), -3);
+  ASSERT_EQ(cholesky_factor(queue, d_covariance, d_factor, 0, 1), -1);
+
+  auto engine = create_engine<double>(1234, device, 0);
+  ASSERT_EQ(engine->get_samples(
+                Distribution::MultivariateNormal<double>{0, nullptr, nullptr},
+                d_factor, 1),
+            -101);
+  sycl::free(d_factor, queue);
+  sycl::free(d_covariance, queue);
+}
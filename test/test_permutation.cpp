@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename INT_TYPE>
+inline std::vector<INT_TYPE>
+get_permutation_samples(EngineSharedPtr<double> engine,
+                        const std::vector<std::size_t> &sizes,
+                        const std::size_t max_segment_size = 0) {
+  sycl::queue queue{engine->device};
+  std::vector<std::size_t> offsets(sizes.size() + 1, 0);
+  for (std::size_t sx = 0; sx < sizes.size(); sx++) {
+    offsets.at(sx + 1) = offsets.at(sx) + sizes.at(sx);
+  }
+  const std::size_t N = offsets.back();
+  std::size_t *d_offsets =
+      sycl::malloc_device<std::size_t>(offsets.size(), queue);
+  queue
+      .memcpy(d_offsets, offsets.data(), offsets.size() * sizeof(std::size_t))
+      .wait_and_throw();
+  INT_TYPE *d_ptr = sycl::malloc_device<INT_TYPE>(N, queue);
+  EXPECT_EQ(engine->get_samples(
+                Distribution::SegmentedPermutation<INT_TYPE>{
+                    d_offsets, sizes.size(), max_segment_size},
+                d_ptr, N),
+            SUCCESS);
+  std::vector<INT_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(INT_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  sycl::free(d_offsets, queue);
+
+  // Each segment should hold a permutation of the indices of the segment.
+  std::size_t start = 0;
+  for (auto size : sizes) {
+    std::vector<INT_TYPE> segment(samples.begin() + start,
+                                  samples.begin() + start + size);
+    std::sort(segment.begin(), segment.end());
+    for (std::size_t ix = 0; ix < size; ix++) {
+      EXPECT_EQ(segment.at(ix), static_cast<INT_TYPE>(start + ix));
+    }
+    start += size;
+  }
+  return samples;
+}
+
+template <typename INT_TYPE> inline void wrapper_permutation() {
+  sycl::device device{sycl::default_selector_v};
+  auto engine = create_engine<double>(1234, device, 0);
+
+  get_permutation_samples<INT_TYPE>(
+      engine, {0, 1, 2, 3, 5, 0, 16, 17, 100, 1000, 4097, 7});
+  // A bound larger than the largest segment only adds kernels.
+  get_permutation_samples<INT_TYPE>(engine, {3, 17, 9, 0, 32}, 40);
+
+  // Each of the 24 permutations of 4 elements should be equally likely.
+  const std::size_t num_segments = 48000;
+  std::vector<std::size_t> sizes(num_segments, 4);
+  auto samples = get_permutation_samples<INT_TYPE>(engine, sizes, 4);
+  std::map<std::vector<INT_TYPE>, std::size_t> counts;
+  for (std::size_t sx = 0; sx < num_segments; sx++) {
+    std::vector<INT_TYPE> permutation(4);
+    for (std::size_t ix = 0; ix < 4; ix++) {
+      permutation.at(ix) = samples.at(sx * 4 + ix) - sx * 4;
+    }
+    counts[permutation]++;
+  }
+  ASSERT_EQ(counts.size(), 24);
+  const double expected = num_segments / 24.0;
+  for (auto &count : counts) {
+    ASSERT_NEAR(count.second, expected, 5.0 * std::sqrt(expected));
+  }
+
+  // Each index of a segment should be equally likely at each position.
+  const std::size_t size = 33;
+  const std::size_t num_large = 3000;
+  samples = get_permutation_samples<INT_TYPE>(
+      engine, std::vector<std::size_t>(num_large, size), size);
+  std::vector<std::size_t> position_counts(size * size, 0);
+  for (std::size_t sx = 0; sx < num_large; sx++) {
+    for (std::size_t ix = 0; ix < size; ix++) {
+      const std::size_t index = samples.at(sx * size + ix) - sx * size;
+      position_counts.at(ix * size + index)++;
+    }
+  }
+  const double expected_position = static_cast<double>(num_large) / size;
+  for (auto count : position_counts) {
+    ASSERT_NEAR(count, expected_position, 5.0 * std::sqrt(expected_position));
+  }
+
+  // Identically seeded engines should produce identical permutations.
+  auto engine_a = create_engine<double>(4321, device, 0);
+  auto engine_b = create_engine<double>(4321, device, 0);
+  const std::vector<std::size_t> sizes_small = {10, 20, 30};
+  auto samples_a = get_permutation_samples<INT_TYPE>(engine_a, sizes_small);
+  ASSERT_EQ(samples_a,
+            get_permutation_samples<INT_TYPE>(engine_b, sizes_small));
+  // Each call advances the stream of the engine.
+  ASSERT_NE(samples_a,
+            get_permutation_samples<INT_TYPE>(engine_a, sizes_small));
+}
+
+} // namespace
+
+TEST(SegmentedPermutation, int) { wrapper_permutation<int>(); }
+TEST(SegmentedPermutation, int64) { wrapper_permutation<std::int64_t>(); }
+
+TEST(SegmentedPermutation, errors) {
+  sycl::device device{sycl::default_selector_v};
+  auto engine = create_engine<double>(1234, device, 0);
+  int ptr[1];
+  ASSERT_EQ(engine->get_samples(Distribution::SegmentedPermutation<int>{}, ptr,
+                                1),
+            -109);
+  ASSERT_EQ(engine->get_samples(Distribution::SegmentedPermutation<int>{}, ptr,
+                                0),
+            SUCCESS);
+}
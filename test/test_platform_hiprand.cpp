@@ -284,9 +284,55 @@ template <typename VALUE_TYPE> inline void wrapper_normal() {
   }
 }
 
+template <typename VALUE_TYPE> inline void wrapper_buffer() {
+  sycl::device device{sycl::default_selector_v};
+  if (device.is_gpu()) {
+    sycl::queue queue{device};
+
+    for (std::size_t N : {0, 1, 2, 3, 127, 301, 10238, 10239}) {
+      const std::uint64_t seed = 1234;
+      const std::size_t offset = 7;
+      const std::size_t buffer_size = N + 2 * offset;
+
+      const VALUE_TYPE mean = 2.0;
+      const VALUE_TYPE stddev = 4.0;
+
+      auto to_test_rng = create_rng<VALUE_TYPE>(
+          Distribution::Normal<VALUE_TYPE>{mean, stddev}, seed, device, 0,
+          "hipRAND", "default");
+      ASSERT_EQ(to_test_rng->platform_name, "hipRAND");
+
+      std::vector<VALUE_TYPE> to_test(buffer_size, 10.0);
+      {
+        sycl::buffer<VALUE_TYPE, 1> buffer(to_test.data(),
+                                           sycl::range<1>(buffer_size));
+        ASSERT_TRUE(to_test_rng->submit_get_samples(buffer, offset, N) ==
+                    SUCCESS);
+      }
+
+      // The samples in the buffer should match those drawn through the
+      // pointer interface by an identically seeded RNG.
+      auto correct_rng = create_rng<VALUE_TYPE>(
+          Distribution::Normal<VALUE_TYPE>{mean, stddev}, seed, device, 0,
+          "hipRAND", "default");
+      std::vector<VALUE_TYPE> correct(buffer_size, 10.0);
+      VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(buffer_size, queue);
+      ASSERT_TRUE(correct_rng->get_samples(d_ptr, N) == SUCCESS);
+      if (N > 0) {
+        queue.memcpy(correct.data() + offset, d_ptr, N * sizeof(VALUE_TYPE))
+            .wait_and_throw();
+      }
+      ASSERT_EQ(correct, to_test);
+
+      sycl::free(d_ptr, queue);
+    }
+  }
+}
+
 } // namespace
 
 TEST(PlatformhipRAND, uniform_double) { wrapper_uniform<double>(); }
+TEST(PlatformhipRAND, buffer_double) { wrapper_buffer<double>(); }
 TEST(PlatformhipRAND, normal_double) { wrapper_normal<double>(); }
 TEST(PlatformhipRAND, uniform_double_host) {
   sycl::device device{sycl::cpu_selector_v};
@@ -119,9 +119,129 @@ template <typename VALUE_TYPE> inline void wrapper_normal() {
   }
 }
 
+template <typename VALUE_TYPE> inline void wrapper_buffer() {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  for (std::size_t N : {0, 1, 2, 3, 127, 301, 10238, 10239}) {
+    // Sub-buffer offsets must respect the device alignment requirements.
+    for (std::size_t offset : {0, 64}) {
+      const std::uint64_t seed = 1234;
+      const std::size_t buffer_size = N + offset;
+
+      const VALUE_TYPE a = -2.0;
+      const VALUE_TYPE b = 2.0;
+
+      auto to_test_rng =
+          create_rng<VALUE_TYPE>(Distribution::Uniform<VALUE_TYPE>{a, b}, seed,
+                                 device, 0, "oneMKL", "default_engine");
+
+      std::vector<VALUE_TYPE> to_test(buffer_size, 10.0);
+      {
+        sycl::buffer<VALUE_TYPE, 1> buffer(to_test.data(),
+                                           sycl::range<1>(buffer_size));
+        ASSERT_TRUE(to_test_rng->submit_get_samples(buffer, offset, N) ==
+                    SUCCESS);
+      }
+
+      oneapi::mkl::rng::default_engine engine(queue, seed);
+      oneapi::mkl::rng::uniform<VALUE_TYPE> distr(a, b);
+      std::vector<VALUE_TYPE> correct(buffer_size, 10.0);
+      if (N > 0) {
+        VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+        oneapi::mkl::rng::generate(distr, engine, N, d_ptr).wait_and_throw();
+        queue.memcpy(correct.data() + offset, d_ptr, N * sizeof(VALUE_TYPE))
+            .wait_and_throw();
+        sycl::free(d_ptr, queue);
+      }
+      ASSERT_EQ(correct, to_test);
+    }
+  }
+}
+
+/**
+ * Draw samples from the philox4x32x10 generator of the oneMKL and stdlib
+ * platforms in calls of a number of samples.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void get_philox_pair(const DISTRIBUTION_TYPE distribution,
+                            const std::vector<std::size_t> &calls,
+                            std::vector<VALUE_TYPE> &onemkl,
+                            std::vector<VALUE_TYPE> &stdlib) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::uint64_t seed = 0x123456789ABCDEF0ull;
+  for (const std::string platform_name : {"oneMKL", "stdlib"}) {
+    auto rng = create_rng<VALUE_TYPE>(distribution, seed, device, 0,
+                                      platform_name, "philox4x32x10");
+    ASSERT_NE(rng, nullptr);
+    ASSERT_EQ(rng->platform_name, platform_name);
+    auto &samples = (platform_name == "oneMKL") ? onemkl : stdlib;
+    for (const std::size_t N : calls) {
+      VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+      ASSERT_EQ(rng->get_samples(d_ptr, N), SUCCESS);
+      std::vector<VALUE_TYPE> call(N);
+      queue.memcpy(call.data(), d_ptr, N * sizeof(VALUE_TYPE))
+          .wait_and_throw();
+      sycl::free(d_ptr, queue);
+      samples.insert(samples.end(), call.begin(), call.end());
+    }
+  }
+}
+
+template <typename VALUE_TYPE> inline void wrapper_philox() {
+  const std::vector<std::size_t> calls = {1001, 3, 2048};
+  std::vector<VALUE_TYPE> onemkl;
+  std::vector<VALUE_TYPE> stdlib;
+  get_philox_pair(Distribution::Uniform<VALUE_TYPE>{-2.0, 2.0}, calls, onemkl,
+                  stdlib);
+  ASSERT_EQ(onemkl, stdlib);
+
+  // The Box-Muller2 samples use the deterministic log, sqrt, sin and cos of
+  // the toolkit on the device and the host.
+  onemkl.clear();
+  stdlib.clear();
+  get_philox_pair(Distribution::Normal<VALUE_TYPE>{3.0, 2.0}, calls, onemkl,
+                  stdlib);
+  ASSERT_EQ(onemkl, stdlib);
+
+  // The buffer interface gives the same samples.
+  sycl::device device{sycl::default_selector_v};
+  const std::uint64_t seed = 0x123456789ABCDEF0ull;
+  auto rng = create_rng<VALUE_TYPE>(Distribution::Normal<VALUE_TYPE>{3.0, 2.0},
+                                    seed, device, 0, "oneMKL",
+                                    "philox4x32x10");
+  ASSERT_NE(rng, nullptr);
+  const std::size_t N = calls.at(0);
+  std::vector<VALUE_TYPE> buffer_samples(N + 1);
+  {
+    sycl::buffer<VALUE_TYPE, 1> buffer(buffer_samples.data(),
+                                       sycl::range<1>(N + 1));
+    ASSERT_EQ(rng->submit_get_samples(buffer, 1, N), SUCCESS);
+  }
+  for (std::size_t ix = 0; ix < N; ix++) {
+    ASSERT_EQ(buffer_samples.at(ix + 1), stdlib.at(ix));
+  }
+}
+
 } // namespace
 
+TEST(PlatformOneMKL, philox_double) { wrapper_philox<double>(); }
+TEST(PlatformOneMKL, philox_float) { wrapper_philox<float>(); }
+TEST(PlatformOneMKL, philox_bits) {
+  std::vector<std::uint32_t> onemkl_32;
+  std::vector<std::uint32_t> stdlib_32;
+  get_philox_pair(Distribution::Bits<std::uint32_t>{}, {1001, 3}, onemkl_32,
+                  stdlib_32);
+  ASSERT_EQ(onemkl_32, stdlib_32);
+  std::vector<std::uint64_t> onemkl_64;
+  std::vector<std::uint64_t> stdlib_64;
+  get_philox_pair(Distribution::Bits<std::uint64_t>{}, {1001, 3}, onemkl_64,
+                  stdlib_64);
+  ASSERT_EQ(onemkl_64, stdlib_64);
+}
 TEST(PlatformOneMKL, uniform_double) { wrapper_uniform<double>(); }
+TEST(PlatformOneMKL, buffer_double) { wrapper_buffer<double>(); }
 TEST(PlatformOneMKL, normal_double) { wrapper_normal<double>(); }
 TEST(PlatformOneMKL, default) {
   sycl::device device{sycl::default_selector_v};
@@ -99,10 +99,277 @@ template <typename VALUE_TYPE> inline void wrapper_normal() {
   }
 }
 
+template <typename VALUE_TYPE> inline void wrapper_buffer() {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  for (std::size_t N : {0, 1, 2, 3, 127, 301, 10238, 10239}) {
+    const std::uint64_t seed = 1234;
+    const std::size_t offset = 7;
+    const std::size_t buffer_size = N + 2 * offset;
+
+    const VALUE_TYPE a = -2.0;
+    const VALUE_TYPE b = 2.0;
+
+    auto to_test_rng = create_rng<VALUE_TYPE>(
+        Distribution::Uniform<VALUE_TYPE>{a, b}, seed, device, 0, "stdlib");
+
+    // Generate host side values to test against
+    auto rng = std::mt19937_64{seed};
+    auto dist = std::uniform_real_distribution<VALUE_TYPE>(a, b);
+    std::vector<VALUE_TYPE> correct(buffer_size, 10.0);
+    std::generate(correct.begin() + offset, correct.begin() + offset + N,
+                  [&]() { return dist(rng); });
+
+    std::vector<VALUE_TYPE> to_test(buffer_size, 10.0);
+    {
+      sycl::buffer<VALUE_TYPE, 1> buffer(to_test.data(),
+                                         sycl::range<1>(buffer_size));
+      ASSERT_TRUE(to_test_rng->submit_get_samples(buffer, offset, N) ==
+                  SUCCESS);
+      // Samples which do not fit in the buffer are an error.
+      ASSERT_TRUE(to_test_rng->submit_get_samples(buffer, offset + N + 1,
+                                                  offset) != SUCCESS);
+    }
+    ASSERT_EQ(to_test, correct);
+
+    // The buffer and pointer interfaces should draw from the same stream.
+    std::generate(correct.begin(), correct.begin() + N,
+                  [&]() { return dist(rng); });
+    VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(buffer_size, queue);
+    ASSERT_TRUE(to_test_rng->get_samples(d_ptr, N) == SUCCESS);
+    queue.memcpy(to_test.data(), d_ptr, N * sizeof(VALUE_TYPE))
+        .wait_and_throw();
+    ASSERT_EQ(to_test, correct);
+
+    sycl::free(d_ptr, queue);
+  }
+}
+
+template <typename VALUE_TYPE>
+inline std::vector<VALUE_TYPE>
+get_philox_samples(RNGSharedPtr<VALUE_TYPE> rng, const std::size_t N) {
+  sycl::queue queue{rng->device};
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_EQ(rng->get_samples(d_ptr, N), SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+/**
+ * @returns The first N 32-bit outputs of Philox4x32-10 seeded as the oneMKL
+ * philox4x32x10 engine.
+ */
+inline std::vector<std::uint32_t> get_philox_words(const std::uint64_t seed,
+                                                   const std::size_t N) {
+  const std::uint32_t key[2] = {static_cast<std::uint32_t>(seed),
+                                static_cast<std::uint32_t>(seed >> 32)};
+  std::vector<std::uint32_t> words;
+  for (std::uint32_t cx = 0; words.size() < N; cx++) {
+    const std::uint32_t counter[4] = {cx, 0, 0, 0};
+    std::uint32_t output[4];
+    Private::Philox4x32x10::generate(counter, key, output);
+    words.insert(words.end(), output, output + 4);
+  }
+  words.resize(N);
+  return words;
+}
+
+template <typename VALUE_TYPE> inline void wrapper_philox() {
+  sycl::device device{sycl::default_selector_v};
+  const std::uint64_t seed = 0x123456789ABCDEF0ull;
+  const std::size_t N = 1001;
+  const auto words = get_philox_words(seed, 2 * N + 2);
+
+  const VALUE_TYPE a = -2.0;
+  const VALUE_TYPE b = 2.0;
+  auto uniform_rng =
+      create_rng<VALUE_TYPE>(Distribution::Uniform<VALUE_TYPE>{a, b}, seed,
+                             device, 0, "stdlib", "philox4x32x10");
+  ASSERT_NE(uniform_rng, nullptr);
+  auto uniform = get_philox_samples<VALUE_TYPE>(uniform_rng, N);
+  const VALUE_TYPE scale = (b - a) / static_cast<VALUE_TYPE>(4294967296.0);
+  const VALUE_TYPE below_b = std::nextafter(b, a);
+  for (std::size_t ix = 0; ix < N; ix++) {
+    ASSERT_EQ(uniform.at(ix),
+              std::min(static_cast<VALUE_TYPE>(words.at(ix)) * scale + a,
+                       below_b));
+  }
+
+  // Box-Muller2 pairs, the second sample of the last pair of a call is
+  // discarded.
+  const VALUE_TYPE mean = 3.0;
+  const VALUE_TYPE stddev = 2.0;
+  auto normal_rng = create_rng<VALUE_TYPE>(
+      Distribution::Normal<VALUE_TYPE>{mean, stddev}, seed, device, 0,
+      "stdlib", "philox4x32x10");
+  ASSERT_NE(normal_rng, nullptr);
+  auto first = get_philox_samples<VALUE_TYPE>(normal_rng, N);
+  auto second = get_philox_samples<VALUE_TYPE>(normal_rng, 1);
+  for (std::size_t ix = 0; ix < N + 1; ix++) {
+    const std::size_t px = ix / 2;
+    VALUE_TYPE z[2];
+    Private::box_muller2(words.at(2 * px), words.at(2 * px + 1), mean, stddev,
+                         z[0], z[1]);
+    if (ix < N) {
+      ASSERT_EQ(first.at(ix), z[ix % 2]);
+    } else {
+      ASSERT_NE(second.at(0), z[ix % 2]);
+    }
+  }
+  VALUE_TYPE z[2];
+  Private::box_muller2(words.at(N + 1), words.at(N + 2), mean, stddev, z[0],
+                       z[1]);
+  ASSERT_EQ(second.at(0), z[0]);
+
+  // The deterministic functions are accurate to a few units in the last
+  // place.
+  const long double eps = std::numeric_limits<VALUE_TYPE>::epsilon();
+  const long double two_pi = 6.283185307179586476925286766559L;
+  for (std::size_t ix = 0; ix < 2 * N; ix++) {
+    const VALUE_TYPE u = std::min(
+        static_cast<VALUE_TYPE>(std::max(words.at(ix), 1u)) *
+            static_cast<VALUE_TYPE>(1.0 / 4294967296.0),
+        std::nextafter(VALUE_TYPE(1.0), VALUE_TYPE(0.0)));
+    const long double log_u = std::log(static_cast<long double>(u));
+    ASSERT_NEAR(Private::deterministic_log(u), log_u,
+                4 * eps * std::abs(log_u));
+    const VALUE_TYPE v = -Private::deterministic_log(u);
+    ASSERT_NEAR(Private::deterministic_sqrt(v),
+                std::sqrt(static_cast<long double>(v)),
+                eps * std::sqrt(static_cast<long double>(v)));
+    VALUE_TYPE sin_value;
+    VALUE_TYPE cos_value;
+    Private::deterministic_sincos_2pi(u, sin_value, cos_value);
+    ASSERT_NEAR(sin_value, std::sin(two_pi * u), 2 * eps);
+    ASSERT_NEAR(cos_value, std::cos(two_pi * u), 2 * eps);
+  }
+}
+
 } // namespace
 
+TEST(PlatformStdLib, philox_known_answers) {
+  // Known answers of Salmon et al. for Philox4x32-10.
+  const std::uint32_t counters[3][4] = {
+      {0, 0, 0, 0},
+      {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+      {0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344}};
+  const std::uint32_t keys[3][2] = {
+      {0, 0}, {0xFFFFFFFF, 0xFFFFFFFF}, {0xA4093822, 0x299F31D0}};
+  const std::uint32_t correct[3][4] = {
+      {0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8},
+      {0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD},
+      {0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1}};
+  for (int tx = 0; tx < 3; tx++) {
+    std::uint32_t output[4];
+    Private::Philox4x32x10::generate(counters[tx], keys[tx], output);
+    for (int ix = 0; ix < 4; ix++) {
+      ASSERT_EQ(output[ix], correct[tx][ix]);
+    }
+  }
+}
+
+TEST(PlatformStdLib, philox_bits) {
+  sycl::device device{sycl::default_selector_v};
+  const std::uint64_t seed = 0x123456789ABCDEF0ull;
+  const std::size_t N = 1001;
+  const auto words = get_philox_words(seed, 2 * N);
+
+  auto rng_32 =
+      create_rng<std::uint32_t>(Distribution::Bits<std::uint32_t>{}, seed,
+                                device, 0, "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_32, nullptr);
+  auto bits_32 = get_philox_samples<std::uint32_t>(rng_32, N);
+  auto rng_64 =
+      create_rng<std::uint64_t>(Distribution::Bits<std::uint64_t>{}, seed,
+                                device, 0, "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_64, nullptr);
+  auto bits_64 = get_philox_samples<std::uint64_t>(rng_64, N);
+  for (std::size_t ix = 0; ix < N; ix++) {
+    ASSERT_EQ(bits_32.at(ix), words.at(ix));
+    ASSERT_EQ(bits_64.at(ix),
+              (static_cast<std::uint64_t>(words.at(2 * ix + 1)) << 32) |
+                  words.at(2 * ix));
+  }
+
+  auto engine = create_engine<double>(seed, device, 0, "stdlib",
+                                      "philox4x32x10");
+  ASSERT_NE(engine, nullptr);
+}
+
+TEST(PlatformStdLib, philox_known_samples) {
+  // The first block of Philox4x32-10 with a zero key and counter, see
+  // philox_known_answers, mapped to [-2, 2).
+  sycl::device device{sycl::default_selector_v};
+  const std::vector<std::uint32_t> correct_bits = {0x6627E8D5, 0xE169C58D,
+                                                   0xBC57AC4C, 0x9B00DBD8};
+  const std::vector<double> correct_double = {
+      -0x1.9d8172bp-2, 0x1.85a71634p+0, 0x1.e2bd626p-1, 0x1.b00dbd8p-2};
+  const std::vector<float> correct_float = {-0x1.9d817p-2f, 0x1.85a718p+0f,
+                                            0x1.e2bd6p-1f, 0x1.b00dcp-2f};
+
+  auto rng_bits =
+      create_rng<std::uint32_t>(Distribution::Bits<std::uint32_t>{}, 0,
+                                device, 0, "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_bits, nullptr);
+  ASSERT_EQ(get_philox_samples<std::uint32_t>(rng_bits, 4), correct_bits);
+  auto rng_double =
+      create_rng<double>(Distribution::Uniform<double>{-2.0, 2.0}, 0, device,
+                         0, "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_double, nullptr);
+  ASSERT_EQ(get_philox_samples<double>(rng_double, 4), correct_double);
+  auto rng_float =
+      create_rng<float>(Distribution::Uniform<float>{-2.0f, 2.0f}, 0, device,
+                        0, "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_float, nullptr);
+  ASSERT_EQ(get_philox_samples<float>(rng_float, 4), correct_float);
+
+  // The Box-Muller2 pairs of the block are pinned, as the oneMKL platform
+  // reproduces them bit for bit.
+  const std::vector<double> correct_normal_double = {
+      -0x1.d96d5ff3347f1p-1, 0x1.fb7665ddcf85cp-1, -0x1.eda363411e856p-2,
+      -0x1.3c373dd9958a9p-1};
+  const std::vector<float> correct_normal_float = {
+      -0x1.d96d58p-1f, 0x1.fb766ap-1f, -0x1.eda366p-2f, -0x1.3c373ep-1f};
+  auto rng_normal_double =
+      create_rng<double>(Distribution::Normal<double>{0.0, 1.0}, 0, device, 0,
+                         "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_normal_double, nullptr);
+  ASSERT_EQ(get_philox_samples<double>(rng_normal_double, 4),
+            correct_normal_double);
+  auto rng_normal_float =
+      create_rng<float>(Distribution::Normal<float>{0.0f, 1.0f}, 0, device, 0,
+                        "stdlib", "philox4x32x10");
+  ASSERT_NE(rng_normal_float, nullptr);
+  ASSERT_EQ(get_philox_samples<float>(rng_normal_float, 4),
+            correct_normal_float);
+}
+
+TEST(PlatformStdLib, philox_uniform_bounds) {
+  // The largest output rounds to 2^32 as a float, which is mapped below b.
+  auto largest = []() { return std::uint32_t{0xFFFFFFFF}; };
+  Private::StdLibPhiloxUniform<float> uniform_float(0.0f, 1.0f);
+  ASSERT_LT(uniform_float(largest), 1.0f);
+  Private::StdLibPhiloxUniform<float> shifted_float(-2.0f, 2.0f);
+  ASSERT_LT(shifted_float(largest), 2.0f);
+  Private::StdLibPhiloxUniform<double> uniform_double(0.0, 1.0);
+  ASSERT_LT(uniform_double(largest), 1.0);
+  auto smallest = []() { return std::uint32_t{0}; };
+  ASSERT_EQ(shifted_float(smallest), -2.0f);
+}
+
+TEST(PlatformStdLib, philox_double) { wrapper_philox<double>(); }
+
+TEST(PlatformStdLib, philox_float) { wrapper_philox<float>(); }
+
 TEST(PlatformStdLib, uniform_double) { wrapper_uniform<double>(); }
 
+TEST(PlatformStdLib, buffer_double) { wrapper_buffer<double>(); }
+
+TEST(PlatformStdLib, buffer_float) { wrapper_buffer<float>(); }
+
 TEST(PlatformStdLib, uniform_float) { wrapper_uniform<float>(); }
 
 TEST(PlatformStdLib, normal_double) { wrapper_uniform<double>(); }
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<VALUE_TYPE> get_samples(DISTRIBUTION_TYPE distribution,
+                                           const std::size_t N) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::uint64_t seed = 1234;
+
+  auto rng = create_rng<VALUE_TYPE>(distribution, seed, device, 0);
+  EXPECT_TRUE(rng != nullptr);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_TRUE(rng->get_samples(d_ptr, N) == SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+
+  // The buffer interface should produce the same samples.
+  auto correct_rng = create_rng<VALUE_TYPE>(distribution, seed, device, 0);
+  std::vector<VALUE_TYPE> correct(N + 3);
+  {
+    sycl::buffer<VALUE_TYPE, 1> buffer(correct.data(), sycl::range<1>(N + 3));
+    EXPECT_TRUE(correct_rng->submit_get_samples(buffer, 3, N) == SUCCESS);
+  }
+  for (std::size_t ix = 0; ix < N; ix++) {
+    EXPECT_TRUE(static_cast<float>(samples.at(ix)) ==
+                static_cast<float>(correct.at(ix + 3)));
+  }
+  return samples;
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_reduced_precision(const float a, const float b,
+                                      const float resolution) {
+  const std::size_t N = 100001;
+  auto samples = get_samples<VALUE_TYPE>(
+      Distribution::Uniform<VALUE_TYPE>{VALUE_TYPE(a), VALUE_TYPE(b)}, N);
+
+  double mean = 0.0;
+  for (auto sample : samples) {
+    const float value = static_cast<float>(sample);
+    ASSERT_TRUE((a <= value) && (value < b));
+    mean += value;
+  }
+  mean /= N;
+  double variance = 0.0;
+  for (auto sample : samples) {
+    const double value = static_cast<float>(sample);
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= (N - 1);
+  const double width = b - a;
+  ASSERT_NEAR(mean, 0.5 * (a + b), 0.01 * width);
+  ASSERT_NEAR(variance, width * width / 12.0, 0.02 * width * width / 12.0);
+
+  // On [0, 1) every sample lies on the grid of the output precision.
+  if ((a == 0.0f) && (b == 1.0f)) {
+    for (auto sample : samples) {
+      const float value = static_cast<float>(sample) / resolution;
+      ASSERT_TRUE(value < 1.0f / resolution);
+      ASSERT_EQ(value, std::floor(value));
+    }
+  }
+}
+
+template <typename VALUE_TYPE> inline void wrapper_fixed_point() {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const int num_bits = 8 * sizeof(VALUE_TYPE);
+  const int values_per_word = 32 / num_bits;
+  const std::size_t N = 10001;
+
+  // Each sample is a field of the words of Philox streams, one stream per
+  // block of four words, keyed by two words the platform produces.
+  auto samples =
+      get_samples<VALUE_TYPE>(Distribution::UniformFixedPoint<VALUE_TYPE>{}, N);
+  auto key_rng = create_rng<std::uint32_t>(Distribution::Bits<std::uint32_t>{},
+                                           1234, device, 0);
+  std::uint32_t *d_key = sycl::malloc_device<std::uint32_t>(2, queue);
+  ASSERT_TRUE(key_rng->get_samples(d_key, 2) == SUCCESS);
+  std::uint32_t key[2];
+  queue.memcpy(key, d_key, 2 * sizeof(std::uint32_t)).wait_and_throw();
+  sycl::free(d_key, queue);
+
+  const std::size_t values_per_block = 4 * values_per_word;
+  for (std::size_t ix = 0; ix < N; ix++) {
+    Private::PhiloxStream stream(key[0], key[1], ix / values_per_block);
+    std::uint32_t word = 0;
+    for (std::size_t wx = 0; wx <= (ix % values_per_block) / values_per_word;
+         wx++) {
+      word = stream.next_uint32();
+    }
+    const int shift = (ix % values_per_word) * num_bits;
+    ASSERT_EQ(samples.at(ix), static_cast<VALUE_TYPE>(word >> shift));
+  }
+}
+
+} // namespace
+
+TEST(ReducedPrecision, half) {
+  wrapper_reduced_precision<sycl::half>(0.0f, 1.0f, 0x1.0p-11f);
+  wrapper_reduced_precision<sycl::half>(-2.0f, 2.0f, 0x1.0p-11f);
+  // The largest samples round to b without clamping.
+  wrapper_reduced_precision<sycl::half>(1.0f, 2.0f, 0x1.0p-11f);
+}
+
+#ifdef SYCL_EXT_ONEAPI_BFLOAT16_MATH_FUNCTIONS
+TEST(ReducedPrecision, bfloat16) {
+  wrapper_reduced_precision<sycl::ext::oneapi::bfloat16>(0.0f, 1.0f,
+                                                         0x1.0p-8f);
+  wrapper_reduced_precision<sycl::ext::oneapi::bfloat16>(-2.0f, 2.0f,
+                                                         0x1.0p-8f);
+  wrapper_reduced_precision<sycl::ext::oneapi::bfloat16>(1.0f, 2.0f,
+                                                         0x1.0p-8f);
+}
+#endif
+
+TEST(ReducedPrecision, fixed_point) {
+  wrapper_fixed_point<std::uint16_t>();
+  wrapper_fixed_point<std::uint8_t>();
+}
+
+TEST(ReducedPrecision, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  auto rng = create_rng<sycl::half>(Distribution::Uniform<sycl::half>{}, 1234,
+                                    device, 0);
+  sycl::half *d_ptr = sycl::malloc_device<sycl::half>(1, queue);
+  // Waiting on a pointer without samples in flight is an error.
+  ASSERT_TRUE(rng->wait_get_samples(d_ptr) != SUCCESS);
+  ASSERT_TRUE(rng->get_samples(d_ptr, 0) == SUCCESS);
+  sycl::free(d_ptr, queue);
+}
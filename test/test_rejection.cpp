@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<VALUE_TYPE>
+get_rejection_samples(EngineSharedPtr<VALUE_TYPE> engine,
+                      DISTRIBUTION_TYPE distribution, const std::size_t N,
+                      const int expected_err = SUCCESS) {
+  sycl::queue queue{engine->device};
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_EQ(engine->get_samples(distribution, d_ptr, N), expected_err);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_rejection(std::string name, const double tol) {
+  sycl::device device{sycl::default_selector_v};
+  const std::size_t N = 200001;
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0, name);
+  ASSERT_TRUE(engine != nullptr);
+
+  // Standard Normal truncated to [-1, 2] with a predicate.
+  auto truncated_normal = Distribution::Rejection{
+      Distribution::Normal<VALUE_TYPE>{0.0, 1.0}, [](const VALUE_TYPE x) {
+        return (VALUE_TYPE(-1.0) <= x) && (x <= VALUE_TYPE(2.0));
+      }};
+  // The first call uses the default acceptance rate and subsequent calls use
+  // the observed rate.
+  for (int cx = 0; cx < 3; cx++) {
+    auto samples = get_rejection_samples(engine, truncated_normal, N);
+    double mean = 0.0;
+    for (auto sample : samples) {
+      ASSERT_TRUE((-1.0 <= sample) && (sample <= 2.0));
+      mean += sample;
+    }
+    mean /= N;
+    auto phi = [](const double x) {
+      return std::exp(-0.5 * x * x) / std::sqrt(2.0 * M_PI);
+    };
+    auto Phi = [](const double x) {
+      return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    };
+    const double correct = (phi(-1.0) - phi(2.0)) / (Phi(2.0) - Phi(-1.0));
+    ASSERT_NEAR(mean, correct, tol);
+  }
+
+  // The density 2x on [0, 1) with an acceptance probability.
+  auto linear = Distribution::Rejection{
+      Distribution::Uniform<VALUE_TYPE>{0.0, 1.0},
+      [](const VALUE_TYPE x) { return x; }, 0.5};
+  auto samples = get_rejection_samples(engine, linear, N);
+  double mean = 0.0;
+  for (auto sample : samples) {
+    ASSERT_TRUE((0.0 <= sample) && (sample <= 1.0));
+    mean += sample;
+  }
+  ASSERT_NEAR(mean / N, 2.0 / 3.0, tol);
+
+  // A low acceptance rate which is mostly filled by the retries.
+  auto narrow = Distribution::Rejection{
+      Distribution::Exponential<VALUE_TYPE>{1.0},
+      [](const VALUE_TYPE x) { return x > VALUE_TYPE(3.0); }, 1.0};
+  samples = get_rejection_samples(engine, narrow, N);
+  mean = 0.0;
+  for (auto sample : samples) {
+    ASSERT_TRUE(sample > 3.0);
+    mean += sample;
+  }
+  // The Exponential distribution is memoryless.
+  ASSERT_NEAR(mean / N, 4.0, 10 * tol);
+
+  // Identically seeded engines should produce identical samples.
+  auto engine_a = create_engine<VALUE_TYPE>(4321, device, 0, name);
+  auto engine_b = create_engine<VALUE_TYPE>(4321, device, 0, name);
+  ASSERT_EQ(get_rejection_samples(engine_a, truncated_normal, 1001),
+            get_rejection_samples(engine_b, truncated_normal, 1001));
+
+  // Strided output.
+  sycl::queue queue{device};
+  const std::size_t num_values = 4 * 1001;
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(num_values, queue);
+  queue.fill(d_ptr, VALUE_TYPE(-10.0), num_values).wait_and_throw();
+  ASSERT_EQ(engine->get_samples(linear, Distribution::Strided{1, 4}, d_ptr + 2,
+                                1000),
+            SUCCESS);
+  std::vector<VALUE_TYPE> values(num_values);
+  queue.memcpy(values.data(), d_ptr, num_values * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  sycl::free(d_ptr, queue);
+  for (std::size_t ix = 0; ix < num_values; ix++) {
+    if ((ix % 4 == 2) && (ix < 4 * 1000)) {
+      ASSERT_TRUE((0.0 <= values.at(ix)) && (values.at(ix) <= 1.0));
+    } else {
+      ASSERT_EQ(values.at(ix), VALUE_TYPE(-10.0));
+    }
+  }
+}
+
+} // namespace
+
+TEST(Rejection, default) { wrapper_rejection<double>("default", 0.01); }
+TEST(Rejection, stdlib) { wrapper_rejection<float>("stdlib", 0.01); }
+
+TEST(Rejection, tags) {
+  sycl::device device{sycl::default_selector_v};
+  const std::size_t N = 100001;
+  auto engine = create_engine<double>(1234, device, 0);
+
+  // Windows of the same type with very different acceptance rates keep
+  // separate estimates of the rate through their tags.
+  auto window = [](const double lower, const double upper,
+                   const std::uint64_t tag) {
+    return Distribution::Rejection{
+        Distribution::Uniform<double>{0.0, 1.0},
+        [=](const double x) { return (lower <= x) && (x < upper); }, 0.5,
+        1000000, tag};
+  };
+  for (int cx = 0; cx < 3; cx++) {
+    for (const auto &distribution :
+         {window(0.0, 0.9, 1), window(0.5, 0.51, 2)}) {
+      auto samples = get_rejection_samples(engine, distribution, N);
+      const double lower = (distribution.tag == 1) ? 0.0 : 0.5;
+      const double upper = (distribution.tag == 1) ? 0.9 : 0.51;
+      double mean = 0.0;
+      for (auto sample : samples) {
+        ASSERT_TRUE((lower <= sample) && (sample < upper));
+        mean += sample;
+      }
+      ASSERT_NEAR(mean / N, 0.5 * (lower + upper), 0.01 * (upper - lower));
+    }
+  }
+}
+
+TEST(Rejection, errors) {
+  sycl::device device{sycl::default_selector_v};
+  auto engine = create_engine<double>(1234, device, 0);
+  auto never = [](const double) { return false; };
+
+  get_rejection_samples(
+      engine,
+      Distribution::Rejection{Distribution::Uniform<double>{0.0, 1.0}, never,
+                              0.0},
+      10, -107);
+  get_rejection_samples(
+      engine,
+      Distribution::Rejection{Distribution::Uniform<double>{0.0, 1.0}, never,
+                              0.5, 0},
+      10, -107);
+
+  // Samples which are never accepted are NaN.
+  auto samples = get_rejection_samples(
+      engine,
+      Distribution::Rejection{Distribution::Uniform<double>{0.0, 1.0}, never,
+                              0.5, 10},
+      10, -108);
+  for (auto sample : samples) {
+    ASSERT_TRUE(std::isnan(sample));
+  }
+
+  // Requests for no samples succeed.
+  ASSERT_EQ(engine->get_samples(
+                Distribution::Rejection{Distribution::Uniform<double>{0.0, 1.0},
+                                        never},
+                static_cast<double *>(nullptr), 0),
+            SUCCESS);
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE>
+inline std::vector<VALUE_TYPE> get_sobol_samples(RNGSharedPtr<VALUE_TYPE> rng,
+                                                 const std::size_t N) {
+  sycl::queue queue{rng->device};
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_EQ(rng->get_samples(d_ptr, N), SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+/**
+ * Check that each of the 2^m points [start, start + 2^m) lies in a distinct
+ * interval [a 2^-m, (a + 1) 2^-m) in dimension dx.
+ */
+template <typename VALUE_TYPE>
+inline void check_stratified(const std::vector<VALUE_TYPE> &samples,
+                             const std::size_t ndim, const std::size_t start,
+                             const int m, const std::size_t dx) {
+  const std::size_t num_points = std::size_t{1} << m;
+  std::vector<int> counts(num_points, 0);
+  for (std::size_t px = start; px < start + num_points; px++) {
+    const VALUE_TYPE x = samples.at(px * ndim + dx);
+    ASSERT_TRUE((0.0 < x) && (x < 1.0));
+    counts.at(static_cast<std::size_t>(std::ldexp(x, m)))++;
+  }
+  for (auto count : counts) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+/**
+ * Check that each of the 2^m points [start, start + 2^m) lies in a distinct
+ * elementary interval [a 2^-k, (a + 1) 2^-k) x [b 2^(k-m), (b + 1) 2^(k-m))
+ * of the projection onto the dimensions d0 and d1 for every k.
+ */
+template <typename VALUE_TYPE>
+inline void check_net(const std::vector<VALUE_TYPE> &samples,
+                      const std::size_t ndim, const std::size_t start,
+                      const int m, const std::size_t d0,
+                      const std::size_t d1) {
+  const std::size_t num_points = std::size_t{1} << m;
+  for (int k = 0; k <= m; k++) {
+    std::vector<int> counts(num_points, 0);
+    for (std::size_t px = start; px < start + num_points; px++) {
+      const VALUE_TYPE x = samples.at(px * ndim + d0);
+      const VALUE_TYPE y = samples.at(px * ndim + d1);
+      ASSERT_TRUE((0.0 < x) && (x < 1.0));
+      ASSERT_TRUE((0.0 < y) && (y < 1.0));
+      const std::size_t a = static_cast<std::size_t>(std::ldexp(x, k));
+      const std::size_t b = static_cast<std::size_t>(std::ldexp(y, m - k));
+      counts.at(a * (num_points >> k) + b)++;
+    }
+    for (auto count : counts) {
+      ASSERT_EQ(count, 1);
+    }
+  }
+}
+
+template <typename VALUE_TYPE> inline void wrapper_sobol(const bool scrambled) {
+  sycl::device device{sycl::default_selector_v};
+  const std::size_t ndim = 5;
+  const int m = 10;
+  const std::size_t num_points = std::size_t{1} << m;
+  const std::size_t N = ndim * 2 * num_points;
+
+  Distribution::Sobol<VALUE_TYPE> distribution{ndim, scrambled};
+  auto rng = create_rng<VALUE_TYPE>(distribution, 1234, device, 0);
+  ASSERT_NE(rng, nullptr);
+  auto samples = get_sobol_samples(rng, N);
+
+  // Each 1D projection is stratified and the first two dimensions form a
+  // (0, m, 2)-net, Owen scrambling preserves both properties.
+  for (std::size_t dx = 0; dx < ndim; dx++) {
+    check_stratified(samples, ndim, 0, m, dx);
+    check_stratified(samples, ndim, num_points, m, dx);
+  }
+  check_net(samples, ndim, 0, m, 0, 1);
+  check_net(samples, ndim, num_points, m, 0, 1);
+
+  // The integral of sum_d x_d^2 over the unit hypercube is ndim / 3.
+  double integral = 0.0;
+  for (std::size_t ix = 0; ix < N; ix++) {
+    integral += static_cast<double>(samples.at(ix)) * samples.at(ix);
+  }
+  integral /= 2 * num_points;
+  ASSERT_NEAR(integral, ndim / 3.0, 2.0e-3);
+
+  // Successive calls continue the sequence, and a sequence which starts at
+  // an offset skips ahead to the same points.
+  auto rng_steps = create_rng<VALUE_TYPE>(distribution, 1234, device, 0);
+  auto first = get_sobol_samples(rng_steps, N / 2);
+  auto second = get_sobol_samples(rng_steps, N / 2);
+  distribution.offset = num_points;
+  auto rng_offset = create_rng<VALUE_TYPE>(distribution, 1234, device, 0);
+  auto offset = get_sobol_samples(rng_offset, N / 2);
+  for (std::size_t ix = 0; ix < N / 2; ix++) {
+    ASSERT_EQ(first.at(ix), samples.at(ix));
+    ASSERT_EQ(second.at(ix), samples.at(N / 2 + ix));
+    ASSERT_EQ(offset.at(ix), samples.at(N / 2 + ix));
+  }
+
+  // The SoA layout holds the same points component by component.
+  distribution.offset = 0;
+  distribution.layout = Distribution::Layout::SoA;
+  auto rng_soa = create_rng<VALUE_TYPE>(distribution, 1234, device, 0);
+  auto soa = get_sobol_samples(rng_soa, N);
+  for (std::size_t px = 0; px < 2 * num_points; px++) {
+    for (std::size_t dx = 0; dx < ndim; dx++) {
+      ASSERT_EQ(soa.at(dx * 2 * num_points + px), samples.at(px * ndim + dx));
+    }
+  }
+
+  // The buffer interface should produce the same samples.
+  distribution.layout = Distribution::Layout::AoS;
+  auto rng_buffer = create_rng<VALUE_TYPE>(distribution, 1234, device, 0);
+  std::vector<VALUE_TYPE> buffer_samples(N + 3);
+  {
+    sycl::buffer<VALUE_TYPE, 1> buffer(buffer_samples.data(),
+                                       sycl::range<1>(N + 3));
+    ASSERT_EQ(rng_buffer->submit_get_samples(buffer, 3, N), SUCCESS);
+  }
+  for (std::size_t ix = 0; ix < N; ix++) {
+    ASSERT_EQ(buffer_samples.at(ix + 3), samples.at(ix));
+  }
+
+  // The scramble is determined by the seed.
+  auto rng_seed = create_rng<VALUE_TYPE>(distribution, 4321, device, 0);
+  auto samples_seed = get_sobol_samples(rng_seed, N);
+  if (scrambled) {
+    ASSERT_NE(samples_seed, samples);
+  } else {
+    ASSERT_EQ(samples_seed, samples);
+  }
+}
+
+} // namespace
+
+TEST(Sobol, double) { wrapper_sobol<double>(false); }
+TEST(Sobol, float) { wrapper_sobol<float>(false); }
+TEST(Sobol, scrambled_double) { wrapper_sobol<double>(true); }
+TEST(Sobol, scrambled_float) { wrapper_sobol<float>(true); }
+
+TEST(Sobol, values) {
+  // The first points of the sequence of Joe and Kuo.
+  sycl::device device{sycl::default_selector_v};
+  auto rng =
+      create_rng<double>(Distribution::Sobol<double>{3}, 1234, device, 0);
+  auto samples = get_sobol_samples(rng, 18);
+  const std::vector<double> correct = {
+      0.0,   0.0,   0.0,   0.5,   0.5,   0.5,   0.75,  0.25, 0.25,
+      0.25,  0.75,  0.75,  0.375, 0.375, 0.625, 0.875, 0.875, 0.125};
+  for (std::size_t ix = 0; ix < correct.size(); ix++) {
+    ASSERT_NEAR(samples.at(ix), correct.at(ix), 1.0e-9);
+  }
+
+  // The last dimension is available.
+  rng = create_rng<double>(Distribution::Sobol<double>{1024, true}, 1234,
+                           device, 0);
+  ASSERT_NE(rng, nullptr);
+  samples = get_sobol_samples(rng, 1024 * 4);
+  for (auto value : samples) {
+    ASSERT_TRUE((0.0 < value) && (value < 1.0));
+  }
+}
+
+TEST(Sobol, errors) {
+  sycl::device device{sycl::default_selector_v};
+  ASSERT_EQ(create_rng<double>(Distribution::Sobol<double>{0}, 1234, device, 0),
+            nullptr);
+  ASSERT_EQ(
+      create_rng<double>(Distribution::Sobol<double>{1025}, 1234, device, 0),
+      nullptr);
+
+  double ptr[8];
+  auto rng =
+      create_rng<double>(Distribution::Sobol<double>{3}, 1234, device, 0);
+  ASSERT_EQ(rng->submit_get_samples(ptr, 4), -4);
+  ASSERT_EQ(rng->wait_get_samples(ptr), -1);
+
+  // The sequence has 2^32 points.
+  rng = create_rng<double>(
+      Distribution::Sobol<double>{1, false, (std::uint64_t{1} << 32) - 4},
+      1234, device, 0);
+  ASSERT_EQ(rng->get_samples(ptr, 4), SUCCESS);
+  ASSERT_EQ(rng->get_samples(ptr, 1), -5);
+}
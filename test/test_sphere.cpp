@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<VALUE_TYPE> get_vectors(std::string platform_name,
+                                           DISTRIBUTION_TYPE distribution,
+                                           const std::size_t N) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  const std::size_t num_values = distribution.ndim * N;
+
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0, platform_name);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(num_values, queue);
+  EXPECT_TRUE(engine->get_samples(distribution, d_ptr, N) == SUCCESS);
+  std::vector<VALUE_TYPE> samples(num_values);
+  queue.memcpy(samples.data(), d_ptr, num_values * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  sycl::free(d_ptr, queue);
+
+  // Return the vectors in the AoS layout.
+  if (distribution.layout == Distribution::Layout::SoA) {
+    std::vector<VALUE_TYPE> aos(num_values);
+    for (std::size_t ix = 0; ix < N; ix++) {
+      for (std::size_t dx = 0; dx < distribution.ndim; dx++) {
+        aos.at(ix * distribution.ndim + dx) = samples.at(dx * N + ix);
+      }
+    }
+    return aos;
+  }
+  return samples;
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_sphere(std::string platform_name) {
+  const std::size_t N = 100001;
+  const double tol = std::numeric_limits<VALUE_TYPE>::epsilon() * 8.0;
+
+  for (const std::size_t ndim : {1, 2, 3}) {
+    Distribution::UnitSphere<VALUE_TYPE> sphere{ndim};
+    auto samples = get_vectors<VALUE_TYPE>(platform_name, sphere, N);
+    std::vector<double> mean(ndim, 0.0);
+    std::vector<double> mean_squared(ndim, 0.0);
+    for (std::size_t ix = 0; ix < N; ix++) {
+      double norm_squared = 0.0;
+      for (std::size_t dx = 0; dx < ndim; dx++) {
+        const double value = samples.at(ix * ndim + dx);
+        norm_squared += value * value;
+        mean.at(dx) += value;
+        mean_squared.at(dx) += value * value;
+      }
+      ASSERT_NEAR(norm_squared, 1.0, tol);
+    }
+    // Each component of an isotropic unit vector has mean zero and second
+    // moment 1 / ndim.
+    for (std::size_t dx = 0; dx < ndim; dx++) {
+      ASSERT_NEAR(mean.at(dx) / N, 0.0, 0.01);
+      ASSERT_NEAR(mean_squared.at(dx) / N, 1.0 / ndim, 0.01 / ndim);
+    }
+
+    // The layout only changes where the components are stored.
+    sphere.layout = Distribution::Layout::SoA;
+    ASSERT_EQ(samples, get_vectors<VALUE_TYPE>(platform_name, sphere, N));
+
+    Distribution::UnitBall<VALUE_TYPE> ball{ndim};
+    samples = get_vectors<VALUE_TYPE>(platform_name, ball, N);
+    std::size_t num_inner = 0;
+    for (std::size_t ix = 0; ix < N; ix++) {
+      double norm_squared = 0.0;
+      for (std::size_t dx = 0; dx < ndim; dx++) {
+        const double value = samples.at(ix * ndim + dx);
+        norm_squared += value * value;
+      }
+      ASSERT_TRUE(norm_squared < 1.0 + tol);
+      num_inner += (norm_squared < 0.25) ? 1 : 0;
+    }
+    // The ball of radius 0.5 holds 0.5^ndim of the volume.
+    const double inner_fraction = std::pow(0.5, ndim);
+    ASSERT_NEAR(static_cast<double>(num_inner) / N, inner_fraction,
+                0.02 * inner_fraction);
+  }
+}
+
+} // namespace
+
+TEST(Sphere, double) { wrapper_sphere<double>("default"); }
+TEST(Sphere, float) { wrapper_sphere<float>("stdlib"); }
+
+TEST(Sphere, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  auto engine = create_engine<double>(1234, device, 0);
+  double *d_ptr = sycl::malloc_device<double>(4, queue);
+  ASSERT_TRUE(engine->get_samples(Distribution::UnitSphere<double>{4}, d_ptr,
+                                  1) != SUCCESS);
+  ASSERT_TRUE(engine->get_samples(Distribution::UnitBall<double>{0}, d_ptr,
+                                  1) != SUCCESS);
+  ASSERT_TRUE(engine->get_samples(Distribution::UnitSphere<double>{3}, d_ptr,
+                                  0) == SUCCESS);
+  sycl::free(d_ptr, queue);
+}
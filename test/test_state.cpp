@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE>
+inline std::vector<VALUE_TYPE> get_state_samples(RNGSharedPtr<VALUE_TYPE> rng,
+                                                 const std::size_t N) {
+  sycl::queue queue{rng->device};
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_EQ(rng->get_samples(d_ptr, N), SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+/**
+ * Check that an RNG which loads a saved state continues the stream from the
+ * point the state was saved at. The create callable creates an RNG with the
+ * same arguments each time it is called.
+ */
+template <typename VALUE_TYPE, typename CREATE_TYPE>
+inline void wrapper_state(CREATE_TYPE create, const std::size_t N) {
+  auto rng = create();
+  ASSERT_NE(rng, nullptr);
+  get_state_samples(rng, N);
+
+  std::vector<std::uint8_t> state;
+  ASSERT_EQ(rng->save_state(state), SUCCESS);
+  ASSERT_FALSE(state.empty());
+  auto correct = get_state_samples(rng, N);
+  auto correct_next = get_state_samples(rng, 2 * N);
+
+  // Reload into the same RNG.
+  ASSERT_EQ(rng->load_state(state), SUCCESS);
+  ASSERT_EQ(get_state_samples(rng, N), correct);
+  ASSERT_EQ(get_state_samples(rng, 2 * N), correct_next);
+
+  // Load into a new RNG, e.g. on restart.
+  auto restart_rng = create();
+  ASSERT_NE(get_state_samples(restart_rng, N), correct);
+  ASSERT_EQ(restart_rng->load_state(state), SUCCESS);
+  ASSERT_EQ(get_state_samples(restart_rng, N), correct);
+  ASSERT_EQ(get_state_samples(restart_rng, 2 * N), correct_next);
+
+  // Saving the state does not change the stream and is repeatable.
+  std::vector<std::uint8_t> state_repeat;
+  ASSERT_EQ(rng->save_state(state_repeat), SUCCESS);
+  ASSERT_EQ(restart_rng->save_state(state), SUCCESS);
+  ASSERT_EQ(state, state_repeat);
+
+  // Truncated blobs and blobs with trailing bytes are rejected and leave the
+  // RNG unchanged.
+  std::vector<std::uint8_t> invalid(state.begin(), state.end() - 1);
+  ASSERT_EQ(rng->load_state(invalid), -7);
+  invalid = state;
+  invalid.push_back(0);
+  ASSERT_EQ(rng->load_state(invalid), -7);
+  ASSERT_EQ(rng->load_state({}), -7);
+  ASSERT_EQ(get_state_samples(rng, N), get_state_samples(restart_rng, N));
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_state_platform(const std::string platform_name,
+                                   const std::string generator_name) {
+  sycl::device device{sycl::default_selector_v};
+  // Odd numbers of samples leave the Gaussian transforms mid pair.
+  for (std::size_t N : {1, 127, 10239}) {
+    wrapper_state<VALUE_TYPE>(
+        [&]() {
+          return create_rng<VALUE_TYPE>(
+              Distribution::Uniform<VALUE_TYPE>{-2.0, 2.0}, 1234, device, 0,
+              platform_name, generator_name);
+        },
+        N);
+    wrapper_state<VALUE_TYPE>(
+        [&]() {
+          return create_rng<VALUE_TYPE>(
+              Distribution::Normal<VALUE_TYPE>{3.0, 2.0}, 1234, device, 0,
+              platform_name, generator_name);
+        },
+        N);
+  }
+}
+
+inline void wrapper_state_bits(const std::string platform_name,
+                               const std::string generator_name) {
+  sycl::device device{sycl::default_selector_v};
+  wrapper_state<std::uint32_t>(
+      [&]() {
+        return create_rng<std::uint32_t>(Distribution::Bits<std::uint32_t>{},
+                                         1234, device, 0, platform_name,
+                                         generator_name);
+      },
+      1001);
+  wrapper_state<std::uint64_t>(
+      [&]() {
+        return create_rng<std::uint64_t>(Distribution::Bits<std::uint64_t>{},
+                                         1234, device, 0, platform_name,
+                                         generator_name);
+      },
+      1001);
+}
+
+/**
+ * Draw samples from an Engine from distributions which carry values between
+ * calls, an odd number of Normal samples leaves the second value of a pair,
+ * and from a distribution drawn by a Philox kernel keyed by the Engine.
+ */
+inline std::vector<double> get_engine_samples(EngineSharedPtr<double> engine,
+                                              const std::size_t N) {
+  sycl::queue queue{engine->device};
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  std::int64_t *d_int_ptr = sycl::malloc_device<std::int64_t>(N, queue);
+  std::vector<double> samples;
+  std::vector<double> call(N);
+  std::vector<std::int64_t> int_call(N);
+  auto append = [&]() {
+    queue.memcpy(call.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+    samples.insert(samples.end(), call.begin(), call.end());
+  };
+  EXPECT_EQ(engine->get_samples(Distribution::Normal<double>{1.0, 2.0}, d_ptr,
+                                N),
+            SUCCESS);
+  append();
+  EXPECT_EQ(engine->get_samples(Distribution::Gamma<double>{0.5, 2.0}, d_ptr,
+                                N),
+            SUCCESS);
+  append();
+  EXPECT_EQ(engine->get_samples(Distribution::LogNormal<double>{0.5, 0.25},
+                                d_ptr, N),
+            SUCCESS);
+  append();
+  EXPECT_EQ(engine->get_samples(Distribution::Exponential<double>{2.0}, d_ptr,
+                                N),
+            SUCCESS);
+  append();
+  EXPECT_EQ(engine->get_samples(Distribution::UniformInt<std::int64_t>{0, 99},
+                                d_int_ptr, N),
+            SUCCESS);
+  queue.memcpy(int_call.data(), d_int_ptr, N * sizeof(std::int64_t))
+      .wait_and_throw();
+  samples.insert(samples.end(), int_call.begin(), int_call.end());
+  sycl::free(d_int_ptr, queue);
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+inline void wrapper_state_engine(const std::string platform_name,
+                                 const std::string generator_name) {
+  sycl::device device{sycl::default_selector_v};
+  auto engine =
+      create_engine<double>(1234, device, 0, platform_name, generator_name);
+  ASSERT_NE(engine, nullptr);
+  get_engine_samples(engine, 101);
+
+  std::vector<std::uint8_t> state;
+  ASSERT_EQ(engine->save_state(state), SUCCESS);
+  auto correct = get_engine_samples(engine, 101);
+  ASSERT_EQ(engine->load_state(state), SUCCESS);
+  ASSERT_EQ(get_engine_samples(engine, 101), correct);
+
+  // Load into a new Engine, e.g. on restart.
+  auto restart_engine =
+      create_engine<double>(1234, device, 0, platform_name, generator_name);
+  ASSERT_EQ(restart_engine->load_state(state), SUCCESS);
+  ASSERT_EQ(get_engine_samples(restart_engine, 101), correct);
+
+  // A truncated blob is rejected and leaves the Engine unchanged.
+  std::vector<std::uint8_t> invalid(state.begin(), state.end() - 1);
+  ASSERT_EQ(engine->load_state(invalid), -7);
+  ASSERT_EQ(get_engine_samples(engine, 101),
+            get_engine_samples(restart_engine, 101));
+}
+
+} // namespace
+
+TEST(State, stdlib_mt19937_64) {
+  wrapper_state_platform<double>("stdlib", "mt19937_64");
+  wrapper_state_platform<float>("stdlib", "mt19937_64");
+
+  // The mt19937_64 state is packed as binary words.
+  sycl::device device{sycl::default_selector_v};
+  auto rng = create_rng<double>(Distribution::Uniform<double>{0.0, 1.0}, 1234,
+                                device, 0, "stdlib", "mt19937_64");
+  std::vector<std::uint8_t> state;
+  ASSERT_EQ(rng->save_state(state), SUCCESS);
+  // The name, the 312 words and the index, and the count and two parameters
+  // of the distribution.
+  ASSERT_EQ(state.size(), sizeof(std::uint64_t) + 6 +
+                              313 * sizeof(std::uint64_t) +
+                              sizeof(std::uint64_t) + 2 * sizeof(double));
+}
+
+TEST(State, stdlib_philox4x32x10) {
+  wrapper_state_platform<double>("stdlib", "philox4x32x10");
+  wrapper_state_platform<float>("stdlib", "philox4x32x10");
+}
+
+TEST(State, stdlib_bits) {
+  for (const std::string generator_name : {"mt19937_64", "philox4x32x10"}) {
+    wrapper_state_bits("stdlib", generator_name);
+  }
+}
+
+TEST(State, default_platform) {
+  // The platform chosen for the device, e.g. cuRAND or hipRAND, whose state
+  // is the seed and the offset of the generator.
+  wrapper_state_platform<double>("default", "default");
+  wrapper_state_platform<float>("default", "default");
+  wrapper_state_bits("default", "default");
+  wrapper_state_engine("default", "default");
+}
+
+TEST(State, wrappers) {
+  sycl::device device{sycl::default_selector_v};
+  wrapper_state<double>(
+      [&]() {
+        return create_rng<double>(
+            Distribution::Normal<double>{2.0, 4.0},
+            [](const double value) { return 3.0 * value - 1.0; }, 1234, device,
+            0, "stdlib");
+      },
+      301);
+  wrapper_state<double>(
+      [&]() {
+        return create_rng<double>(
+            Distribution::Antithetic<Distribution::Normal<double>>{
+                Distribution::Normal<double>{0.0, 1.0}},
+            1234, device, 0, "stdlib");
+      },
+      302);
+  wrapper_state<double>(
+      [&]() {
+        return create_rng<double>(
+            Distribution::LatinHypercube<Distribution::Uniform<double>>{
+                {0.0, 1.0}, 3},
+            1234, device, 0, "stdlib");
+      },
+      3 * 101);
+}
+
+TEST(State, sobol) {
+  sycl::device device{sycl::default_selector_v};
+  wrapper_state<double>(
+      [&]() {
+        return create_rng<double>(Distribution::Sobol<double>{3, true}, 1234,
+                                  device, 0);
+      },
+      3 * 101);
+}
+
+TEST(State, engine) {
+  for (const std::string generator_name : {"mt19937_64", "philox4x32x10"}) {
+    wrapper_state_engine("stdlib", generator_name);
+  }
+}
+
+TEST(State, errors) {
+  sycl::device device{sycl::default_selector_v};
+  auto stdlib_rng =
+      create_rng<double>(Distribution::Uniform<double>{0.0, 1.0}, 1234, device,
+                         0, "stdlib");
+  auto sobol_rng =
+      create_rng<double>(Distribution::Sobol<double>{3}, 1234, device, 0);
+
+  // A state cannot be loaded into an RNG of another platform.
+  std::vector<std::uint8_t> stdlib_state;
+  std::vector<std::uint8_t> sobol_state;
+  ASSERT_EQ(stdlib_rng->save_state(stdlib_state), SUCCESS);
+  ASSERT_EQ(sobol_rng->save_state(sobol_state), SUCCESS);
+  ASSERT_EQ(stdlib_rng->load_state(sobol_state), -7);
+  ASSERT_EQ(sobol_rng->load_state(stdlib_state), -7);
+
+  // A Sobol index past the end of the sequence is rejected.
+  std::vector<std::uint8_t> state = sobol_state;
+  state.resize(state.size() - sizeof(std::uint64_t));
+  Private::write_state(state, (std::uint64_t{1} << 32) + 1);
+  ASSERT_EQ(sobol_rng->load_state(state), -7);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE> inline void wrapper_stream() {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 10239;
+  const std::uint64_t seed = 1234;
+
+  for (std::size_t chunk_size : {1, 7, 1024, 10239, 20000}) {
+    auto to_test_rng = create_rng<VALUE_TYPE>(
+        Distribution::Normal<VALUE_TYPE>{2.0, 4.0}, seed, device, 0);
+    auto correct_rng = create_rng<VALUE_TYPE>(
+        Distribution::Normal<VALUE_TYPE>{2.0, 4.0}, seed, device, 0);
+
+    // The streamed samples should be the samples a single call would produce.
+    VALUE_TYPE *d_correct = sycl::malloc_device<VALUE_TYPE>(N, queue);
+    ASSERT_TRUE(correct_rng->get_samples(d_correct, N) == SUCCESS);
+    std::vector<VALUE_TYPE> correct(N);
+    queue.memcpy(correct.data(), d_correct, N * sizeof(VALUE_TYPE))
+        .wait_and_throw();
+
+    VALUE_TYPE *d_to_test = sycl::malloc_device<VALUE_TYPE>(N, queue);
+    std::size_t num_chunks = 0;
+    ASSERT_TRUE(to_test_rng->stream_samples(
+                    queue, N, chunk_size,
+                    [&](VALUE_TYPE *d_chunk, const std::size_t offset,
+                        const std::size_t chunk_num_samples) {
+                      num_chunks++;
+                      EXPECT_TRUE(chunk_num_samples <= chunk_size);
+                      VALUE_TYPE *k_to_test = d_to_test + offset;
+                      return queue.parallel_for(
+                          sycl::range<1>(chunk_num_samples), [=](auto idx) {
+                            k_to_test[idx] = d_chunk[idx];
+                          });
+                    }) == SUCCESS);
+    ASSERT_EQ(num_chunks, (N + chunk_size - 1) / chunk_size);
+
+    std::vector<VALUE_TYPE> to_test(N);
+    queue.memcpy(to_test.data(), d_to_test, N * sizeof(VALUE_TYPE))
+        .wait_and_throw();
+    ASSERT_EQ(to_test, correct);
+
+    sycl::free(d_correct, queue);
+    sycl::free(d_to_test, queue);
+  }
+}
+
+} // namespace
+
+TEST(Stream, double) { wrapper_stream<double>(); }
+TEST(Stream, float) { wrapper_stream<float>(); }
+TEST(Stream, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  auto rng = create_rng<double>(Distribution::Uniform<double>{0.0, 1.0}, 1234,
+                                device, 0);
+  std::size_t num_chunks = 0;
+  auto consumer = [&](double *, std::size_t, std::size_t) {
+    num_chunks++;
+    return sycl::event{};
+  };
+  ASSERT_TRUE(rng->stream_samples(queue, 0, 0, consumer) == SUCCESS);
+  ASSERT_TRUE(rng->stream_samples(queue, 10, 0, consumer) != SUCCESS);
+  ASSERT_EQ(num_chunks, 0);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+/**
+ * Draw samples from a number of the streams of a family.
+ *
+ * @returns The samples copied to the host.
+ */
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<VALUE_TYPE> get_family_samples(
+    StreamFamily<VALUE_TYPE> &family, const DISTRIBUTION_TYPE distribution,
+    const std::vector<std::size_t> &ids, const std::size_t num_per_stream,
+    const Distribution::Layout layout = Distribution::Layout::AoS) {
+  sycl::queue &queue = family.queue;
+  const std::size_t N = ids.size() * num_per_stream;
+  std::size_t *d_ids = sycl::malloc_device<std::size_t>(ids.size(), queue);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  queue.memcpy(d_ids, ids.data(), ids.size() * sizeof(std::size_t))
+      .wait_and_throw();
+  EXPECT_EQ(family.get_samples(distribution, d_ids, ids.size(),
+                               num_per_stream, d_ptr, layout),
+            SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  sycl::free(d_ids, queue);
+  return samples;
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_stream_family(const DISTRIBUTION_TYPE distribution,
+                                  const double mean, const double variance) {
+  sycl::queue queue{sycl::default_selector_v};
+  const std::size_t num_streams = 10000;
+  const std::size_t k = 3;
+  std::vector<std::size_t> all_ids(num_streams);
+  std::iota(all_ids.begin(), all_ids.end(), 0);
+
+  StreamFamily<VALUE_TYPE> family(queue);
+  ASSERT_EQ(family.create(1234, num_streams), SUCCESS);
+  auto first = get_family_samples(family, distribution, all_ids, k);
+  auto second = get_family_samples(family, distribution, all_ids, k);
+
+  // The streams persist between calls and the samples have the moments of
+  // the distribution.
+  double sample_mean = 0.0;
+  double sample_variance = 0.0;
+  for (std::size_t ix = 0; ix < num_streams * k; ix++) {
+    ASSERT_NE(first.at(ix), second.at(ix));
+    sample_mean += first.at(ix);
+    sample_variance += first.at(ix) * first.at(ix);
+  }
+  sample_mean /= num_streams * k;
+  sample_variance = sample_variance / (num_streams * k) -
+                    sample_mean * sample_mean;
+  ASSERT_NEAR(sample_mean, mean, 0.05 * std::sqrt(variance) + 0.01);
+  ASSERT_NEAR(sample_variance / variance, 1.0, 0.05);
+
+  // A subset of the streams in any order draws the same samples from each
+  // stream, in both layouts.
+  std::vector<std::size_t> subset;
+  for (std::size_t ix = num_streams - 1; ix < num_streams; ix -= 7) {
+    subset.push_back(ix);
+  }
+  std::mt19937_64 generator(52234231);
+  std::shuffle(subset.begin(), subset.end(), generator);
+  const std::size_t num_ids = subset.size();
+  StreamFamily<VALUE_TYPE> family_subset(queue);
+  ASSERT_EQ(family_subset.create(1234, num_streams), SUCCESS);
+  auto subset_first = get_family_samples(family_subset, distribution, subset,
+                                         k, Distribution::Layout::SoA);
+  auto subset_second = get_family_samples(family_subset, distribution, subset,
+                                          k, Distribution::Layout::AoS);
+  for (std::size_t ix = 0; ix < num_ids; ix++) {
+    const std::size_t id = subset.at(ix);
+    for (std::size_t jx = 0; jx < k; jx++) {
+      ASSERT_EQ(subset_first.at(jx * num_ids + ix), first.at(id * k + jx));
+      ASSERT_EQ(subset_second.at(ix * k + jx), second.at(id * k + jx));
+    }
+  }
+
+  // Streams which are not sampled do not advance.
+  auto third = get_family_samples(family, distribution, all_ids, k);
+  auto subset_third =
+      get_family_samples(family_subset, distribution, all_ids, k);
+  for (std::size_t ix = 0; ix < num_streams; ix++) {
+    const bool sampled = (num_streams - 1 - ix) % 7 == 0;
+    for (std::size_t jx = 0; jx < k; jx++) {
+      ASSERT_EQ(subset_third.at(ix * k + jx),
+                sampled ? third.at(ix * k + jx) : first.at(ix * k + jx));
+    }
+  }
+
+  // The seed determines the streams.
+  StreamFamily<VALUE_TYPE> family_seed(queue);
+  ASSERT_EQ(family_seed.create(4321, num_streams), SUCCESS);
+  auto seed = get_family_samples(family_seed, distribution, all_ids, k);
+  ASSERT_NE(seed, first);
+}
+
+} // namespace
+
+TEST(StreamFamily, uniform) {
+  wrapper_stream_family<double>(Distribution::Uniform<double>{-1.0, 3.0}, 1.0,
+                                16.0 / 12.0);
+  wrapper_stream_family<float>(Distribution::Uniform<float>{-1.0f, 3.0f}, 1.0,
+                               16.0 / 12.0);
+}
+
+TEST(StreamFamily, normal) {
+  wrapper_stream_family<double>(Distribution::Normal<double>{1.0, 2.0}, 1.0,
+                                4.0);
+  wrapper_stream_family<float>(Distribution::Normal<float>{1.0f, 2.0f}, 1.0,
+                               4.0);
+}
+
+TEST(StreamFamily, exponential) {
+  wrapper_stream_family<double>(Distribution::Exponential<double>{2.0}, 0.5,
+                                0.25);
+}
+
+TEST(StreamFamily, all_streams) {
+  // Without ids the first num_ids streams are sampled.
+  sycl::queue queue{sycl::default_selector_v};
+  const std::size_t num_streams = 100;
+  std::vector<std::size_t> ids = {0, 1, 2, 3, 4};
+  StreamFamily<double> family(queue);
+  StreamFamily<double> family_ids(queue);
+  ASSERT_EQ(family.create(1234, num_streams), SUCCESS);
+  ASSERT_EQ(family_ids.create(1234, num_streams), SUCCESS);
+  double *d_ptr = sycl::malloc_device<double>(10, queue);
+  ASSERT_EQ(family.get_samples(Distribution::Uniform<double>{0.0, 1.0},
+                               nullptr, 5, 2, d_ptr),
+            SUCCESS);
+  std::vector<double> samples(10);
+  queue.memcpy(samples.data(), d_ptr, 10 * sizeof(double)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  ASSERT_EQ(samples, get_family_samples(family_ids,
+                                        Distribution::Uniform<double>{0.0, 1.0},
+                                        ids, 2));
+}
+
+TEST(StreamFamily, errors) {
+  sycl::queue queue{sycl::default_selector_v};
+  StreamFamily<double> family(queue);
+  double *d_ptr = sycl::malloc_device<double>(16, queue);
+  const Distribution::Uniform<double> distribution{0.0, 1.0};
+  // Sampling a family which has not been created is an error.
+  ASSERT_EQ(family.get_samples(distribution, nullptr, 1, 1, d_ptr), -1);
+  ASSERT_EQ(family.create(1234, 0), -1);
+  ASSERT_EQ(family.create(1234, 8), SUCCESS);
+
+  std::size_t *d_ids = sycl::malloc_device<std::size_t>(2, queue);
+  const std::size_t ids[2] = {3, 8};
+  queue.memcpy(d_ids, ids, 2 * sizeof(std::size_t)).wait_and_throw();
+  ASSERT_EQ(family.get_samples(distribution, nullptr, 9, 1, d_ptr), -1);
+  ASSERT_EQ(family.get_samples(distribution, d_ids, 2, 1, d_ptr), -3);
+  ASSERT_EQ(family.get_samples(distribution, d_ids, 1, 1, d_ptr), SUCCESS);
+  ASSERT_EQ(family.wait_get_samples(d_ptr), -1);
+
+  // A repeated id advances its stream once, hence the stream continues as if
+  // it were sampled once.
+  StreamFamily<double> family_once(queue);
+  ASSERT_EQ(family_once.create(1234, 8), SUCCESS);
+  const std::size_t repeated_ids[2] = {5, 5};
+  queue.memcpy(d_ids, repeated_ids, 2 * sizeof(std::size_t)).wait_and_throw();
+  ASSERT_EQ(family.get_samples(distribution, d_ids, 2, 1, d_ptr), -4);
+  ASSERT_EQ(family_once.get_samples(distribution, d_ids, 1, 1, d_ptr),
+            SUCCESS);
+  std::vector<double> samples(1);
+  std::vector<double> correct(1);
+  ASSERT_EQ(family.get_samples(distribution, d_ids, 1, 1, d_ptr), SUCCESS);
+  queue.memcpy(samples.data(), d_ptr, sizeof(double)).wait_and_throw();
+  ASSERT_EQ(family_once.get_samples(distribution, d_ids, 1, 1, d_ptr),
+            SUCCESS);
+  queue.memcpy(correct.data(), d_ptr, sizeof(double)).wait_and_throw();
+  ASSERT_EQ(samples, correct);
+  sycl::free(d_ids, queue);
+  sycl::free(d_ptr, queue);
+}
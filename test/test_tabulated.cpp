@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline std::vector<VALUE_TYPE> get_samples(std::string platform_name,
+                                           DISTRIBUTION_TYPE distribution,
+                                           const std::size_t N) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  auto rng =
+      create_rng<VALUE_TYPE>(distribution, 1234, device, 0, platform_name);
+  EXPECT_TRUE(rng != nullptr);
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_TRUE(rng->get_samples(d_ptr, N) == SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_tabulated(std::string name, const double tol) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  InverseCDFTable<VALUE_TYPE> table(queue);
+  const std::size_t N = 200001;
+
+  // The density x on [0, 2] is exactly linear, hence the inverse cumulative
+  // distribution 2 sqrt(u) is exact and x^2 / 4 is uniform on [0, 1).
+  ASSERT_TRUE(table.build_from_pdf({0.0, 2.0}, {0.0, 1.0}) == SUCCESS);
+  auto samples = get_samples<VALUE_TYPE>(name, table.get_distribution(), N);
+  ASSERT_EQ(samples,
+            get_samples<VALUE_TYPE>(name, table.get_distribution(), N));
+  std::vector<std::size_t> counts(10, 0);
+  for (auto sample : samples) {
+    ASSERT_TRUE((0.0 <= sample) && (sample <= 2.0 + tol));
+    const double u = 0.25 * static_cast<double>(sample) * sample;
+    counts.at(std::min(static_cast<std::size_t>(10.0 * u), std::size_t{9}))++;
+  }
+  for (auto count : counts) {
+    ASSERT_NEAR(count, N / 10, 0.03 * N / 10);
+  }
+
+  // A standard Normal distribution tabulated on [-8, 8].
+  const std::size_t num_points = 1601;
+  std::vector<double> x(num_points);
+  std::vector<double> pdf(num_points);
+  for (std::size_t ix = 0; ix < num_points; ix++) {
+    x.at(ix) = -8.0 + 16.0 * static_cast<double>(ix) / (num_points - 1);
+    pdf.at(ix) = std::exp(-0.5 * x.at(ix) * x.at(ix));
+  }
+  ASSERT_TRUE(table.build_from_pdf(x, pdf) == SUCCESS);
+  samples = get_samples<VALUE_TYPE>(name, table.get_distribution(), N);
+  double mean = 0.0;
+  double variance = 0.0;
+  for (auto sample : samples) {
+    ASSERT_TRUE((-8.0 <= sample) && (sample <= 8.0));
+    mean += sample;
+    variance += static_cast<double>(sample) * sample;
+  }
+  mean /= N;
+  variance /= N;
+  ASSERT_NEAR(mean, 0.0, 0.01);
+  ASSERT_NEAR(variance, 1.0, 0.02);
+
+  // A tabulated cumulative distribution has a constant density on each
+  // interval, half of the samples are in [0, 1) and half in [1, 3).
+  ASSERT_TRUE(table.build_from_cdf({0.0, 1.0, 3.0}, {0.0, 0.5, 1.0}) ==
+              SUCCESS);
+  samples = get_samples<VALUE_TYPE>(name, table.get_distribution(), N);
+  std::size_t count_first = 0;
+  std::size_t count_second_half = 0;
+  for (auto sample : samples) {
+    ASSERT_TRUE((0.0 <= sample) && (sample <= 3.0));
+    count_first += sample < 1.0;
+    count_second_half += sample >= 2.0;
+  }
+  ASSERT_NEAR(count_first, N / 2, 0.01 * N);
+  ASSERT_NEAR(count_second_half, N / 4, 0.01 * N);
+
+  // Intervals with zero probability are never sampled.
+  ASSERT_TRUE(table.build_from_pdf({0.0, 1.0, 2.0, 3.0, 4.0},
+                                   {1.0, 0.0, 0.0, 0.0, 1.0}) == SUCCESS);
+  samples = get_samples<VALUE_TYPE>(name, table.get_distribution(), N);
+  for (auto sample : samples) {
+    ASSERT_TRUE((sample <= 1.0) || (sample >= 3.0));
+  }
+}
+
+} // namespace
+
+TEST(Tabulated, default) { wrapper_tabulated<double>("default", 1.0e-10); }
+TEST(Tabulated, stdlib) { wrapper_tabulated<float>("stdlib", 1.0e-5); }
+
+TEST(Tabulated, engine) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  InverseCDFTable<double> table(queue);
+  const std::size_t N = 200001;
+
+  // The samples of an Engine are drawn by the same kernel as the samples of
+  // an RNG, a piecewise constant density with half of the samples in [0, 1).
+  ASSERT_TRUE(table.build_from_cdf({0.0, 1.0, 3.0}, {0.0, 0.5, 1.0}) ==
+              SUCCESS);
+  auto engine = create_engine<double>(1234, device, 0);
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  ASSERT_TRUE(engine->get_samples(table.get_distribution(), d_ptr, N) ==
+              SUCCESS);
+  std::vector<double> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+  std::size_t count_first = 0;
+  for (auto sample : samples) {
+    ASSERT_TRUE((0.0 <= sample) && (sample <= 3.0));
+    count_first += sample < 1.0;
+  }
+  ASSERT_NEAR(count_first, N / 2, 0.01 * N);
+
+  // An empty table cannot be sampled.
+  InverseCDFTable<double> empty(queue);
+  ASSERT_EQ(engine->submit_get_samples(empty.get_distribution(), d_ptr, N),
+            -112);
+  sycl::free(d_ptr, queue);
+}
+
+TEST(Tabulated, errors) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+  InverseCDFTable<double> table(queue);
+  ASSERT_EQ(table.build_from_pdf({0.0}, {1.0}), -1);
+  ASSERT_EQ(table.build_from_pdf({0.0, 1.0}, {1.0}), -1);
+  ASSERT_EQ(table.build_from_pdf({0.0, 0.0}, {1.0, 1.0}), -3);
+  ASSERT_EQ(table.build_from_pdf({0.0, 1.0}, {-1.0, 1.0}), -3);
+  ASSERT_EQ(table.build_from_pdf({0.0, 1.0}, {0.0, 0.0}), -3);
+  ASSERT_EQ(table.build_from_cdf({0.0, 1.0, 2.0}, {0.0, 1.0, 0.5}), -3);
+  ASSERT_EQ(table.build_from_cdf({0.0, 1.0}, {1.0, 1.0}), -3);
+
+  // An empty table cannot be sampled.
+  ASSERT_TRUE(create_rng<double>(table.get_distribution(), 1234, device, 0) ==
+              nullptr);
+}
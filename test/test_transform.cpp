@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE> struct ScaleShift {
+  VALUE_TYPE scale;
+  VALUE_TYPE shift;
+  inline VALUE_TYPE operator()(const VALUE_TYPE value) const {
+    return value * scale + shift;
+  }
+};
+
+template <typename VALUE_TYPE>
+inline void wrapper_transform(std::string platform_name) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const ScaleShift<VALUE_TYPE> transform{3.0, -1.0};
+
+  for (std::size_t N : {0, 1, 2, 3, 127, 301, 10238, 10239}) {
+    const std::uint64_t seed = 1234;
+    const std::size_t num_bytes = N * sizeof(VALUE_TYPE);
+
+    auto to_test_rng = create_rng<VALUE_TYPE>(
+        Distribution::Normal<VALUE_TYPE>{2.0, 4.0}, transform, seed, device, 0,
+        platform_name);
+    ASSERT_NE(to_test_rng, nullptr);
+    auto correct_rng =
+        create_rng<VALUE_TYPE>(Distribution::Normal<VALUE_TYPE>{2.0, 4.0},
+                               seed, device, 0, platform_name);
+    ASSERT_EQ(to_test_rng->platform_name, correct_rng->platform_name);
+
+    VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N + 1, queue);
+    std::vector<VALUE_TYPE> correct(N);
+    std::vector<VALUE_TYPE> to_test(N);
+
+    for (int tx = 0; tx < 2; tx++) {
+      ASSERT_TRUE(to_test_rng->get_samples(d_ptr, N) == SUCCESS);
+      queue.memcpy(to_test.data(), d_ptr, num_bytes).wait_and_throw();
+      ASSERT_TRUE(correct_rng->get_samples(d_ptr, N) == SUCCESS);
+      queue.memcpy(correct.data(), d_ptr, num_bytes).wait_and_throw();
+      for (std::size_t ix = 0; ix < N; ix++) {
+        ASSERT_NEAR(to_test.at(ix), transform(correct.at(ix)),
+                    1.0e-5 * std::abs(to_test.at(ix)) + 1.0e-5);
+      }
+    }
+
+    // The buffer interface should also apply the transform.
+    std::vector<VALUE_TYPE> to_test_buffer(N + 1, 10.0);
+    {
+      sycl::buffer<VALUE_TYPE, 1> buffer(to_test_buffer.data(),
+                                         sycl::range<1>(N + 1));
+      ASSERT_TRUE(to_test_rng->submit_get_samples(buffer, 1, N) == SUCCESS);
+    }
+    ASSERT_TRUE(correct_rng->get_samples(d_ptr, N) == SUCCESS);
+    queue.memcpy(correct.data(), d_ptr, num_bytes).wait_and_throw();
+    ASSERT_EQ(to_test_buffer.at(0), 10.0);
+    for (std::size_t ix = 0; ix < N; ix++) {
+      ASSERT_NEAR(to_test_buffer.at(ix + 1), transform(correct.at(ix)),
+                  1.0e-5 * std::abs(to_test_buffer.at(ix + 1)) + 1.0e-5);
+    }
+
+    sycl::free(d_ptr, queue);
+  }
+}
+
+} // namespace
+
+TEST(Transform, stdlib_fused) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 1031;
+  const std::uint64_t seed = 1234;
+  const double a = -2.0;
+  const double b = 2.0;
+  auto transform = [=](const double value) { return value * value; };
+
+  auto to_test_rng =
+      create_rng<double>(Distribution::Uniform<double>{a, b}, transform, seed,
+                         device, 0, "stdlib");
+  ASSERT_EQ(to_test_rng->platform_name, "stdlib");
+
+  // The stdlib platform applies the transform on the host.
+  auto rng = std::mt19937_64{seed};
+  auto dist = std::uniform_real_distribution<double>(a, b);
+  std::vector<double> correct(N);
+  std::generate(correct.begin(), correct.end(),
+                [&]() { return transform(dist(rng)); });
+
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  ASSERT_TRUE(to_test_rng->get_samples(d_ptr, N) == SUCCESS);
+  std::vector<double> to_test(N);
+  queue.memcpy(to_test.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+  ASSERT_EQ(to_test, correct);
+
+  sycl::free(d_ptr, queue);
+}
+
+TEST(Transform, default_double) { wrapper_transform<double>("default"); }
+TEST(Transform, stdlib_float) { wrapper_transform<float>("stdlib"); }
+
+TEST(Transform, transform_rng) {
+  sycl::device device{sycl::default_selector_v};
+  sycl::queue queue{device};
+
+  const std::size_t N = 1031;
+  const std::uint64_t seed = 1234;
+  const ScaleShift<double> transform{-1.0, 1.0};
+
+  // Wrap a stdlib RNG explicitly such that the kernel based transform used by
+  // the vendor platforms is tested on every build.
+  auto to_test_rng = std::make_shared<TransformRNG<double, ScaleShift<double>>>(
+      create_rng<double>(Distribution::Uniform<double>{0.0, 1.0}, seed, device,
+                         0, "stdlib"),
+      device, 0, transform);
+  ASSERT_EQ(to_test_rng->platform_name, "stdlib");
+
+  auto rng = std::mt19937_64{seed};
+  auto dist = std::uniform_real_distribution<double>(0.0, 1.0);
+  std::vector<double> correct(N);
+  std::generate(correct.begin(), correct.end(),
+                [&]() { return transform(dist(rng)); });
+
+  double *d_ptr = sycl::malloc_device<double>(N, queue);
+  ASSERT_TRUE(to_test_rng->get_samples(d_ptr, N) == SUCCESS);
+  std::vector<double> to_test(N);
+  queue.memcpy(to_test.data(), d_ptr, N * sizeof(double)).wait_and_throw();
+  ASSERT_EQ(to_test, correct);
+  for (auto vx : to_test) {
+    ASSERT_TRUE(vx > 0.0);
+    ASSERT_TRUE(vx <= 1.0);
+  }
+
+  // Waiting on a pointer without samples in flight is an error.
+  ASSERT_EQ(to_test_rng->wait_get_samples(d_ptr), -1);
+
+  sycl::free(d_ptr, queue);
+}
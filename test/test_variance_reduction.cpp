@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE>
+inline std::vector<VALUE_TYPE> get_rng_samples(RNGSharedPtr<VALUE_TYPE> rng,
+                                               const std::size_t N) {
+  sycl::queue queue{rng->device};
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(N, queue);
+  EXPECT_EQ(rng->get_samples(d_ptr, N), SUCCESS);
+  std::vector<VALUE_TYPE> samples(N);
+  queue.memcpy(samples.data(), d_ptr, N * sizeof(VALUE_TYPE)).wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+/**
+ * @returns The cumulative distribution of a distribution at x.
+ */
+template <typename VALUE_TYPE>
+inline double get_cdf(const Distribution::Uniform<VALUE_TYPE> &d,
+                      const double x) {
+  return (x - d.a) / (d.b - d.a);
+}
+
+template <typename VALUE_TYPE>
+inline double get_cdf(const Distribution::Normal<VALUE_TYPE> &d,
+                      const double x) {
+  return 0.5 * std::erfc(-(x - d.mean) / (d.stddev * std::sqrt(2.0)));
+}
+
+/**
+ * @returns The stratum of num_strata which contains x.
+ */
+template <typename DISTRIBUTION_TYPE>
+inline std::size_t get_stratum(const DISTRIBUTION_TYPE &d,
+                               const std::size_t num_strata, const double x) {
+  const double p = get_cdf(d, x) * num_strata;
+  const std::size_t stratum = static_cast<std::size_t>(p);
+  return std::min(stratum, num_strata - 1);
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_stratified(const DISTRIBUTION_TYPE distribution,
+                               const double mean, const double tol) {
+  sycl::device device{sycl::default_selector_v};
+  const std::size_t N = 10007;
+  auto rng = create_rng<VALUE_TYPE>(
+      Distribution::Stratified<DISTRIBUTION_TYPE>{distribution}, 1234, device,
+      0);
+  ASSERT_NE(rng, nullptr);
+  auto samples = get_rng_samples(rng, N);
+
+  // Sample i lies in stratum i, up to rounding at the edges of the strata.
+  double sample_mean = 0.0;
+  for (std::size_t ix = 0; ix < N; ix++) {
+    const std::size_t stratum = get_stratum(distribution, N, samples.at(ix));
+    ASSERT_TRUE((stratum + 1 >= ix) && (stratum <= ix + 1));
+    sample_mean += samples.at(ix) / static_cast<double>(N);
+  }
+  ASSERT_NEAR(sample_mean, mean, tol);
+
+  // The buffer interface should produce the same samples.
+  auto correct_rng = create_rng<VALUE_TYPE>(
+      Distribution::Stratified<DISTRIBUTION_TYPE>{distribution}, 1234, device,
+      0);
+  std::vector<VALUE_TYPE> correct(N + 3);
+  {
+    sycl::buffer<VALUE_TYPE, 1> buffer(correct.data(), sycl::range<1>(N + 3));
+    ASSERT_EQ(correct_rng->submit_get_samples(buffer, 3, N), SUCCESS);
+  }
+  for (std::size_t ix = 0; ix < N; ix++) {
+    ASSERT_EQ(correct.at(ix + 3), samples.at(ix));
+  }
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_latin_hypercube(const DISTRIBUTION_TYPE distribution,
+                                    const Distribution::Layout layout) {
+  sycl::device device{sycl::default_selector_v};
+  const std::size_t ndim = 4;
+  const std::size_t num_points = 1001;
+  const std::size_t N = ndim * num_points;
+  auto rng = create_rng<VALUE_TYPE>(
+      Distribution::LatinHypercube<DISTRIBUTION_TYPE>{distribution, ndim,
+                                                      layout},
+      1234, device, 0);
+  ASSERT_NE(rng, nullptr);
+  auto get_index = [&](const std::size_t px, const std::size_t dx) {
+    return (layout == Distribution::Layout::SoA) ? dx * num_points + px
+                                                 : px * ndim + dx;
+  };
+
+  for (int call = 0; call < 2; call++) {
+    auto samples = get_rng_samples(rng, N);
+    // Each stratum of each dimension holds one point.
+    std::vector<std::vector<std::size_t>> strata(ndim);
+    for (std::size_t dx = 0; dx < ndim; dx++) {
+      std::vector<int> counts(num_points, 0);
+      for (std::size_t px = 0; px < num_points; px++) {
+        const std::size_t stratum = get_stratum(
+            distribution, num_points, samples.at(get_index(px, dx)));
+        counts.at(stratum)++;
+        strata.at(dx).push_back(stratum);
+      }
+      for (auto count : counts) {
+        ASSERT_EQ(count, 1);
+      }
+    }
+    // The strata are permuted independently for each dimension.
+    for (std::size_t dx = 1; dx < ndim; dx++) {
+      ASSERT_NE(strata.at(dx), strata.at(0));
+    }
+  }
+
+  // The buffer interface should produce the same designs, repeated calls
+  // reuse the scratch space of the RNG.
+  auto buffer_rng = create_rng<VALUE_TYPE>(
+      Distribution::LatinHypercube<DISTRIBUTION_TYPE>{distribution, ndim,
+                                                      layout},
+      1234, device, 0);
+  auto pointer_rng = create_rng<VALUE_TYPE>(
+      Distribution::LatinHypercube<DISTRIBUTION_TYPE>{distribution, ndim,
+                                                      layout},
+      1234, device, 0);
+  for (int call = 0; call < 2; call++) {
+    auto correct = get_rng_samples(pointer_rng, N);
+    std::vector<VALUE_TYPE> to_test(N + 1);
+    {
+      sycl::buffer<VALUE_TYPE, 1> buffer(to_test.data(),
+                                         sycl::range<1>(N + 1));
+      ASSERT_EQ(buffer_rng->submit_get_samples(buffer, 1, N), SUCCESS);
+    }
+    for (std::size_t ix = 0; ix < N; ix++) {
+      ASSERT_EQ(to_test.at(ix + 1), correct.at(ix));
+    }
+  }
+}
+
+template <typename VALUE_TYPE, typename DISTRIBUTION_TYPE>
+inline void wrapper_antithetic(const DISTRIBUTION_TYPE distribution,
+                               const double mean) {
+  sycl::device device{sycl::default_selector_v};
+  for (const std::size_t N : {1, 2, 1000, 1001}) {
+    auto rng = create_rng<VALUE_TYPE>(
+        Distribution::Antithetic<DISTRIBUTION_TYPE>{distribution}, 1234,
+        device, 0);
+    ASSERT_NE(rng, nullptr);
+    auto samples = get_rng_samples(rng, N);
+    const std::size_t num_independent = (N + 1) / 2;
+    for (std::size_t ix = 0; ix < N - num_independent; ix++) {
+      ASSERT_NEAR(samples.at(num_independent + ix) + samples.at(ix),
+                  2.0 * mean, 1.0e-5);
+    }
+    // The independent samples are samples of the distribution.
+    double sample_mean = 0.0;
+    for (std::size_t ix = 0; ix < num_independent; ix++) {
+      sample_mean += samples.at(ix) / static_cast<double>(num_independent);
+    }
+    if (N > 2) {
+      ASSERT_NEAR(sample_mean, mean, 0.3);
+    }
+  }
+}
+
+} // namespace
+
+TEST(VarianceReduction, normal_quantile) {
+  for (const double p : {1.0e-300, 1.0e-20, 1.0e-10, 1.0e-3, 0.01, 0.1, 0.3,
+                         0.5, 0.7, 0.9, 0.99, 0.999, 1.0 - 1.0e-10}) {
+    const double z = Private::normal_quantile(p);
+    const double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+    ASSERT_NEAR(cdf / p, 1.0, 1.0e-9);
+    // 1 - p is only exact to the resolution of values near 1.
+    if (p > 1.0e-12) {
+      ASSERT_NEAR(Private::normal_quantile(1.0 - p), -z, 1.0e-5);
+    }
+  }
+  ASSERT_EQ(Private::normal_quantile(0.5), 0.0);
+  ASSERT_NEAR(Private::normal_quantile(0.975f), 1.959964f, 1.0e-5f);
+}
+
+TEST(VarianceReduction, stratified) {
+  wrapper_stratified<double>(Distribution::Uniform<double>{-1.0, 3.0}, 1.0,
+                             1.0e-6);
+  wrapper_stratified<float>(Distribution::Uniform<float>{-1.0f, 3.0f}, 1.0,
+                            1.0e-5);
+  wrapper_stratified<double>(Distribution::Normal<double>{1.0, 2.0}, 1.0,
+                             1.0e-3);
+  wrapper_stratified<float>(Distribution::Normal<float>{1.0f, 2.0f}, 1.0,
+                            1.0e-3);
+}
+
+TEST(VarianceReduction, latin_hypercube) {
+  wrapper_latin_hypercube<double>(Distribution::Uniform<double>{0.0, 1.0},
+                                  Distribution::Layout::AoS);
+  wrapper_latin_hypercube<double>(Distribution::Uniform<double>{2.0, 5.0},
+                                  Distribution::Layout::SoA);
+  wrapper_latin_hypercube<float>(Distribution::Normal<float>{0.0f, 1.0f},
+                                 Distribution::Layout::AoS);
+  wrapper_latin_hypercube<double>(Distribution::Normal<double>{-1.0, 0.5},
+                                  Distribution::Layout::SoA);
+}
+
+TEST(VarianceReduction, antithetic) {
+  wrapper_antithetic<double>(Distribution::Uniform<double>{-1.0, 3.0}, 1.0);
+  wrapper_antithetic<float>(Distribution::Uniform<float>{-1.0f, 3.0f}, 1.0);
+  wrapper_antithetic<double>(Distribution::Normal<double>{1.0, 2.0}, 1.0);
+  wrapper_antithetic<float>(Distribution::Normal<float>{1.0f, 2.0f}, 1.0);
+}
+
+TEST(VarianceReduction, errors) {
+  sycl::device device{sycl::default_selector_v};
+  ASSERT_EQ(create_rng<double>(
+                Distribution::LatinHypercube<Distribution::Uniform<double>>{
+                    {0.0, 1.0}, 0},
+                1234, device, 0),
+            nullptr);
+
+  double ptr[8];
+  auto rng = create_rng<double>(
+      Distribution::LatinHypercube<Distribution::Uniform<double>>{{0.0, 1.0},
+                                                                  3},
+      1234, device, 0);
+  ASSERT_EQ(rng->submit_get_samples(ptr, 4), -4);
+  ASSERT_EQ(rng->wait_get_samples(ptr), -1);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <neso_rng_toolkit.hpp>
+
+using namespace NESO::RNGToolkit;
+
+namespace {
+
+template <typename VALUE_TYPE>
+inline std::vector<VALUE_TYPE>
+get_wiener_samples(EngineSharedPtr<VALUE_TYPE> engine,
+                   const Distribution::Wiener<VALUE_TYPE> distribution,
+                   const std::size_t num_samples) {
+  sycl::queue queue{engine->device};
+  const std::size_t num_values = distribution.num_steps * num_samples;
+  VALUE_TYPE *d_ptr = sycl::malloc_device<VALUE_TYPE>(num_values, queue);
+  EXPECT_EQ(engine->get_samples(distribution, d_ptr, num_samples), SUCCESS);
+  std::vector<VALUE_TYPE> samples(num_values);
+  queue.memcpy(samples.data(), d_ptr, num_values * sizeof(VALUE_TYPE))
+      .wait_and_throw();
+  sycl::free(d_ptr, queue);
+  return samples;
+}
+
+template <typename VALUE_TYPE>
+inline void wrapper_wiener(std::string name, const Distribution::Layout layout,
+                           const double tol) {
+  sycl::device device{sycl::default_selector_v};
+  const std::size_t N = 100001;
+  const std::size_t num_steps = 5;
+  const double dt = 0.25;
+  auto get_index = [&](const std::size_t ix, const std::size_t kx) {
+    return (layout == Distribution::Layout::SoA) ? kx * N + ix
+                                                 : ix * num_steps + kx;
+  };
+
+  // The increments are independent with mean 0 and variance dt.
+  auto engine = create_engine<VALUE_TYPE>(1234, device, 0, name);
+  Distribution::Wiener<VALUE_TYPE> distribution{
+      static_cast<VALUE_TYPE>(dt), num_steps, false, layout};
+  auto increments = get_wiener_samples(engine, distribution, N);
+  for (std::size_t kx = 0; kx < num_steps; kx++) {
+    double mean = 0.0;
+    double variance = 0.0;
+    double covariance = 0.0;
+    for (std::size_t ix = 0; ix < N; ix++) {
+      const double value = increments.at(get_index(ix, kx));
+      mean += value / N;
+      variance += value * value / N;
+      covariance += value * increments.at(get_index(ix, 0)) / N;
+    }
+    ASSERT_NEAR(mean, 0.0, tol);
+    ASSERT_NEAR(variance, dt, tol);
+    if (kx > 0) {
+      ASSERT_NEAR(covariance, 0.0, tol);
+    }
+  }
+
+  // The path of an identically seeded engine is the sum of the increments.
+  auto engine_path = create_engine<VALUE_TYPE>(1234, device, 0, name);
+  distribution.cumulative = true;
+  auto path = get_wiener_samples(engine_path, distribution, N);
+  for (std::size_t ix = 0; ix < N; ix++) {
+    double value = 0.0;
+    for (std::size_t kx = 0; kx < num_steps; kx++) {
+      value += increments.at(get_index(ix, kx));
+      ASSERT_NEAR(path.at(get_index(ix, kx)), value, 1.0e-5);
+    }
+  }
+
+  // The variance of W(k dt) is k dt.
+  for (std::size_t kx = 0; kx < num_steps; kx++) {
+    double variance = 0.0;
+    for (std::size_t ix = 0; ix < N; ix++) {
+      const double value = path.at(get_index(ix, kx));
+      variance += value * value / N;
+    }
+    ASSERT_NEAR(variance, (kx + 1) * dt, (kx + 1) * tol);
+  }
+
+  // Each call advances the stream of the engine.
+  ASSERT_NE(path, get_wiener_samples(engine_path, distribution, N));
+}
+
+} // namespace
+
+TEST(Wiener, default_aos) {
+  wrapper_wiener<double>("default", Distribution::Layout::AoS, 0.01);
+}
+TEST(Wiener, default_soa) {
+  wrapper_wiener<double>("default", Distribution::Layout::SoA, 0.01);
+}
+TEST(Wiener, stdlib) {
+  wrapper_wiener<float>("stdlib", Distribution::Layout::SoA, 0.01);
+}
+
+TEST(Wiener, errors) {
+  sycl::device device{sycl::default_selector_v};
+  auto engine = create_engine<double>(1234, device, 0);
+  double ptr[1];
+  ASSERT_EQ(engine->get_samples(Distribution::Wiener<double>{1.0, 0}, ptr, 1),
+            -101);
+  ASSERT_EQ(engine->get_samples(Distribution::Wiener<double>{-1.0, 1}, ptr, 1),
+            -110);
+}